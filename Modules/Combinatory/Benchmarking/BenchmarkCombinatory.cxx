@@ -0,0 +1,419 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+// Combinatory benchmark: time, allocations and memory peaks per call, printed as JSON.
+//
+// Usage: BenchmarkModuleCombinatory [output.json] [--quick]
+
+#include <combinations.hxx>
+#include <intersection.hxx>
+#include <is_interleaved.hxx>
+#include <permutations.hxx>
+#include <subset_search.hxx>
+
+// STD includes
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+  #include <sys/resource.h>
+#endif
+
+using namespace huc::combinatory;
+
+#ifndef DOXYGEN_SKIP
+namespace {
+  // Allocation accounting: every global allocation is prefixed by its size
+  std::atomic<uint64_t> gAllocationCount(0);
+  std::atomic<int64_t> gLiveBytes(0);
+  std::atomic<int64_t> gPeakBytes(0);
+  const size_t kAllocationHeader = 16; // Keeps the default new alignment
+
+  void* TrackedAllocate(size_t size)
+  {
+    void* block = std::malloc(size + kAllocationHeader);
+    if (!block)
+      throw std::bad_alloc();
+
+    *static_cast<size_t*>(block) = size;
+    ++gAllocationCount;
+    const int64_t kLive = gLiveBytes += static_cast<int64_t>(size);
+    int64_t peak = gPeakBytes.load();
+    while (kLive > peak && !gPeakBytes.compare_exchange_weak(peak, kLive)) {}
+    return static_cast<char*>(block) + kAllocationHeader;
+  }
+
+  void TrackedFree(void* pointer)
+  {
+    if (!pointer)
+      return;
+
+    void* block = static_cast<char*>(pointer) - kAllocationHeader;
+    gLiveBytes -= static_cast<int64_t>(*static_cast<size_t*>(block));
+    std::free(block);
+  }
+}
+#endif /* DOXYGEN_SKIP */
+
+void* operator new(size_t size) { return TrackedAllocate(size); }
+void* operator new[](size_t size) { return TrackedAllocate(size); }
+void operator delete(void* pointer) noexcept { TrackedFree(pointer); }
+void operator delete[](void* pointer) noexcept { TrackedFree(pointer); }
+void operator delete(void* pointer, size_t) noexcept { TrackedFree(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { TrackedFree(pointer); }
+
+#ifndef DOXYGEN_SKIP
+namespace {
+  /// Reset the resident set high water mark of the process, when the system allows it (Linux).
+  void ResetPeakRss()
+  {
+#if defined(__linux__)
+    if (std::FILE* file = std::fopen("/proc/self/clear_refs", "w"))
+    {
+      std::fputs("5", file);
+      std::fclose(file);
+    }
+#endif
+  }
+
+  /// Return the resident set high water mark of the process in KB, -1 if unknown.
+  int64_t PeakRssKb()
+  {
+#if defined(__linux__)
+    if (std::FILE* file = std::fopen("/proc/self/status", "r"))
+    {
+      char line[256];
+      int64_t peak = -1;
+      while (std::fgets(line, sizeof(line), file))
+        if (std::strncmp(line, "VmHWM:", 6) == 0)
+          peak = std::atoll(line + 6);
+      std::fclose(file);
+      return peak;
+    }
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+  #if defined(__APPLE__)
+      return static_cast<int64_t>(usage.ru_maxrss / 1024);
+  #else
+      return static_cast<int64_t>(usage.ru_maxrss);
+  #endif
+#endif
+    return -1;
+  }
+
+  /// Measures of a single call.
+  struct Measure
+  {
+    std::string benchmark;      // Problem measured
+    std::string implementation; // Algorithm measured
+    std::string distribution;   // Input distribution
+    size_t n;                   // Input size
+    double timeMs;              // Best time of the repetitions
+    uint64_t allocations;       // Number of allocations of a call
+    int64_t peakHeapBytes;      // Peak of heap bytes allocated during a call
+    int64_t peakRssKb;          // Resident set high water mark (process wide if it cannot be reset)
+    uint64_t result;            // Size of the result, checks implementations agree
+  };
+
+  /// Run a call repetitions times and keep its best time, and the memory accounting of its first run.
+  Measure Run(const std::string& benchmark, const std::string& implementation, const std::string& distribution,
+              size_t n, int repetitions, const std::function<uint64_t()>& call)
+  {
+    Measure measure = {benchmark, implementation, distribution, n, 0., 0, 0, 0, 0};
+    for (int i = 0; i < repetitions; ++i)
+    {
+      ResetPeakRss();
+      const uint64_t kAllocations = gAllocationCount.load();
+      const int64_t kLiveBytes = gLiveBytes.load();
+      gPeakBytes = kLiveBytes;
+
+      const auto kStart = std::chrono::steady_clock::now();
+      measure.result = call();
+      const double kTimeMs =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - kStart).count();
+
+      if (i == 0)
+      {
+        measure.timeMs = kTimeMs;
+        measure.allocations = gAllocationCount.load() - kAllocations;
+        measure.peakHeapBytes = gPeakBytes.load() - kLiveBytes;
+        measure.peakRssKb = PeakRssKb();
+      }
+      measure.timeMs = std::min(measure.timeMs, kTimeMs);
+    }
+
+    std::cerr << benchmark << " " << implementation << " " << distribution << " n=" << n << ": "
+              << measure.timeMs << "ms" << std::endl;
+    return measure;
+  }
+
+  std::string ToJson(const std::vector<Measure>& measures)
+  {
+    std::ostringstream json;
+    json << "[\n";
+    for (size_t i = 0; i < measures.size(); ++i)
+    {
+      const Measure& kMeasure = measures[i];
+      json << "  {\"benchmark\": \"" << kMeasure.benchmark << "\", \"implementation\": \""
+           << kMeasure.implementation << "\", \"distribution\": \"" << kMeasure.distribution
+           << "\", \"n\": " << kMeasure.n << ", \"time_ms\": " << kMeasure.timeMs
+           << ", \"allocations\": " << kMeasure.allocations << ", \"peak_heap_bytes\": "
+           << kMeasure.peakHeapBytes << ", \"peak_rss_kb\": " << kMeasure.peakRssKb
+           << ", \"result\": " << kMeasure.result << "}" << ((i + 1 < measures.size()) ? ",\n" : "\n");
+    }
+    json << "]\n";
+    return json.str();
+  }
+
+  // Receives the checksums of the enumerated subsets, so that building them cannot be optimized away
+  volatile uint64_t gSink = 0;
+
+  // Builds the subsets of the values along the subset tree, and folds each of them into a checksum at the leaves
+  struct SubsetBuilder : public SubsetVisitorBase
+  {
+    explicit SubsetBuilder(const std::vector<int>& values) : values(values), leaves(0), checksum(0) {}
+
+    SearchAction Include(size_t idx)
+    {
+      this->subset.push_back(this->values[idx]);
+      return SearchAction::Continue;
+    }
+    void UndoInclude(size_t) { this->subset.pop_back(); }
+    void Leaf()
+    {
+      ++this->leaves;
+      for (auto it = this->subset.begin(); it != this->subset.end(); ++it)
+        this->checksum += static_cast<uint64_t>(*it);
+    }
+
+    const std::vector<int>& values;
+    std::vector<int> subset;
+    uint64_t leaves;
+    uint64_t checksum;
+  };
+
+  void BenchmarkPermutations(std::vector<Measure>& measures, size_t maxSize, int repetitions)
+  {
+    for (size_t n = 4; n <= maxSize; ++n)
+    {
+      std::vector<int> values(n);
+      for (size_t i = 0; i < n; ++i)
+        values[i] = static_cast<int>(i);
+
+      measures.push_back(Run("permutations", "huc::Permutations", "iota", n, repetitions, [&values]()
+      { return static_cast<uint64_t>(Permutations<std::vector<int>>(values.begin(), values.end()).size()); }));
+
+      measures.push_back(Run("permutations", "std::next_permutation", "iota", n, repetitions, [&values]()
+      {
+        std::vector<int> permutation(values);
+        uint64_t count = 0;
+        do { ++count; } while (std::next_permutation(permutation.begin(), permutation.end()));
+        return count;
+      }));
+    }
+  }
+
+  void BenchmarkCombinations(std::vector<Measure>& measures, size_t maxSize, int repetitions)
+  {
+    for (size_t n = 8; n <= maxSize; n += 2)
+    {
+      std::vector<int> values(n);
+      for (size_t i = 0; i < n; ++i)
+        values[i] = static_cast<int>(i);
+
+      measures.push_back(Run("combinations", "huc::Combinations", "iota", n, repetitions, [&values]()
+      { return static_cast<uint64_t>(Combinations<std::vector<int>>(values.begin(), values.end()).size()); }));
+
+      // Both build each subset and fold it into a checksum: incrementally along the tree, or from its mask
+      measures.push_back(Run("combinations", "huc::SubsetSearch", "iota", n, repetitions, [&values]()
+      {
+        SubsetBuilder builder(values);
+        SubsetSearch(values.size(), builder);
+        gSink = builder.checksum;
+        return builder.leaves - 1; // Without the empty subset
+      }));
+
+      measures.push_back(Run("combinations", "bitmask", "iota", n, repetitions, [&values]()
+      {
+        std::vector<int> subset;
+        uint64_t count = 0, checksum = 0;
+        for (uint64_t mask = 1; mask < (uint64_t(1) << values.size()); ++mask)
+        {
+          subset.clear();
+          for (size_t i = 0; i < values.size(); ++i)
+            if (mask & (uint64_t(1) << i))
+              subset.push_back(values[i]);
+          for (auto it = subset.begin(); it != subset.end(); ++it)
+            checksum += static_cast<uint64_t>(*it);
+          ++count;
+        }
+        gSink = checksum;
+        return count;
+      }));
+    }
+  }
+
+  void BenchmarkIntersection(std::vector<Measure>& measures, size_t maxSize, int repetitions)
+  {
+    std::mt19937 generator(88);
+    for (size_t n = 1000; n <= maxSize; n *= 10)
+    {
+      // Distributions: same sizes at random, small against large, sorted sets of ids
+      const size_t kSmallSize = std::max<size_t>(1, n / 100);
+      std::uniform_int_distribution<int> values(0, static_cast<int>(2 * n));
+      std::vector<int> uniformA(n), uniformB(n), skewedA(kSmallSize), skewedB(n);
+      for (auto it = uniformA.begin(); it != uniformA.end(); ++it) *it = values(generator);
+      for (auto it = uniformB.begin(); it != uniformB.end(); ++it) *it = values(generator);
+      for (auto it = skewedA.begin(); it != skewedA.end(); ++it) *it = values(generator);
+      skewedB = uniformB;
+
+      std::vector<int> sortedA(uniformA), sortedB(uniformB);
+      std::sort(sortedA.begin(), sortedA.end());
+      std::sort(sortedB.begin(), sortedB.end());
+      sortedA.erase(std::unique(sortedA.begin(), sortedA.end()), sortedA.end());
+      sortedB.erase(std::unique(sortedB.begin(), sortedB.end()), sortedB.end());
+
+      struct Input { const char* name; const std::vector<int>* a; const std::vector<int>* b; };
+      const Input kInputs[] = {{"uniform", &uniformA, &uniformB}, {"skewed", &skewedA, &skewedB},
+                               {"sorted", &sortedA, &sortedB}};
+      for (const Input& kInput : kInputs)
+      {
+        const std::vector<int>& a = *kInput.a;
+        const std::vector<int>& b = *kInput.b;
+
+        measures.push_back(Run("intersection", "huc::Intersection", kInput.name, n, repetitions, [&a, &b]()
+        {
+          return static_cast<uint64_t>(
+            Intersection<std::vector<int>>(a.begin(), a.end(), b.begin(), b.end()).size());
+        }));
+
+        measures.push_back(Run("intersection", "std::set_intersection", kInput.name, n, repetitions, [&a, &b]()
+        {
+          // Sorting is part of the cost on unsorted inputs
+          std::vector<int> sortedA(a), sortedB(b), result;
+          std::sort(sortedA.begin(), sortedA.end());
+          std::sort(sortedB.begin(), sortedB.end());
+          std::set_intersection(sortedA.begin(), sortedA.end(), sortedB.begin(), sortedB.end(),
+                                std::back_inserter(result));
+          return static_cast<uint64_t>(result.size());
+        }));
+
+        measures.push_back(Run("intersection", "std::unordered_multiset", kInput.name, n, repetitions, [&a, &b]()
+        {
+          const std::vector<int>& kSmall = (a.size() <= b.size()) ? a : b;
+          const std::vector<int>& kLarge = (a.size() <= b.size()) ? b : a;
+          std::unordered_multiset<int> count(kSmall.begin(), kSmall.end());
+          uint64_t size = 0;
+          for (auto it = kLarge.begin(); it != kLarge.end(); ++it)
+          {
+            auto found = count.find(*it);
+            if (found != count.end())
+            {
+              count.erase(found);
+              ++size;
+            }
+          }
+          return size;
+        }));
+      }
+    }
+  }
+
+  void BenchmarkIsInterleaved(std::vector<Measure>& measures, size_t maxSize, int repetitions)
+  {
+    std::mt19937 generator(89);
+    for (size_t n = 1000; n <= maxSize; n *= 10)
+    {
+      // Random interleave of two random strings over a small alphabet
+      std::uniform_int_distribution<int> letters('a', 'd');
+      std::string first(n, ' '), second(n, ' '), full;
+      for (auto it = first.begin(); it != first.end(); ++it) *it = static_cast<char>(letters(generator));
+      for (auto it = second.begin(); it != second.end(); ++it) *it = static_cast<char>(letters(generator));
+      size_t i = 0, j = 0;
+      while (i < n || j < n)
+        full.push_back((j == n || (i < n && (generator() & 1))) ? first[i++] : second[j++]);
+
+      measures.push_back(Run("is_interleaved", "huc::IsInterleaved", "letters", n, repetitions, [&]()
+      {
+        return static_cast<uint64_t>(IsInterleaved(first.begin(), first.end(), second.begin(), second.end(),
+                                                    full.begin(), full.end()));
+      }));
+
+      measures.push_back(Run("is_interleaved", "std::sort", "letters", n, repetitions, [&]()
+      {
+        std::string joined(first + second), sortedFull(full);
+        std::sort(joined.begin(), joined.end());
+        std::sort(sortedFull.begin(), sortedFull.end());
+        return static_cast<uint64_t>(joined == sortedFull);
+      }));
+
+      if (n <= 100000)
+        measures.push_back(Run("is_interleaved", "huc::IsOrderedInterleaved", "letters", n, repetitions, [&]()
+        {
+          return static_cast<uint64_t>(IsOrderedInterleaved(first.begin(), first.end(), second.begin(),
+                                                            second.end(), full.begin(), full.end()));
+        }));
+    }
+  }
+}
+#endif /* DOXYGEN_SKIP */
+
+int main(int argc, char* argv[])
+{
+  std::string outputPath;
+  bool quick = false;
+  for (int i = 1; i < argc; ++i)
+    if (std::string(argv[i]) == "--quick")
+      quick = true;
+    else
+      outputPath = argv[i];
+
+  const int kRepetitions = quick ? 1 : 5;
+  std::vector<Measure> measures;
+  BenchmarkPermutations(measures, quick ? 7 : 9, kRepetitions);
+  BenchmarkCombinations(measures, quick ? 12 : 18, kRepetitions);
+  BenchmarkIntersection(measures, quick ? 10000 : 1000000, kRepetitions);
+  BenchmarkIsInterleaved(measures, quick ? 10000 : 1000000, kRepetitions);
+
+  const std::string kJson = ToJson(measures);
+  if (outputPath.empty())
+  {
+    std::cout << kJson;
+    return EXIT_SUCCESS;
+  }
+
+  std::ofstream output(outputPath.c_str());
+  output << kJson;
+  return output.good() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
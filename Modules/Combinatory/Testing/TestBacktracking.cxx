@@ -0,0 +1,105 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#include <gtest/gtest.h>
+#include <backtracking.hxx>
+
+using namespace huc::combinatory;
+
+#ifndef DOXYGEN_SKIP
+namespace {
+  // N-Queens: one queen per row, choices are the free columns
+  struct NQueens
+  {
+    struct State { uint64_t columns, leftDiagonals, rightDiagonals; };
+
+    explicit NQueens(uint32_t n) : n(n), mask((uint64_t(1) << n) - 1) {}
+
+    uint64_t Candidates(const State& state, size_t) const
+    { return ~(state.columns | state.leftDiagonals | state.rightDiagonals) & this->mask; }
+
+    State Apply(const State& state, size_t, uint32_t choice) const
+    {
+      const uint64_t kBit = uint64_t(1) << choice;
+      State child = { state.columns | kBit, ((state.leftDiagonals | kBit) << 1) & this->mask,
+                      (state.rightDiagonals | kBit) >> 1 };
+      return child;
+    }
+
+    bool IsSolution(const State&, size_t depth) const { return depth == this->n; }
+
+    uint32_t n;
+    uint64_t mask;
+  };
+
+  // Permutations of n elements: choices are the unused elements
+  struct PermutationsProblem
+  {
+    typedef uint64_t State;
+
+    explicit PermutationsProblem(uint32_t n) : n(n) {}
+
+    uint64_t Candidates(const State& used, size_t) const { return ~used & ((uint64_t(1) << this->n) - 1); }
+    State Apply(const State& used, size_t, uint32_t choice) const { return used | (uint64_t(1) << choice); }
+    bool IsSolution(const State&, size_t depth) const { return depth == this->n; }
+
+    uint32_t n;
+  };
+}
+#endif /* DOXYGEN_SKIP */
+
+// Test sequential backtracking
+TEST(TestBacktracking, Count)
+{
+  const NQueens::State kEmptyBoard = {0, 0, 0};
+
+  // Known N-Queens solution counts
+  const uint64_t kQueensSolutions[] = {1, 1, 0, 0, 2, 10, 4, 40, 92, 352, 724};
+  for (uint32_t n = 1; n <= 10; ++n)
+    EXPECT_EQ(kQueensSolutions[n], CountSolutions(NQueens(n), kEmptyBoard));
+
+  // n! permutations
+  EXPECT_EQ(5040, CountSolutions(PermutationsProblem(7), 0));
+
+  // Each solution is visited with its state and depth
+  {
+    std::vector<uint64_t> boards;
+    Backtrack(NQueens(4), kEmptyBoard, 0, [&boards](const NQueens::State& state, size_t depth)
+    {
+      EXPECT_EQ(4, depth);
+      boards.push_back(state.columns);
+    });
+    EXPECT_EQ(2, boards.size());
+  }
+}
+
+// Test parallel backtracking
+TEST(TestBacktracking, ParallelCount)
+{
+  const NQueens::State kEmptyBoard = {0, 0, 0};
+
+  for (size_t splitDepth : {0, 1, 3, 6, 20})
+  {
+    EXPECT_EQ(2680, ParallelCountSolutions(NQueens(11), kEmptyBoard, splitDepth, 4));
+    EXPECT_EQ(40320, ParallelCountSolutions(PermutationsProblem(8), 0, splitDepth, 3));
+  }
+
+  // No solution at all
+  EXPECT_EQ(0, ParallelCountSolutions(NQueens(3), kEmptyBoard, 2, 2));
+}
@@ -0,0 +1,129 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#include <gtest/gtest.h>
+#include <cartesian_product.hxx>
+
+// STD includes
+#include <iterator>
+#include <list>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using namespace huc::combinatory;
+
+#ifndef DOXYGEN_SKIP
+namespace {
+  const std::vector<int> kInts = {-3, 0, 7};
+  const std::string kChars = "ab";
+  const std::list<double> kDoubles = {0.5, 1.5, 2.5, 3.5};
+}
+#endif /* DOXYGEN_SKIP */
+
+// Test lazy iteration over the product
+TEST(TestCartesianProduct, Iterate)
+{
+  // One empty collection - empty product expected
+  {
+    const std::vector<int> kEmpty;
+    auto product = CartesianProduct(kInts, kEmpty, kChars);
+    EXPECT_EQ(0, product.Size());
+    EXPECT_TRUE(product.begin() == product.end());
+  }
+
+  // Single collection - the collection itself expected
+  {
+    auto product = CartesianProduct(kInts);
+    std::vector<int> values;
+    for (auto it = product.begin(); it != product.end(); ++it)
+      values.push_back(std::get<0>(*it));
+    EXPECT_EQ(kInts, values);
+  }
+
+  // Normal run - last collection varying the fastest
+  {
+    auto product = CartesianProduct(kInts, kChars, kDoubles);
+    EXPECT_EQ(24, product.Size());
+
+    uint64_t index = 0;
+    for (auto it = product.begin(); it != product.end(); ++it, ++index)
+    {
+      EXPECT_EQ(index, it.Index());
+      EXPECT_EQ(kInts[index / 8], std::get<0>(*it));
+      EXPECT_EQ(kChars[(index / 4) % 2], std::get<1>(*it));
+      EXPECT_EQ(0.5 + static_cast<double>(index % 4), std::get<2>(*it));
+    }
+    EXPECT_EQ(24, index);
+  }
+
+  // Proxy iterators, yielding tuples by value, are input iterators; default constructed ones can be assigned
+  {
+    auto product = CartesianProduct(kInts, kChars, kDoubles);
+    typedef std::iterator_traits<decltype(product.begin())> Traits;
+    static_assert(std::is_same<std::input_iterator_tag, Traits::iterator_category>::value,
+                  "Proxy iterators must not claim the forward iterator category");
+    static_assert(std::is_default_constructible<decltype(product.begin())>::value,
+                  "Iterators must be default constructible");
+    decltype(product.begin()) it;
+    it = product.At(9);
+    EXPECT_EQ(9, it.Index());
+    EXPECT_TRUE(*it == product[9]);
+  }
+
+  // Elements are references to the collections - no copy
+  {
+    auto product = CartesianProduct(kInts, kChars);
+    EXPECT_EQ(&kInts[2], &std::get<0>(product[5]));
+    EXPECT_EQ(&kChars[1], &std::get<1>(product[5]));
+  }
+}
+
+// Test random access by index and sharding
+TEST(TestCartesianProduct, Unrank)
+{
+  auto product = CartesianProduct(kInts, kChars, kDoubles);
+
+  // Unranking should match the iteration
+  {
+    uint64_t index = 0;
+    for (auto it = product.begin(); it != product.end(); ++it, ++index)
+    {
+      EXPECT_TRUE(*it == product[index]);
+      EXPECT_TRUE(*product.At(index) == product[index]);
+    }
+  }
+
+  // Out of range - end expected
+  EXPECT_TRUE(product.At(1000) == product.end());
+
+  // Shards cover the whole product once
+  {
+    const uint64_t kShardCount = 5;
+    uint64_t visited = 0;
+    for (uint64_t shard = 0; shard < kShardCount; ++shard)
+    {
+      auto it = product.At(shard * product.Size() / kShardCount);
+      const auto kEnd = product.At((shard + 1) * product.Size() / kShardCount);
+      for (; it != kEnd; ++it, ++visited)
+        EXPECT_EQ(visited, it.Index());
+    }
+    EXPECT_EQ(product.Size(), visited);
+  }
+}
@@ -0,0 +1,172 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#include <gtest/gtest.h>
+#include <compact_permutation.hxx>
+#include <random.hxx>
+#include <shuffle.hxx>
+
+// STD includes
+#include <numeric>
+
+using namespace huc::combinatory;
+
+#ifndef DOXYGEN_SKIP
+namespace {
+  const uint32_t kSizes[] = {0, 1, 5, 15, 16, 17, 31, 40, 63, 64};
+
+  // Random permutation of size elements
+  CompactPermutation RandomPermutation(uint32_t size, RandomStream& random)
+  {
+    std::vector<uint32_t> images(size);
+    std::iota(images.begin(), images.end(), 0);
+    Shuffle(images.begin(), images.end(), random);
+    return *CompactPermutation::FromImages(images.begin(), images.end());
+  }
+
+  // Parity through the number of inversions
+  uint32_t InversionParity(const CompactPermutation& permutation)
+  {
+    uint32_t inversions = 0;
+    for (uint32_t i = 0; i < permutation.Size(); ++i)
+      for (uint32_t j = i + 1; j < permutation.Size(); ++j)
+        inversions += (permutation[i] > permutation[j]) ? 1 : 0;
+    return inversions & 1;
+  }
+}
+#endif /* DOXYGEN_SKIP */
+
+// Test the construction from images
+TEST(TestCompactPermutation, FromImages)
+{
+  const std::vector<int> kImages = {2, 0, 1, 4, 3};
+  auto permutation = CompactPermutation::FromImages(kImages.begin(), kImages.end());
+  ASSERT_TRUE(permutation != nullptr);
+  EXPECT_EQ(5u, permutation->Size());
+  for (uint32_t i = 0; i < 5; ++i)
+    EXPECT_EQ(kImages[i], (*permutation)[i]);
+
+  // Repeated, out of range or too many images are rejected
+  const std::vector<int> kRepeated = {0, 1, 1};
+  const std::vector<int> kOutOfRange = {0, 3, 1};
+  const std::vector<int> kTooLarge(65, 0);
+  EXPECT_TRUE(CompactPermutation::FromImages(kRepeated.begin(), kRepeated.end()) == nullptr);
+  EXPECT_TRUE(CompactPermutation::FromImages(kOutOfRange.begin(), kOutOfRange.end()) == nullptr);
+  EXPECT_TRUE(CompactPermutation::FromImages(kTooLarge.begin(), kTooLarge.end()) == nullptr);
+  EXPECT_TRUE(CompactPermutation(64).IsIdentity());
+}
+
+// Test composition, inverse and powers against their definitions
+TEST(TestCompactPermutation, Algebra)
+{
+  RandomStream random(91);
+  for (auto size : kSizes)
+    for (int iteration = 0; iteration < 20; ++iteration)
+    {
+      const auto kLhs = RandomPermutation(size, random);
+      const auto kRhs = RandomPermutation(size, random);
+
+      const auto kComposed = kLhs * kRhs;
+      for (uint32_t i = 0; i < size; ++i)
+        EXPECT_EQ(kLhs[kRhs[i]], kComposed[i]);
+
+      EXPECT_TRUE((kLhs * kLhs.Inverse()).IsIdentity());
+      EXPECT_TRUE((kLhs.Inverse() * kLhs).IsIdentity());
+
+      // Powers match repeated compositions, negative ones those of the inverse
+      auto power = CompactPermutation(size);
+      for (int64_t k = 0; k < 8; ++k, power = power * kLhs)
+      {
+        EXPECT_EQ(power, kLhs.Power(k));
+        EXPECT_EQ(power.Inverse(), kLhs.Power(-k));
+      }
+      EXPECT_TRUE(kLhs.Power(static_cast<int64_t>(kLhs.Order())).IsIdentity());
+      EXPECT_EQ(kLhs.Power(3), kLhs.Power(3 + 5 * static_cast<int64_t>(kLhs.Order())));
+    }
+}
+
+// Test the cycle decomposition and the parity
+TEST(TestCompactPermutation, Cycles)
+{
+  const std::vector<int> kImages = {1, 2, 0, 4, 3, 5};
+  const auto kPermutation = *CompactPermutation::FromImages(kImages.begin(), kImages.end());
+  const std::vector<std::vector<uint8_t>> kExpected = {{0, 1, 2}, {3, 4}, {5}};
+  EXPECT_EQ(kExpected, kPermutation.Cycles());
+  EXPECT_EQ(3u, kPermutation.CycleCount());
+  EXPECT_EQ(1u, kPermutation.Parity());
+  EXPECT_EQ(6u, kPermutation.Order());
+
+  RandomStream random(191);
+  for (auto size : kSizes)
+    for (int iteration = 0; iteration < 20; ++iteration)
+    {
+      const auto kRandom = RandomPermutation(size, random);
+      EXPECT_EQ(InversionParity(kRandom), kRandom.Parity());
+
+      // Cycles cover each element once and follow the images
+      uint32_t covered = 0;
+      const auto kCycles = kRandom.Cycles();
+      for (auto it = kCycles.begin(); it != kCycles.end(); ++it)
+      {
+        covered += static_cast<uint32_t>(it->size());
+        for (size_t j = 0; j < it->size(); ++j)
+          EXPECT_EQ((*it)[(j + 1) % it->size()], kRandom[(*it)[j]]);
+      }
+      EXPECT_EQ(size, covered);
+      EXPECT_EQ(kCycles.size(), kRandom.CycleCount());
+    }
+}
+
+// Test the application to batches of arrays
+TEST(TestCompactPermutation, ApplyBatch)
+{
+  RandomStream random(291);
+  const size_t kCount = 37;
+  for (auto size : kSizes)
+  {
+    const auto kPermutation = RandomPermutation(size, random);
+
+    std::vector<uint8_t> bytes(size * kCount);
+    std::vector<uint64_t> words(size * kCount);
+    for (size_t i = 0; i < bytes.size(); ++i)
+    {
+      words[i] = random();
+      bytes[i] = static_cast<uint8_t>(words[i]);
+    }
+
+    std::vector<uint8_t> permutedBytes(bytes.size());
+    std::vector<uint64_t> permutedWords(words.size());
+    kPermutation.ApplyBatch(bytes.data(), permutedBytes.data(), kCount);
+    kPermutation.ApplyBatch(words.data(), permutedWords.data(), kCount);
+    for (size_t array = 0; array < kCount; ++array)
+      for (uint32_t i = 0; i < size; ++i)
+      {
+        EXPECT_EQ(bytes[array * size + kPermutation[i]], permutedBytes[array * size + i]);
+        EXPECT_EQ(words[array * size + kPermutation[i]], permutedWords[array * size + i]);
+      }
+
+    // Applying the inverse restores the arrays
+    if (size > 0)
+    {
+      std::vector<uint8_t> restored(size);
+      kPermutation.Inverse().Apply(permutedBytes.data(), restored.data());
+      EXPECT_TRUE(std::equal(restored.begin(), restored.end(), bytes.begin()));
+    }
+  }
+}
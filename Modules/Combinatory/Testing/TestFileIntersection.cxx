@@ -0,0 +1,167 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#include <gtest/gtest.h>
+#include <file_intersection.hxx>
+
+// STD includes
+#include <random>
+
+using namespace huc::combinatory;
+
+#ifndef DOXYGEN_SKIP
+namespace {
+  const std::string kLhsPath = "TestFileIntersection_lhs.bin";
+  const std::string kRhsPath = "TestFileIntersection_rhs.bin";
+  const std::string kOutputPath = "TestFileIntersection_out.bin";
+
+  void WriteFile(const std::string& path, const std::vector<uint64_t>& values)
+  {
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    ASSERT_TRUE(file != nullptr);
+    if (!values.empty())
+    {
+      EXPECT_EQ(values.size(), std::fwrite(values.data(), sizeof(uint64_t), values.size(), file));
+    }
+    std::fclose(file);
+  }
+
+  std::vector<uint64_t> ReadFile(const std::string& path)
+  {
+    std::vector<uint64_t> values;
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file)
+      return values;
+    uint64_t value;
+    while (std::fread(&value, sizeof(uint64_t), 1, file) == 1)
+      values.push_back(value);
+    std::fclose(file);
+    return values;
+  }
+
+  // Sorted random values with duplicates
+  std::vector<uint64_t> SortedValues(size_t size, uint64_t maxValue, uint32_t seed)
+  {
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<uint64_t> distribution(0, maxValue);
+    std::vector<uint64_t> values(size);
+    for (auto it = values.begin(); it != values.end(); ++it)
+      *it = distribution(generator);
+    std::sort(values.begin(), values.end());
+    return values;
+  }
+
+  void RemoveFiles()
+  {
+    std::remove(kLhsPath.c_str());
+    std::remove(kRhsPath.c_str());
+    std::remove(kOutputPath.c_str());
+  }
+}
+#endif /* DOXYGEN_SKIP */
+
+// Test the reader galloping over its blocks
+TEST(TestFileIntersection, SortedFileReader)
+{
+  std::vector<uint64_t> values;
+  for (uint64_t i = 0; i < 10000; ++i)
+    values.push_back(i / 3 * 2); // Each even value three times
+  WriteFile(kLhsPath, values);
+
+  // 16 records per block
+  auto reader = SortedFileReader<uint64_t>::Open(kLhsPath, 16 * sizeof(uint64_t));
+  ASSERT_TRUE(reader != nullptr);
+  EXPECT_EQ(10000, reader->RecordCount());
+  EXPECT_EQ(625, reader->BlockCount());
+  EXPECT_EQ(0, reader->Value());
+  EXPECT_EQ(1, reader->BlocksRead());
+  EXPECT_EQ(0, reader->HeadsRead()); // Nothing read ahead by the opening
+
+  reader->SkipTo(1001); // Odd: next even value
+  ASSERT_FALSE(reader->AtEnd());
+  EXPECT_EQ(1002, reader->Value());
+
+  reader->SkipTo(3000); // First of the three occurrences, across a block boundary
+  for (int i = 0; i < 3; ++i)
+  {
+    EXPECT_EQ(3000, reader->Value());
+    reader->Next();
+  }
+  EXPECT_EQ(3002, reader->Value());
+  EXPECT_LT(reader->BlocksRead(), 10);
+  EXPECT_LT(reader->HeadsRead(), 40);
+
+  reader->SkipTo(1000000);
+  EXPECT_TRUE(reader->AtEnd());
+  EXPECT_FALSE(reader->Failed());
+
+  // Invalid files
+  EXPECT_TRUE(SortedFileReader<uint64_t>::Open("TestFileIntersection_missing.bin") == nullptr);
+  {
+    std::FILE* file = std::fopen(kRhsPath.c_str(), "wb");
+    std::fputc('x', file);
+    std::fclose(file);
+    EXPECT_TRUE(SortedFileReader<uint64_t>::Open(kRhsPath) == nullptr);
+  }
+
+  RemoveFiles();
+}
+
+// Test intersection and merge of files against the std algorithms
+TEST(TestFileIntersection, Streaming)
+{
+  const std::vector<std::pair<size_t, size_t>> kSizes =
+    {{0, 100}, {1, 1}, {500, 500}, {40, 100000}, {20000, 30000}};
+  for (auto it = kSizes.begin(); it != kSizes.end(); ++it)
+  {
+    const auto kLhs = SortedValues(it->first, 50000, 1);
+    const auto kRhs = SortedValues(it->second, 50000, 2);
+    WriteFile(kLhsPath, kLhs);
+    WriteFile(kRhsPath, kRhs);
+
+    std::vector<uint64_t> expected;
+    std::set_intersection(kLhs.begin(), kLhs.end(), kRhs.begin(), kRhs.end(), std::back_inserter(expected));
+    uint64_t count = 0;
+    EXPECT_TRUE(FileIntersection<uint64_t>(kLhsPath, kRhsPath, kOutputPath, &count, 64 * sizeof(uint64_t)));
+    EXPECT_EQ(expected.size(), count);
+    EXPECT_EQ(expected, ReadFile(kOutputPath));
+    std::remove(kOutputPath.c_str());
+
+    expected.clear();
+    std::merge(kLhs.begin(), kLhs.end(), kRhs.begin(), kRhs.end(), std::back_inserter(expected));
+    EXPECT_TRUE(FileMerge<uint64_t>(kLhsPath, kRhsPath, kOutputPath, &count, 64 * sizeof(uint64_t)));
+    EXPECT_EQ(expected.size(), count);
+    EXPECT_EQ(expected, ReadFile(kOutputPath));
+    std::remove(kOutputPath.c_str());
+  }
+
+  // The output is appended to
+  {
+    WriteFile(kLhsPath, {1, 2, 3});
+    WriteFile(kRhsPath, {2, 3, 4});
+    EXPECT_TRUE(FileIntersection<uint64_t>(kLhsPath, kRhsPath, kOutputPath));
+    EXPECT_TRUE(FileIntersection<uint64_t>(kLhsPath, kRhsPath, kOutputPath));
+    EXPECT_EQ(std::vector<uint64_t>({2, 3, 2, 3}), ReadFile(kOutputPath));
+  }
+
+  // Missing input
+  EXPECT_FALSE(FileIntersection<uint64_t>(kLhsPath, "TestFileIntersection_missing.bin", kOutputPath));
+
+  RemoveFiles();
+}
@@ -22,6 +22,7 @@
 
 // STD includes
 #include <list>
+#include <random>
 
 using namespace huc::combinatory;
 
@@ -121,3 +122,112 @@ TEST(TestIntersection, Intersections)
     EXPECT_EQ('g', intersection[3]);
   }
 }
+
+// Test each strategy of the intersection engine
+TEST(TestIntersection, Strategies)
+{
+  const IntersectionStrategy kStrategies[] = { IntersectionStrategy::Tree, IntersectionStrategy::Hash,
+    IntersectionStrategy::Merge, IntersectionStrategy::Galloping, IntersectionStrategy::Block };
+
+  // Strategy selection given the inputs shape
+  {
+    const Container kSorted(SortedArrayInt, SortedArrayInt + sizeof(SortedArrayInt) / sizeof(Value));
+    const Container kRandom(RandomArrayInt, RandomArrayInt + sizeof(RandomArrayInt) / sizeof(Value));
+    const Container kDuplicates = {1, 1, 2, 3, 3, 3};
+    const Container kSkewed(1000, 3);
+    const Container kOne = {3};
+    EXPECT_EQ(IntersectionStrategy::Hash,
+      ChooseIntersectionStrategy(kRandom.begin(), kRandom.end(), kSorted.begin(), kSorted.end()));
+    EXPECT_EQ(IntersectionStrategy::Block,
+      ChooseIntersectionStrategy(kSorted.begin(), kSorted.end(), kSorted.begin(), kSorted.end()));
+    EXPECT_EQ(IntersectionStrategy::Merge,
+      ChooseIntersectionStrategy(kDuplicates.begin(), kDuplicates.end(), kSorted.begin(), kSorted.end()));
+    EXPECT_EQ(IntersectionStrategy::Galloping,
+      ChooseIntersectionStrategy(kOne.begin(), kOne.end(), kSkewed.begin(), kSkewed.end()));
+
+    const std::list<int> kList(kSorted.begin(), kSorted.end());
+    EXPECT_EQ(IntersectionStrategy::Merge,
+      ChooseIntersectionStrategy(kList.begin(), kList.end(), kList.begin(), kList.end()));
+
+    // Skewed lists - no galloping without random access
+    const std::list<int> kOneList(kOne.begin(), kOne.end());
+    const std::list<int> kSkewedList(kSkewed.begin(), kSkewed.end());
+    EXPECT_EQ(IntersectionStrategy::Merge,
+      ChooseIntersectionStrategy(kOneList.begin(), kOneList.end(), kSkewedList.begin(), kSkewedList.end()));
+    EXPECT_EQ(Container(1, 3), (Intersection<Container, std::list<int>::const_iterator>
+      (kOneList.begin(), kOneList.end(), kSkewedList.begin(), kSkewedList.end())));
+
+    const std::vector<std::pair<int, int>> kPairs = {{2, 1}, {1, 2}};
+    EXPECT_EQ(IntersectionStrategy::Tree,
+      ChooseIntersectionStrategy(kPairs.begin(), kPairs.end(), kPairs.begin(), kPairs.end()));
+  }
+
+  // Sorted sets of ids - every strategy should agree
+  {
+    Container first;
+    Container second;
+    Container expected;
+    for (int i = 0; i < 1000; ++i)
+    {
+      first.push_back(i * 3);
+      second.push_back(i * 5);
+      if (i * 3 % 5 == 0)
+        expected.push_back(i * 3);
+    }
+
+    for (auto strategy : kStrategies)
+    {
+      auto intersection = Intersection<Container, Const_IT>
+        (first.begin(), first.end(), second.begin(), second.end(), strategy);
+      std::sort(intersection.begin(), intersection.end());
+      EXPECT_EQ(expected, intersection);
+    }
+  }
+
+  // Skewed sorted sequences with duplicates - keep dupplicates distinct
+  {
+    Container large;
+    for (int i = 0; i < 5000; ++i)
+      large.push_back(i / 2);
+    const Container kSmall = {-5, 7, 7, 7, 1200, 1200, 4999};
+    const Container kExpected = {7, 7, 1200, 1200};
+
+    for (auto strategy : {IntersectionStrategy::Auto, IntersectionStrategy::Tree, IntersectionStrategy::Hash,
+                          IntersectionStrategy::Merge, IntersectionStrategy::Galloping})
+    {
+      auto intersection = Intersection<Container, Const_IT>
+        (kSmall.begin(), kSmall.end(), large.begin(), large.end(), strategy);
+      EXPECT_EQ(kExpected, intersection);
+    }
+  }
+
+  // Unsorted sequences - Tree and Hash agree, Auto uses Hash
+  {
+    std::mt19937 mt(0);
+    Container first(2000);
+    Container second(3000);
+    for (auto it = first.begin(); it != first.end(); ++it)
+      *it = static_cast<int>(mt() % 500);
+    for (auto it = second.begin(); it != second.end(); ++it)
+      *it = static_cast<int>(mt() % 700);
+
+    const auto kTree = Intersection<Container, Const_IT>
+      (first.begin(), first.end(), second.begin(), second.end(), IntersectionStrategy::Tree);
+    EXPECT_EQ(kTree, (Intersection<Container, Const_IT>
+      (first.begin(), first.end(), second.begin(), second.end(), IntersectionStrategy::Hash)));
+    EXPECT_EQ(kTree, (Intersection<Container, Const_IT>
+      (first.begin(), first.end(), second.begin(), second.end())));
+  }
+}
+
+// Test the galloping lower bound
+TEST(TestIntersection, GallopLowerBound)
+{
+  const Container kSorted(SortedArrayInt, SortedArrayInt + sizeof(SortedArrayInt) / sizeof(Value));
+  for (int value = -5; value < 400; ++value)
+    EXPECT_EQ(std::lower_bound(kSorted.begin(), kSorted.end(), value),
+              GallopLowerBound(kSorted.begin(), kSorted.end(), value));
+
+  const Container kEmpty;
+  EXPECT_EQ(kEmpty.end(), GallopLowerBound(kEmpty.begin(), kEmpty.end(), 0));
+}
@@ -20,6 +20,9 @@
 #include <gtest/gtest.h>
 #include <is_interleaved.hxx>
 
+// STD includes
+#include <random>
+
 using namespace huc::combinatory;
 
 #ifndef DOXYGEN_SKIP
@@ -96,3 +99,169 @@ TEST(TestIsInterleaved, Interleaved)
       bStr.end(), cStr.begin(), cStr.end()));
   }
 }
+
+// Test counting fast paths given the value types
+TEST(TestIsInterleaved, CountingTypes)
+{
+  // Bytes - dense counting
+  {
+    const std::vector<uint8_t> kFirst = {0, 255, 3, 3};
+    const std::vector<uint8_t> kSecond = {255, 7};
+    const std::vector<uint8_t> kFull = {3, 255, 7, 255, 0, 3};
+    const std::vector<uint8_t> kWrong = {3, 255, 7, 255, 0, 4};
+    EXPECT_TRUE(IsInterleaved(kFirst.begin(), kFirst.end(), kSecond.begin(), kSecond.end(),
+                              kFull.begin(), kFull.end()));
+    EXPECT_FALSE(IsInterleaved(kFirst.begin(), kFirst.end(), kSecond.begin(), kSecond.end(),
+                               kWrong.begin(), kWrong.end()));
+  }
+
+  // Short signed 16-bit integers - hash counting
+  {
+    const std::vector<int16_t> kFirst = {-32768, 12, -1};
+    const std::vector<int16_t> kSecond = {32767, -1};
+    const std::vector<int16_t> kFull = {-1, 32767, -32768, -1, 12};
+    EXPECT_TRUE(IsInterleaved(kFirst.begin(), kFirst.end(), kSecond.begin(), kSecond.end(),
+                              kFull.begin(), kFull.end()));
+    EXPECT_FALSE(IsInterleaved(kFirst.begin(), kFirst.end(), kSecond.begin(), kSecond.end(),
+                               kFull.begin(), kFull.end() - 1));
+  }
+
+  // Long signed 16-bit integers - dense counting
+  {
+    std::vector<int16_t> first, second;
+    for (int i = 0; i < 10000; ++i)
+      (i % 3 ? first : second).push_back(static_cast<int16_t>(i * 7919));
+    std::vector<int16_t> full(second.rbegin(), second.rend());
+    full.insert(full.end(), first.begin(), first.end());
+    EXPECT_TRUE(IsInterleaved(first.begin(), first.end(), second.begin(), second.end(),
+                              full.begin(), full.end()));
+    ++full.back();
+    EXPECT_FALSE(IsInterleaved(first.begin(), first.end(), second.begin(), second.end(),
+                               full.begin(), full.end()));
+  }
+
+  // Non hashable type - tree counting
+  {
+    typedef std::pair<int, int> Pair;
+    const std::vector<Pair> kFirst = {Pair(1, 2), Pair(3, 4)};
+    const std::vector<Pair> kSecond = {Pair(1, 2)};
+    const std::vector<Pair> kFull = {Pair(1, 2), Pair(3, 4), Pair(1, 2)};
+    const std::vector<Pair> kWrong = {Pair(1, 2), Pair(3, 4), Pair(2, 1)};
+    EXPECT_TRUE(IsInterleaved(kFirst.begin(), kFirst.end(), kSecond.begin(), kSecond.end(),
+                              kFull.begin(), kFull.end()));
+    EXPECT_FALSE(IsInterleaved(kFirst.begin(), kFirst.end(), kSecond.begin(), kSecond.end(),
+                               kWrong.begin(), kWrong.end()));
+  }
+}
+
+// Test order-preserving interleaves
+TEST(TestIsInterleaved, OrderedInterleaved)
+{
+  // Null interleave on empty sequences - empty interleave expected
+  {
+    Container empty = Container();
+    EXPECT_TRUE(IsOrderedInterleaved<IT>
+      (empty.begin(), empty.end(), empty.begin(), empty.end(), empty.begin(), empty.end()));
+  }
+
+  // Interleave with one empty sequence - same sequence expected as interleave
+  {
+    Container sequenceA(kSequenceAInt, kSequenceAInt + sizeof(kSequenceAInt) / sizeof(Value));
+    EXPECT_TRUE(IsOrderedInterleaved<IT>(sequenceA.end(), sequenceA.end(), sequenceA.begin(),
+      sequenceA.end(), sequenceA.begin(), sequenceA.end()));
+  }
+
+  // Same elements but order not preserved
+  {
+    Container sequenceA(kSequenceAInt, kSequenceAInt + sizeof(kSequenceAInt) / sizeof(Value));
+    Container sequenceB(kSequenceBInt, kSequenceBInt + sizeof(kSequenceBInt) / sizeof(Value));
+    Container sequenceC(kSequenceCInt, kSequenceCInt + sizeof(kSequenceCInt) / sizeof(Value));
+    EXPECT_FALSE(IsOrderedInterleaved<IT>(sequenceA.begin(), sequenceA.end(), sequenceB.begin(),
+      sequenceB.end(), sequenceC.begin(), sequenceC.end()));
+  }
+
+  // Normal run with interleave
+  {
+    Container sequenceA(kSequenceAInt, kSequenceAInt + sizeof(kSequenceAInt) / sizeof(Value));
+    Container sequenceD(kSequenceDInt, kSequenceDInt + sizeof(kSequenceDInt) / sizeof(Value));
+    Container interleave = {4, -2, 3, 3, 5};
+    EXPECT_TRUE(IsOrderedInterleaved<IT>(sequenceA.begin(), sequenceA.end(), sequenceD.begin(),
+      sequenceD.end(), interleave.begin(), interleave.end()));
+  }
+
+  // Strings - bit-parallel version
+  {
+    const std::string kA = "aabcc";
+    const std::string kB = "dbbca";
+    const std::string kValid = "aadbbcbcac";
+    const std::string kInvalid = "aadbbbaccc";
+    EXPECT_TRUE(IsOrderedInterleaved(kA.begin(), kA.end(), kB.begin(), kB.end(), kValid.begin(), kValid.end()));
+    EXPECT_FALSE(IsOrderedInterleaved(kA.begin(), kA.end(), kB.begin(), kB.end(),
+                                      kInvalid.begin(), kInvalid.end()));
+  }
+
+  // Random long byte strings - bit-parallel and rolling versions should agree
+  {
+    std::mt19937 mt(0);
+    for (int run = 0; run < 200; ++run)
+    {
+      std::string a(mt() % 150, ' ');
+      std::string b(mt() % 150, ' ');
+      for (auto it = a.begin(); it != a.end(); ++it)
+        *it = 'a' + static_cast<char>(mt() % 2);
+      for (auto it = b.begin(); it != b.end(); ++it)
+        *it = 'a' + static_cast<char>(mt() % 2);
+
+      // Build a valid interleave, then possibly corrupt it with a swap
+      std::string full;
+      size_t i = 0, j = 0;
+      while (i < a.size() || j < b.size())
+        full += (j == b.size() || (i < a.size() && mt() % 2)) ? a[i++] : b[j++];
+      if (run % 2 && full.size() > 1)
+        std::swap(full[mt() % full.size()], full[mt() % full.size()]);
+
+      const std::vector<int> kA(a.begin(), a.end()), kB(b.begin(), b.end()), kFull(full.begin(), full.end());
+      const bool kExpected = IsOrderedInterleaved(kA.begin(), kA.end(), kB.begin(), kB.end(),
+                                                  kFull.begin(), kFull.end());
+      EXPECT_EQ(kExpected, IsOrderedInterleaved(a.begin(), a.end(), b.begin(), b.end(),
+                                                full.begin(), full.end()));
+      if (run % 2 == 0)
+      {
+        EXPECT_TRUE(kExpected);
+      }
+    }
+  }
+
+  // Strings spanning several blocks of the bit-parallel version - both versions should agree
+  {
+    std::mt19937 mt(1);
+    for (int run = 0; run < 6; ++run)
+    {
+      std::string a(3000 + mt() % 500, ' ');
+      std::string b(100 + 50 * run, ' ');
+      for (auto it = a.begin(); it != a.end(); ++it)
+        *it = static_cast<char>(0xFE + mt() % 2);
+      for (auto it = b.begin(); it != b.end(); ++it)
+        *it = static_cast<char>(0xFE + mt() % 2);
+
+      std::string full;
+      size_t i = 0, j = 0;
+      while (i < a.size() || j < b.size())
+        full += (j == b.size() || (i < a.size() && mt() % 16)) ? a[i++] : b[j++];
+      if (run % 2)
+        std::swap(full[mt() % full.size()], full[mt() % full.size()]);
+
+      const std::vector<int> kA(a.begin(), a.end()), kB(b.begin(), b.end()), kFull(full.begin(), full.end());
+      const bool kExpected = IsOrderedInterleaved(kA.begin(), kA.end(), kB.begin(), kB.end(),
+                                                  kFull.begin(), kFull.end());
+      EXPECT_EQ(kExpected, IsOrderedInterleaved(a.begin(), a.end(), b.begin(), b.end(),
+                                                full.begin(), full.end()));
+      EXPECT_EQ(kExpected, IsOrderedInterleaved(b.begin(), b.end(), a.begin(), a.end(),
+                                                full.begin(), full.end()));
+      if (run % 2 == 0)
+      {
+        EXPECT_TRUE(kExpected);
+      }
+    }
+  }
+}
@@ -0,0 +1,152 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#include <gtest/gtest.h>
+#include <parallel_intersection.hxx>
+
+// STD includes
+#include <atomic>
+#include <random>
+
+using namespace huc::combinatory;
+
+#ifndef DOXYGEN_SKIP
+namespace {
+  // Simple random array of integers with negative values
+  const int RandomArrayInt[] = {4, 3, 5, 2, -18, 3, 2, 3, 4, 5, -5};
+  // Other  random array of integers with negative values
+  const int RandomArrayInterInt[] = {5 , 5, -5, 3, -18, 10, 15};
+
+  typedef std::vector<int> Container;
+  typedef Container::value_type Value;
+  typedef Container::const_iterator Const_IT;
+
+  Container GetRandomContainer(size_t size, uint32_t maxValue, uint32_t seed)
+  {
+    std::mt19937 mt(seed);
+    Container container(size);
+    for (auto it = container.begin(); it != container.end(); ++it)
+      *it = static_cast<int>(mt() % maxValue);
+    return container;
+  }
+
+  // Key counting the comparisons made by the hash tables (probes)
+  std::atomic<uint64_t> gComparisonCount(0);
+  struct CountedKey
+  {
+    uint64_t value;
+    bool operator==(const CountedKey& other) const { ++gComparisonCount; return value == other.value; }
+    bool operator<(const CountedKey& other) const { return value < other.value; }
+  };
+}
+#endif /* DOXYGEN_SKIP */
+
+namespace std
+{
+  template <> struct hash<CountedKey>
+  { size_t operator()(const CountedKey& key) const { return static_cast<size_t>(key.value); } };
+}
+
+// Test hash partitioning
+TEST(TestParallelIntersection, HashPartition)
+{
+  const auto kRandom = GetRandomContainer(10000, 3000, 1);
+
+  for (uint32_t threadCount = 1; threadCount <= 4; ++threadCount)
+  {
+    Container partitioned;
+    std::vector<size_t> offsets;
+    HashPartition(kRandom.begin(), kRandom.end(), 4, threadCount, partitioned, offsets);
+
+    // Each element should be within its partition and no element lost
+    ASSERT_EQ(17, offsets.size());
+    EXPECT_EQ(kRandom.size(), offsets.back());
+    for (size_t partition = 0; partition < 16; ++partition)
+      for (size_t i = offsets[partition]; i < offsets[partition + 1]; ++i)
+        EXPECT_EQ(partition, GetHashPartition(partitioned[i], 4));
+
+    auto sortedInput = kRandom;
+    std::sort(sortedInput.begin(), sortedInput.end());
+    std::sort(partitioned.begin(), partitioned.end());
+    EXPECT_EQ(sortedInput, partitioned);
+  }
+}
+
+// Test parallel intersections
+TEST(TestParallelIntersection, Intersections)
+{
+  // Null intersection on empty vectors - empty intersection expected
+  {
+    const Container kEmptyEl = Container();
+    auto intersection = ParallelIntersection<Container, Const_IT>
+      (kEmptyEl.begin(), kEmptyEl.end(), kEmptyEl.begin(), kEmptyEl.end(), 4);
+    EXPECT_EQ(0, intersection.size());
+  }
+
+  // Small inputs - sequential intersection
+  {
+    const Container kFirstRandom(RandomArrayInt, RandomArrayInt + sizeof(RandomArrayInt) / sizeof(Value));
+    const Container kSecondRandom
+      (RandomArrayInterInt, RandomArrayInterInt + sizeof(RandomArrayInterInt) / sizeof(Value));
+
+    auto intersection = ParallelIntersection<Container, Const_IT>
+      (kFirstRandom.begin(), kFirstRandom.end(), kSecondRandom.begin(), kSecondRandom.end(), 4);
+    std::sort(intersection.begin(), intersection.end());
+    EXPECT_EQ(Container({-18, -5, 3, 5, 5}), intersection);
+  }
+
+  // Big inputs with dupplicates - same result as the sequential intersection for any number of threads
+  {
+    const auto kFirst = GetRandomContainer(300000, 200000, 2);
+    const auto kSecond = GetRandomContainer(200000, 250000, 3);
+
+    auto expected = Intersection<Container, Const_IT>(kFirst.begin(), kFirst.end(),
+                                                      kSecond.begin(), kSecond.end());
+    std::sort(expected.begin(), expected.end());
+
+    for (uint32_t threadCount = 1; threadCount <= 8; threadCount *= 2)
+    {
+      auto intersection = ParallelIntersection<Container, Const_IT>
+        (kFirst.begin(), kFirst.end(), kSecond.begin(), kSecond.end(), threadCount);
+      std::sort(intersection.begin(), intersection.end());
+      EXPECT_EQ(expected, intersection);
+    }
+  }
+}
+
+// Test the partitions keep the probing sequences of their hash tables short
+TEST(TestParallelIntersection, ProbeCount)
+{
+  // The keys of a partition must not share the bits of their home slots (clustering linear probing)
+  std::mt19937_64 mt(78);
+  std::vector<CountedKey> first(1 << 16), second(1 << 16);
+  for (auto it = first.begin(); it != first.end(); ++it)
+    it->value = mt();
+  for (auto it = second.begin(); it != second.end(); ++it)
+    it->value = (mt() % 2) ? mt() : first[mt() % first.size()].value;
+
+  for (uint32_t threadCount = 2; threadCount <= 4; threadCount *= 2)
+  {
+    gComparisonCount = 0;
+    const auto kIntersection = ParallelIntersection<std::vector<CountedKey>>
+      (first.begin(), first.end(), second.begin(), second.end(), threadCount);
+    EXPECT_GT(kIntersection.size(), second.size() / 3);
+    EXPECT_LT(gComparisonCount.load(), 4 * (first.size() + second.size()));
+  }
+}
@@ -0,0 +1,147 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#include <gtest/gtest.h>
+#include <partitions.hxx>
+
+// STD includes
+#include <numeric>
+
+using namespace huc::combinatory;
+
+#ifndef DOXYGEN_SKIP
+namespace {
+  // Whether parts sum to n within the bounds (0 for none)
+  bool IsValid(const std::vector<uint32_t>& parts, uint32_t n, uint32_t maxParts, uint32_t maxPartSize)
+  {
+    if (std::accumulate(parts.begin(), parts.end(), 0u) != n)
+      return false;
+    if (maxParts > 0 && parts.size() > maxParts)
+      return false;
+    for (auto it = parts.begin(); it != parts.end(); ++it)
+      if (*it == 0 || (maxPartSize > 0 && *it > maxPartSize))
+        return false;
+    return true;
+  }
+
+  // Number of unbounded generated sequences within the bounds
+  template <typename Generator>
+  uint64_t CountFiltered(uint32_t n, uint32_t maxParts, uint32_t maxPartSize)
+  {
+    uint64_t count = 0;
+    for (Generator generator(n); generator.IsValid(); generator.Next())
+      count += IsValid(generator.Parts(), n, maxParts, maxPartSize) ? 1 : 0;
+    return count;
+  }
+}
+#endif /* DOXYGEN_SKIP */
+
+// Test the partitions generator
+TEST(TestPartitions, Partitions)
+{
+  // Partitions of 5, in decreasing lexicographic order
+  {
+    const std::vector<std::vector<uint32_t>> kExpected =
+      {{5}, {4, 1}, {3, 2}, {3, 1, 1}, {2, 2, 1}, {2, 1, 1, 1}, {1, 1, 1, 1, 1}};
+    std::vector<std::vector<uint32_t>> partitions;
+    for (PartitionGenerator partition(5); partition.IsValid(); partition.Next())
+      partitions.push_back(partition.Parts());
+    EXPECT_EQ(kExpected, partitions);
+  }
+
+  // Known counts: p(0) = 1, p(10) = 42, p(30) = 5604
+  EXPECT_EQ(1, CountPartitions(0));
+  EXPECT_EQ(42, CountPartitions(10));
+  EXPECT_EQ(5604, CountPartitions(30));
+  EXPECT_EQ(190569292ull, CountPartitions(100));
+
+  // Bounded generators produce exactly the valid partitions, in order
+  for (uint32_t n = 0; n <= 14; ++n)
+    for (uint32_t maxParts = 0; maxParts <= 6; ++maxParts)
+      for (uint32_t maxPartSize = 0; maxPartSize <= 6; ++maxPartSize)
+      {
+        uint64_t count = 0;
+        std::vector<uint32_t> previous;
+        for (PartitionGenerator partition(n, maxParts, maxPartSize); partition.IsValid(); partition.Next())
+        {
+          const auto& kParts = partition.Parts();
+          EXPECT_TRUE(IsValid(kParts, n, maxParts, maxPartSize));
+          EXPECT_TRUE(std::is_sorted(kParts.rbegin(), kParts.rend()));
+          if (count++ > 0)
+          {
+            EXPECT_TRUE(kParts < previous);
+          }
+          previous = kParts;
+        }
+
+        const uint64_t kExpected = CountFiltered<PartitionGenerator>(n, maxParts, maxPartSize);
+        EXPECT_EQ(kExpected, count);
+        EXPECT_EQ(kExpected, CountPartitions(n, maxParts, maxPartSize));
+      }
+}
+
+// Test the compositions generator
+TEST(TestPartitions, Compositions)
+{
+  // Compositions of 4, in decreasing lexicographic order
+  {
+    const std::vector<std::vector<uint32_t>> kExpected = {{4}, {3, 1}, {2, 2}, {2, 1, 1}, {1, 3},
+                                                          {1, 2, 1}, {1, 1, 2}, {1, 1, 1, 1}};
+    std::vector<std::vector<uint32_t>> compositions;
+    for (CompositionGenerator composition(4); composition.IsValid(); composition.Next())
+      compositions.push_back(composition.Parts());
+    EXPECT_EQ(kExpected, compositions);
+  }
+
+  // 2^(n-1) compositions
+  EXPECT_EQ(1, CountCompositions(0));
+  EXPECT_EQ(512, CountCompositions(10));
+  EXPECT_EQ(uint64_t(1) << 40, CountCompositions(41));
+
+  // Bounded generators produce exactly the valid compositions, in order
+  for (uint32_t n = 0; n <= 12; ++n)
+    for (uint32_t maxParts = 0; maxParts <= 5; ++maxParts)
+      for (uint32_t maxPartSize = 0; maxPartSize <= 5; ++maxPartSize)
+      {
+        uint64_t count = 0;
+        std::vector<uint32_t> previous;
+        for (CompositionGenerator composition(n, maxParts, maxPartSize); composition.IsValid(); composition.Next())
+        {
+          const auto& kParts = composition.Parts();
+          EXPECT_TRUE(IsValid(kParts, n, maxParts, maxPartSize));
+          if (count++ > 0)
+          {
+            EXPECT_TRUE(kParts < previous);
+          }
+          previous = kParts;
+        }
+
+        const uint64_t kExpected = CountFiltered<CompositionGenerator>(n, maxParts, maxPartSize);
+        EXPECT_EQ(kExpected, count);
+        EXPECT_EQ(kExpected, CountCompositions(n, maxParts, maxPartSize));
+      }
+
+  // Large enumeration without any list
+  {
+    uint64_t count = 0;
+    for (CompositionGenerator composition(22); composition.IsValid(); composition.Next())
+      ++count;
+    EXPECT_EQ(uint64_t(1) << 21, count);
+  }
+}
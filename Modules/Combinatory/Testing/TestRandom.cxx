@@ -0,0 +1,81 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#include <gtest/gtest.h>
+#include <random.hxx>
+
+// STD includes
+#include <vector>
+
+using namespace huc::combinatory;
+
+// Test reproducibility and random access of the streams
+TEST(TestRandom, Streams)
+{
+  RandomStream first(42, 7), second(42, 7), other(42, 8);
+  std::vector<uint64_t> values;
+  for (int i = 0; i < 100; ++i)
+  {
+    values.push_back(first());
+    EXPECT_EQ(values.back(), second());
+  }
+
+  // Another stream of the same seed differs
+  int equalCount = 0;
+  for (int i = 0; i < 100; ++i)
+    equalCount += (other() == values[i]) ? 1 : 0;
+  EXPECT_EQ(0, equalCount);
+
+  // Counter-based: any value is reachable from its index
+  EXPECT_EQ(values[57], first.At(57));
+  first.Seek(10);
+  EXPECT_EQ(values[10], first());
+}
+
+// Test bounded and floating values
+TEST(TestRandom, Distributions)
+{
+  RandomStream random(3);
+
+  // Each value of a small range is drawn evenly
+  std::vector<int> histogram(6, 0);
+  for (int i = 0; i < 60000; ++i)
+    ++histogram[random.Below(6)];
+  for (auto it = histogram.begin(); it != histogram.end(); ++it)
+  {
+    EXPECT_GT(*it, 9500);
+    EXPECT_LT(*it, 10500);
+  }
+
+  // Bounds above 32 bits
+  const uint64_t kLargeBound = 0x300000000ull;
+  for (int i = 0; i < 1000; ++i)
+    EXPECT_LT(random.Below(kLargeBound), kLargeBound);
+  EXPECT_EQ(0, random.Below(1));
+
+  double sum = 0;
+  for (int i = 0; i < 10000; ++i)
+  {
+    const double kValue = random.Uniform();
+    EXPECT_GE(kValue, 0.);
+    EXPECT_LT(kValue, 1.);
+    sum += kValue;
+  }
+  EXPECT_NEAR(0.5, sum / 10000, 0.02);
+}
@@ -0,0 +1,162 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#include <gtest/gtest.h>
+#include <roaring_bitmap.hxx>
+
+// STD includes
+#include <random>
+#include <set>
+
+using namespace huc::combinatory;
+
+#ifndef DOXYGEN_SKIP
+namespace {
+  typedef RoaringContainer::Type Type;
+
+  // Ids mixing the three container types: sparse chunk, dense chunk and a range
+  std::set<uint32_t> RandomIds(uint32_t seed)
+  {
+    std::mt19937 generator(seed);
+    std::set<uint32_t> ids;
+    for (int i = 0; i < 1000; ++i)
+      ids.insert(generator() % 65536);                       // Sparse chunk 0
+    for (int i = 0; i < 30000; ++i)
+      ids.insert(0x10000 + generator() % 65536);             // Dense chunk 1
+    for (uint32_t id = 0x20000 + seed * 100; id < 0x28000 + seed * 100; ++id)
+      ids.insert(id);                                        // Range in chunk 2
+    ids.insert(0xFFFFFFFF);
+    return ids;
+  }
+
+  RoaringBitmap ToBitmap(const std::set<uint32_t>& ids)
+  {
+    RoaringBitmap bitmap(ids.begin(), ids.end());
+    bitmap.RunOptimize();
+    return bitmap;
+  }
+}
+#endif /* DOXYGEN_SKIP */
+
+// Test the containers and their representations
+TEST(TestRoaringBitmap, Containers)
+{
+  RoaringBitmap bitmap;
+  EXPECT_TRUE(bitmap.IsEmpty());
+  EXPECT_TRUE(bitmap.Add(5));
+  EXPECT_FALSE(bitmap.Add(5));
+  EXPECT_TRUE(bitmap.Add(0x12345678));
+  EXPECT_TRUE(bitmap.Contains(5));
+  EXPECT_TRUE(bitmap.Contains(0x12345678));
+  EXPECT_FALSE(bitmap.Contains(6));
+  EXPECT_EQ(2, bitmap.Cardinality());
+  EXPECT_EQ(2, bitmap.ChunkCount());
+
+  // Arrays become bitmaps beyond 4096 values, and back
+  for (uint32_t id = 0; id < 10000; id += 2)
+    bitmap.Add(id);
+  EXPECT_EQ(Type::Bitmap, bitmap.Chunk(0).GetType());
+  for (uint32_t id = 0; id < 2000; id += 2)
+    EXPECT_TRUE(bitmap.Remove(id));
+  EXPECT_EQ(Type::Array, bitmap.Chunk(0).GetType());
+  EXPECT_EQ(4000 + 2, bitmap.Cardinality());
+
+  // Ranges are stored as runs
+  RoaringBitmap range;
+  range.AddRange(100, 300000);
+  EXPECT_EQ(300000 - 100 + 1, range.Cardinality());
+  EXPECT_EQ(Type::Run, range.Chunk(0).GetType());
+  EXPECT_EQ(Type::Run, range.Chunk(4).GetType());
+  EXPECT_LT(range.SizeInBytes(), 400);
+  EXPECT_TRUE(range.Contains(100));
+  EXPECT_TRUE(range.Contains(300000));
+  EXPECT_FALSE(range.Contains(99));
+  EXPECT_FALSE(range.Contains(300001));
+
+  // Modifying a run
+  EXPECT_TRUE(range.Remove(200));
+  EXPECT_FALSE(range.Contains(200));
+  EXPECT_TRUE(range.Add(200));
+  range.RunOptimize();
+  EXPECT_EQ(Type::Run, range.Chunk(0).GetType());
+
+  // Removing every id of a chunk drops it
+  RoaringBitmap single;
+  single.Add(0x30000);
+  EXPECT_TRUE(single.Remove(0x30000));
+  EXPECT_FALSE(single.Remove(0x30000));
+  EXPECT_TRUE(single.IsEmpty());
+}
+
+// Test iteration and the set operations against std::set
+TEST(TestRoaringBitmap, Operations)
+{
+  const auto kIdsA = RandomIds(1), kIdsB = RandomIds(2);
+  const RoaringBitmap kA = ToBitmap(kIdsA), kB = ToBitmap(kIdsB);
+  const RoaringBitmap kUnoptimizedB(kIdsB.begin(), kIdsB.end());
+
+  EXPECT_EQ(std::vector<uint32_t>(kIdsA.begin(), kIdsA.end()), kA.ToVector());
+  EXPECT_EQ(Type::Array, kA.Chunk(0).GetType());
+  EXPECT_EQ(Type::Bitmap, kA.Chunk(1).GetType());
+  EXPECT_EQ(Type::Run, kA.Chunk(2).GetType());
+  EXPECT_TRUE(kB == kUnoptimizedB);
+
+  std::vector<uint32_t> expected;
+  std::set_intersection(kIdsA.begin(), kIdsA.end(), kIdsB.begin(), kIdsB.end(), std::back_inserter(expected));
+  EXPECT_EQ(expected, RoaringBitmap::And(kA, kB).ToVector());
+  EXPECT_EQ(expected, Intersection(kA, kUnoptimizedB).ToVector());
+  EXPECT_EQ(expected.size(), RoaringBitmap::AndCardinality(kA, kB));
+
+  expected.clear();
+  std::set_union(kIdsA.begin(), kIdsA.end(), kIdsB.begin(), kIdsB.end(), std::back_inserter(expected));
+  EXPECT_EQ(expected, RoaringBitmap::Or(kA, kB).ToVector());
+  EXPECT_EQ(expected.size(), RoaringBitmap::OrCardinality(kA, kUnoptimizedB));
+
+  expected.clear();
+  std::set_difference(kIdsA.begin(), kIdsA.end(), kIdsB.begin(), kIdsB.end(), std::back_inserter(expected));
+  EXPECT_EQ(expected, RoaringBitmap::AndNot(kA, kB).ToVector());
+  EXPECT_EQ(expected.size(), RoaringBitmap::AndNotCardinality(kA, kB));
+
+  expected.clear();
+  std::set_symmetric_difference(kIdsA.begin(), kIdsA.end(), kIdsB.begin(), kIdsB.end(),
+                                std::back_inserter(expected));
+  EXPECT_EQ(expected, RoaringBitmap::Xor(kA, kB).ToVector());
+  EXPECT_EQ(expected.size(), RoaringBitmap::XorCardinality(kA, kB));
+
+  // Operations with the empty set and with itself
+  const RoaringBitmap kEmpty;
+  EXPECT_TRUE(RoaringBitmap::And(kA, kEmpty).IsEmpty());
+  EXPECT_TRUE(RoaringBitmap::Or(kA, kEmpty) == kA);
+  EXPECT_TRUE(RoaringBitmap::AndNot(kA, kA).IsEmpty());
+  EXPECT_TRUE(RoaringBitmap::Xor(kA, kA).IsEmpty());
+  EXPECT_TRUE(kA != kB);
+
+  // Ascending iteration
+  uint64_t count = 0;
+  uint32_t previous = 0;
+  kA.ForEach([&count, &previous](uint32_t id)
+  {
+    if (count++ > 0)
+    {
+      EXPECT_LT(previous, id);
+    }
+    previous = id;
+  });
+  EXPECT_EQ(kIdsA.size(), count);
+}
@@ -0,0 +1,198 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#include <gtest/gtest.h>
+#include <sampling.hxx>
+
+// STD includes
+#include <list>
+#include <map>
+#include <set>
+
+using namespace huc::combinatory;
+
+// Test Floyd's k-subset sampling
+TEST(TestSampling, SampleIndices)
+{
+  RandomStream random(86);
+
+  // Distinct indices within the range
+  {
+    const auto kIndices = SampleIndices(1000000, 1000, random);
+    EXPECT_EQ(1000, kIndices.size());
+    EXPECT_EQ(1000, std::set<uint64_t>(kIndices.begin(), kIndices.end()).size());
+    for (auto it = kIndices.begin(); it != kIndices.end(); ++it)
+      EXPECT_LT(*it, 1000000);
+  }
+
+  // Each of the 10 2-subsets of [0, 5) is expected 2000 times
+  {
+    std::map<std::set<uint64_t>, int> histogram;
+    for (int i = 0; i < 20000; ++i)
+    {
+      const auto kIndices = SampleIndices(5, 2, random);
+      ++histogram[std::set<uint64_t>(kIndices.begin(), kIndices.end())];
+    }
+    EXPECT_EQ(10, histogram.size());
+    for (auto it = histogram.begin(); it != histogram.end(); ++it)
+    {
+      EXPECT_EQ(2, it->first.size());
+      EXPECT_GT(it->second, 1800);
+      EXPECT_LT(it->second, 2200);
+    }
+  }
+
+  // k is clamped to n
+  EXPECT_EQ(3, SampleIndices(3, 10, random).size());
+  EXPECT_TRUE(SampleIndices(0, 10, random).empty());
+}
+
+// Test Algorithm L reservoir sampling
+TEST(TestSampling, Reservoir)
+{
+  // Each element is sampled with probability k / n, through both skipping strategies
+  {
+    const std::vector<int> kVector = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    const std::list<int> kList(kVector.begin(), kVector.end());
+    std::vector<int> vectorHistogram(10, 0), listHistogram(10, 0);
+    for (uint64_t stream = 0; stream < 20000; ++stream)
+    {
+      const auto kFromVector = ReservoirSample(kVector.begin(), kVector.end(), 3, RandomStream(1, stream));
+      const auto kFromList = ReservoirSample(kList.begin(), kList.end(), 3, RandomStream(1, stream));
+      EXPECT_EQ(3, kFromVector.size());
+      EXPECT_EQ(kFromVector, kFromList);
+      for (auto it = kFromVector.begin(); it != kFromVector.end(); ++it)
+        ++vectorHistogram[*it];
+    }
+    for (auto it = vectorHistogram.begin(); it != vectorHistogram.end(); ++it)
+    {
+      EXPECT_GT(*it, 5700);
+      EXPECT_LT(*it, 6300);
+    }
+  }
+
+  // Long stream: the sample spreads over the whole stream
+  {
+    ReservoirSampler<uint32_t> sampler(1000, RandomStream(2));
+    for (uint32_t i = 0; i < 1000000; ++i)
+      sampler.Add(i);
+    EXPECT_EQ(1000000, sampler.Seen());
+
+    const auto kSample = sampler.Sample();
+    EXPECT_EQ(1000, kSample.size());
+    EXPECT_EQ(1000, std::set<uint32_t>(kSample.begin(), kSample.end()).size());
+    double mean = 0;
+    for (auto it = kSample.begin(); it != kSample.end(); ++it)
+      mean += *it;
+    EXPECT_NEAR(500000., mean / 1000, 30000.);
+  }
+
+  // Shorter stream than the sample
+  {
+    ReservoirSampler<int> sampler(5, RandomStream(3));
+    sampler.Add(1);
+    sampler.Add(2);
+    EXPECT_EQ(2, sampler.Sample().size());
+  }
+
+  // Values without ordering: only the keys are compared
+  {
+    struct Record { uint32_t id; };
+    ReservoirSampler<Record> sampler(10, RandomStream(4)), other(10, RandomStream(5));
+    for (uint32_t i = 0; i < 1000; ++i)
+    {
+      const Record kRecord = { i };
+      sampler.Add(kRecord);
+      other.Add(kRecord);
+    }
+    sampler.Merge(other);
+    EXPECT_EQ(10, sampler.Sample().size());
+  }
+}
+
+// Test merging reservoirs of the shards of a stream
+TEST(TestSampling, DistributedReservoir)
+{
+  std::vector<int> histogram(10, 0);
+  for (uint64_t stream = 0; stream < 20000; ++stream)
+  {
+    // Uneven shards: [0, 3) and [3, 10)
+    ReservoirSampler<int> first(3, RandomStream(4, 2 * stream));
+    ReservoirSampler<int> second(3, RandomStream(4, 2 * stream + 1));
+    for (int i = 0; i < 3; ++i)
+      first.Add(i);
+    for (int i = 3; i < 10; ++i)
+      second.Add(i);
+
+    first.Merge(second);
+    EXPECT_EQ(10, first.Seen());
+    const auto kSample = first.Sample();
+    EXPECT_EQ(3, kSample.size());
+    for (auto it = kSample.begin(); it != kSample.end(); ++it)
+      ++histogram[*it];
+  }
+  for (auto it = histogram.begin(); it != histogram.end(); ++it)
+  {
+    EXPECT_GT(*it, 5700);
+    EXPECT_LT(*it, 6300);
+  }
+}
+
+// Test A-ExpJ weighted reservoir sampling
+TEST(TestSampling, WeightedReservoir)
+{
+  // Single element: sampled proportionally to its weight - 10%, 20%, 30%, 40%
+  std::vector<int> histogram(4, 0), mergedHistogram(4, 0);
+  for (uint64_t stream = 0; stream < 20000; ++stream)
+  {
+    WeightedReservoirSampler<int> sampler(1, RandomStream(5, stream));
+    for (int i = 0; i < 4; ++i)
+      sampler.Add(i, i + 1.);
+    sampler.Add(-1, 0.);
+    const auto kSample = sampler.Sample();
+    ASSERT_EQ(1, kSample.size());
+    ++histogram[kSample[0]];
+
+    // Sharded stream
+    WeightedReservoirSampler<int> first(1, RandomStream(6, 2 * stream));
+    WeightedReservoirSampler<int> second(1, RandomStream(6, 2 * stream + 1));
+    first.Add(0, 1.);
+    first.Add(1, 2.);
+    second.Add(2, 3.);
+    second.Add(3, 4.);
+    first.Merge(second);
+    ++mergedHistogram[first.Sample()[0]];
+  }
+  for (int i = 0; i < 4; ++i)
+  {
+    EXPECT_NEAR(2000. * (i + 1), histogram[i], 300.);
+    EXPECT_NEAR(2000. * (i + 1), mergedHistogram[i], 300.);
+  }
+
+  // Heavy elements dominate a long stream
+  {
+    WeightedReservoirSampler<int> sampler(10, RandomStream(7));
+    for (int i = 0; i < 100000; ++i)
+      sampler.Add(i, (i % 1000 == 0) ? 1e9 : 1.);
+    const auto kSample = sampler.Sample();
+    EXPECT_EQ(10, kSample.size());
+    for (auto it = kSample.begin(); it != kSample.end(); ++it)
+      EXPECT_EQ(0, *it % 1000);
+  }
+}
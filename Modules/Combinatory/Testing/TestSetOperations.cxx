@@ -0,0 +1,159 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#include <gtest/gtest.h>
+#include <set_operations.hxx>
+
+// STD includes
+#include <random>
+
+using namespace huc::combinatory;
+
+#ifndef DOXYGEN_SKIP
+namespace {
+  // Sorted posting lists with negative values and dupplicates
+  const int PostingA[] = {-3, 0, 2, 2, 5, 8, 15, 36};
+  const int PostingB[] = {-3, 2, 2, 2, 8, 9, 36, 212};
+  const int PostingC[] = {2, 2, 8, 36, 366};
+
+  typedef std::vector<int> Container;
+  typedef Container::value_type Value;
+  typedef Container::const_iterator Const_IT;
+  typedef std::vector<std::pair<Const_IT, Const_IT>> Ranges;
+
+  Ranges GetRanges(const std::vector<Container>& containers)
+  {
+    Ranges ranges;
+    for (auto it = containers.begin(); it != containers.end(); ++it)
+      ranges.push_back(std::make_pair(it->begin(), it->end()));
+    return ranges;
+  }
+
+  const std::vector<Container> kPostings = {
+    Container(PostingA, PostingA + sizeof(PostingA) / sizeof(Value)),
+    Container(PostingB, PostingB + sizeof(PostingB) / sizeof(Value)),
+    Container(PostingC, PostingC + sizeof(PostingC) / sizeof(Value)) };
+}
+#endif /* DOXYGEN_SKIP */
+
+// Test k-way intersections
+TEST(TestSetOperations, IntersectAll)
+{
+  // No sequence - empty intersection expected
+  {
+    Container intersection;
+    IntersectAll(Ranges(), std::back_inserter(intersection));
+    EXPECT_TRUE(intersection.empty());
+  }
+
+  // One empty sequence - empty intersection expected
+  {
+    const std::vector<Container> kContainers = { kPostings[0], Container(), kPostings[1] };
+    EXPECT_EQ(0, IntersectAllCount(GetRanges(kContainers)));
+  }
+
+  // Single sequence - the sequence itself expected
+  {
+    Container intersection;
+    IntersectAll(GetRanges({kPostings[0]}), std::back_inserter(intersection));
+    EXPECT_EQ(kPostings[0], intersection);
+  }
+
+  // Normal run - dupplicates kept distinct
+  {
+    Container intersection;
+    IntersectAll(GetRanges(kPostings), std::back_inserter(intersection));
+    EXPECT_EQ(Container({2, 2, 8, 36}), intersection);
+    EXPECT_EQ(4, IntersectAllCount(GetRanges(kPostings)));
+  }
+
+  // Many random lists - Same result as chained Intersection
+  {
+    std::mt19937 mt(0);
+    std::vector<Container> lists(12);
+    for (size_t i = 0; i < lists.size(); ++i)
+    {
+      lists[i].resize(500 + 300 * i);
+      for (auto it = lists[i].begin(); it != lists[i].end(); ++it)
+        *it = static_cast<int>(mt() % 2000);
+      std::sort(lists[i].begin(), lists[i].end());
+    }
+
+    Container expected = lists[0];
+    for (size_t i = 1; i < lists.size(); ++i)
+      expected = Intersection<Container, Const_IT>(expected.begin(), expected.end(),
+                                                   lists[i].begin(), lists[i].end());
+    std::sort(expected.begin(), expected.end());
+
+    Container intersection;
+    IntersectAll(GetRanges(lists), std::back_inserter(intersection));
+    EXPECT_EQ(expected, intersection);
+  }
+}
+
+// Test k-way unions
+TEST(TestSetOperations, UnionAll)
+{
+  // No sequence - empty union expected
+  EXPECT_EQ(0, UnionAllCount(Ranges()));
+
+  // Normal run - highest dupplicates count kept
+  {
+    Container unionAll;
+    UnionAll(GetRanges(kPostings), std::back_inserter(unionAll));
+    EXPECT_EQ(Container({-3, 0, 2, 2, 2, 5, 8, 9, 15, 36, 212, 366}), unionAll);
+    EXPECT_EQ(12, UnionAllCount(GetRanges(kPostings)));
+  }
+
+  // Union with empty sequences
+  {
+    const std::vector<Container> kContainers = { Container(), kPostings[2], Container() };
+    Container unionAll;
+    UnionAll(GetRanges(kContainers), std::back_inserter(unionAll));
+    EXPECT_EQ(kPostings[2], unionAll);
+  }
+}
+
+// Test differences
+TEST(TestSetOperations, Difference)
+{
+  // Nothing to exclude - the sequence itself expected
+  {
+    Container difference;
+    Difference(kPostings[0].begin(), kPostings[0].end(), Ranges(), std::back_inserter(difference));
+    EXPECT_EQ(kPostings[0], difference);
+  }
+
+  // Exclude one sequence
+  {
+    Container difference;
+    Difference(kPostings[0].begin(), kPostings[0].end(), GetRanges({kPostings[1]}),
+               std::back_inserter(difference));
+    EXPECT_EQ(Container({0, 5, 15}), difference);
+  }
+
+  // Exclude several sequences - dupplicates are removed given their highest count
+  {
+    const Container kSequence = {2, 2, 2, 2, 9, 10, 366};
+    Container difference;
+    Difference(kSequence.begin(), kSequence.end(), GetRanges(kPostings), std::back_inserter(difference));
+    EXPECT_EQ(Container({2, 10}), difference);
+    EXPECT_EQ(2, DifferenceCount(kSequence.begin(), kSequence.end(), GetRanges(kPostings)));
+  }
+}
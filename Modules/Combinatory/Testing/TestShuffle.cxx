@@ -0,0 +1,146 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#include <gtest/gtest.h>
+#include <shuffle.hxx>
+
+// STD includes
+#include <map>
+#include <numeric>
+#include <string>
+
+using namespace huc::combinatory;
+
+#ifndef DOXYGEN_SKIP
+namespace {
+  // Whether values is a permutation of [0, n)
+  bool IsPermutation(const std::vector<uint32_t>& values)
+  {
+    std::vector<uint8_t> seen(values.size(), 0);
+    for (auto it = values.begin(); it != values.end(); ++it)
+    {
+      if (*it >= values.size() || seen[*it])
+        return false;
+      seen[*it] = 1;
+    }
+    return true;
+  }
+}
+#endif /* DOXYGEN_SKIP */
+
+// Test the uniformity of the sequential and scatter shuffles
+TEST(TestShuffle, Uniformity)
+{
+  // Each of the 24 permutations of 4 elements is expected 1000 times
+  for (size_t bucketCount : {0, 1, 2, 3})
+  {
+    std::map<std::vector<int>, int> histogram;
+    for (uint64_t seed = 0; seed < 24000; ++seed)
+    {
+      std::vector<int> values = {0, 1, 2, 3};
+      if (bucketCount == 0)
+      {
+        RandomStream random(seed);
+        Shuffle(values.begin(), values.end(), random);
+      }
+      else
+        ScatterShuffle(values.begin(), values.end(), seed, bucketCount, 1);
+      ++histogram[values];
+    }
+
+    EXPECT_EQ(24, histogram.size());
+    for (auto it = histogram.begin(); it != histogram.end(); ++it)
+    {
+      EXPECT_GT(it->second, 850);
+      EXPECT_LT(it->second, 1150);
+    }
+  }
+}
+
+// Test the parallel shuffle
+TEST(TestShuffle, Parallel)
+{
+  const size_t kSize = 20 * kShuffleBlockSize + 17;
+
+  // Same permutation whatever the number of threads
+  const auto kReference = RandomPermutation(kSize, 85, 1);
+  EXPECT_TRUE(IsPermutation(kReference));
+  for (uint32_t threadCount : {2, 3, 8})
+    EXPECT_EQ(kReference, RandomPermutation(kSize, 85, threadCount));
+
+  // Another seed gives another permutation, with few fixed points
+  const auto kOther = RandomPermutation(kSize, 86, 4);
+  EXPECT_TRUE(IsPermutation(kOther));
+  EXPECT_NE(kReference, kOther);
+  size_t fixedPoints = 0;
+  for (size_t i = 0; i < kSize; ++i)
+    fixedPoints += (kOther[i] == i) ? 1 : 0;
+  EXPECT_LT(fixedPoints, 10);
+
+  // Elements are spread over the whole sequence
+  double meanPosition = 0;
+  std::vector<uint32_t> positions(kSize);
+  for (size_t i = 0; i < kSize; ++i)
+    positions[kOther[i]] = static_cast<uint32_t>(i);
+  for (size_t i = 0; i < 10000; ++i)
+    meanPosition += positions[i];
+  EXPECT_NEAR(0.5, meanPosition / 10000 / kSize, 0.02);
+
+  // Non trivial values are moved
+  {
+    std::vector<std::string> words(kSize);
+    for (size_t i = 0; i < kSize; ++i)
+      words[i] = std::to_string(kReference[i]);
+    ParallelShuffle(words.begin(), words.end(), 7, 4);
+    std::sort(words.begin(), words.end());
+    EXPECT_TRUE(std::adjacent_find(words.begin(), words.end()) == words.end());
+  }
+
+  // Small sequences
+  EXPECT_TRUE(RandomPermutation(0, 1).empty());
+  EXPECT_EQ(std::vector<uint32_t>(1, 0), RandomPermutation(1, 1));
+  EXPECT_TRUE(IsPermutation(RandomPermutation(1000, 1)));
+}
+
+// Test the scatter shuffle of buckets exceeding the caches, scattered again
+TEST(TestShuffle, LargeBuckets)
+{
+  const size_t kSize = 3 * kShuffleBucketBytes / sizeof(uint32_t) + 5;
+  std::vector<uint32_t> reference(kSize);
+  std::iota(reference.begin(), reference.end(), 0);
+  ScatterShuffle(reference.begin(), reference.end(), 79, 2, 1);
+  EXPECT_TRUE(IsPermutation(reference));
+
+  for (uint32_t threadCount : {2, 4})
+  {
+    std::vector<uint32_t> values(kSize);
+    std::iota(values.begin(), values.end(), 0);
+    ScatterShuffle(values.begin(), values.end(), 79, 2, threadCount);
+    EXPECT_EQ(reference, values);
+  }
+
+  // Both halves of the output mix values from the whole sequence
+  for (size_t half = 0; half < 2; ++half)
+  {
+    double meanValue = 0;
+    for (size_t i = half * kSize / 2; i < (half + 1) * kSize / 2; ++i)
+      meanValue += reference[i];
+    EXPECT_NEAR(0.5, meanValue / (kSize / 2) / kSize, 0.01);
+  }
+}
@@ -0,0 +1,177 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#include <gtest/gtest.h>
+#include <sketches.hxx>
+
+// STD includes
+#include <string>
+
+using namespace huc::combinatory;
+
+// Test HyperLogLog cardinality estimation
+TEST(TestSketches, HyperLogLog)
+{
+  // Empty sketch
+  {
+    HyperLogLog sketch;
+    EXPECT_EQ(0, sketch.Estimate());
+  }
+
+  // Precision is clamped
+  {
+    EXPECT_EQ(HyperLogLog::kMinPrecision, HyperLogLog(0).Precision());
+    EXPECT_EQ(HyperLogLog::kMaxPrecision, HyperLogLog(40).Precision());
+  }
+
+  // Small and large cardinalities with dupplicates - within 3% (standard error of 0.8%)
+  for (int size : {100, 1000, 200000})
+  {
+    HyperLogLog sketch(14);
+    for (int i = 0; i < size; ++i)
+    {
+      sketch.Add(i);
+      sketch.Add(i / 2);
+    }
+    EXPECT_NEAR(size, sketch.Estimate(), 0.03 * size);
+  }
+
+  // Strings
+  {
+    HyperLogLog sketch(12);
+    for (int i = 0; i < 5000; ++i)
+      sketch.Add("key-" + std::to_string(i % 2500));
+    EXPECT_NEAR(2500, sketch.Estimate(), 0.06 * 2500);
+  }
+}
+
+// Test HyperLogLog merge and serialization
+TEST(TestSketches, HyperLogLogMerge)
+{
+  HyperLogLog first(14), second(14);
+  for (int i = 0; i < 60000; ++i)
+    first.Add(i);
+  for (int i = 40000; i < 100000; ++i)
+    second.Add(i);
+
+  // Union and intersection estimates
+  EXPECT_NEAR(100000, HyperLogLog::EstimateUnion(first, second), 3000);
+  EXPECT_NEAR(20000, HyperLogLog::EstimateIntersection(first, second), 5000);
+
+  // Incompatible sketches
+  EXPECT_FALSE(HyperLogLog(12).Merge(first));
+  EXPECT_FALSE(HyperLogLog(14, 7).Merge(first));
+  EXPECT_EQ(-1, HyperLogLog::EstimateUnion(first, HyperLogLog(10)));
+
+  // Merge is the sketch of the union
+  {
+    HyperLogLog all(14);
+    for (int i = 0; i < 100000; ++i)
+      all.Add(i);
+    HyperLogLog merged(first);
+    EXPECT_TRUE(merged.Merge(second));
+    EXPECT_EQ(all.Registers(), merged.Registers());
+  }
+
+  // Serialization round trip
+  {
+    auto sketch = HyperLogLog::Deserialize(first.Serialize());
+    ASSERT_NE(nullptr, sketch);
+    EXPECT_EQ(first.Registers(), sketch->Registers());
+    EXPECT_TRUE(sketch->Merge(second));
+
+    auto bytes = first.Serialize();
+    bytes.pop_back();
+    EXPECT_EQ(nullptr, HyperLogLog::Deserialize(bytes));
+    EXPECT_EQ(nullptr, HyperLogLog::Deserialize(std::vector<uint8_t>()));
+  }
+}
+
+// Test MinHash similarity estimation
+TEST(TestSketches, MinHash)
+{
+  // Empty signatures
+  {
+    MinHash first, second;
+    EXPECT_TRUE(first.IsEmpty());
+    EXPECT_EQ(0, MinHash::EstimateJaccard(first, second));
+  }
+
+  // Same small sets, smaller than the number of bins - densification
+  {
+    MinHash first(256), second(256);
+    for (int i = 0; i < 10; ++i)
+    {
+      first.Add(i);
+      second.Add(9 - i);
+    }
+    EXPECT_EQ(1.0, MinHash::EstimateJaccard(first, second));
+  }
+
+  // Disjoint sets
+  {
+    MinHash first(256), second(256);
+    for (int i = 0; i < 5000; ++i)
+    {
+      first.Add(i);
+      second.Add(i + 5000);
+    }
+    EXPECT_NEAR(0, MinHash::EstimateJaccard(first, second), 0.02);
+  }
+
+  // Overlapping sets: J = 10000 / 30000
+  {
+    MinHash first(1024), second(1024);
+    for (int i = 0; i < 20000; ++i)
+      first.Add(i);
+    for (int i = 10000; i < 30000; ++i)
+      second.Add(i);
+    EXPECT_NEAR(1.0 / 3, MinHash::EstimateJaccard(first, second), 0.05);
+    EXPECT_NEAR(10000, MinHash::EstimateIntersectionSize(first, second, 20000, 20000), 1500);
+
+    // Incompatible signatures
+    EXPECT_EQ(-1, MinHash::EstimateJaccard(first, MinHash(512)));
+    EXPECT_FALSE(first.Merge(MinHash(1024, 3)));
+  }
+}
+
+// Test MinHash merge and serialization
+TEST(TestSketches, MinHashMerge)
+{
+  MinHash first(130), second(130), all(130);
+  for (int i = 0; i < 3000; ++i)
+  {
+    ((i % 3) ? first : second).Add(i * 7);
+    all.Add(i * 7);
+  }
+
+  // Merge is the signature of the union
+  EXPECT_TRUE(first.Merge(second));
+  EXPECT_EQ(all.Bins(), first.Bins());
+
+  // Serialization round trip
+  auto signature = MinHash::Deserialize(first.Serialize());
+  ASSERT_NE(nullptr, signature);
+  EXPECT_EQ(first.Bins(), signature->Bins());
+  EXPECT_EQ(1.0, MinHash::EstimateJaccard(all, *signature));
+
+  auto bytes = first.Serialize();
+  bytes[0] = 'X';
+  EXPECT_EQ(nullptr, MinHash::Deserialize(bytes));
+}
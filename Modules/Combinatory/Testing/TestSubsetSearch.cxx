@@ -0,0 +1,154 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#include <gtest/gtest.h>
+#include <subset_search.hxx>
+
+// STD includes
+#include <random>
+
+using namespace huc::combinatory;
+
+#ifndef DOXYGEN_SKIP
+namespace {
+  // Visitor counting each subset
+  struct CountVisitor : SubsetVisitorBase
+  {
+    CountVisitor() : leaves(0), size(0) {}
+    SearchAction Include(size_t) { ++this->size; return SearchAction::Continue; }
+    void UndoInclude(size_t) { --this->size; }
+    void Leaf() { ++this->leaves; sizes.push_back(this->size); }
+
+    uint64_t leaves;
+    size_t size;
+    std::vector<size_t> sizes;
+  };
+
+  // 0/1 Knapsack visitor: prune overweight branches, bound by the value of the remaining items
+  struct KnapsackVisitor : SubsetVisitorBase
+  {
+    KnapsackVisitor(const std::vector<int>& weights, const std::vector<int>& values, int capacity) :
+      weights(&weights), values(&values), capacity(capacity), weight(0), value(0), best(0), leaves(0),
+      remaining(values.size() + 1, 0)
+    {
+      for (size_t i = values.size(); i-- > 0;)
+        this->remaining[i] = this->remaining[i + 1] + values[i];
+    }
+
+    SearchAction Include(size_t idx)
+    {
+      this->weight += (*this->weights)[idx];
+      this->value += (*this->values)[idx];
+      return (this->weight <= this->capacity) ? SearchAction::Continue : SearchAction::Prune;
+    }
+    void UndoInclude(size_t idx)
+    {
+      this->weight -= (*this->weights)[idx];
+      this->value -= (*this->values)[idx];
+    }
+    bool Bound(size_t depth) { return this->value + this->remaining[depth] > this->best; }
+    void Leaf() { ++this->leaves; this->best = std::max(this->best, this->value); }
+
+    const std::vector<int>* weights;
+    const std::vector<int>* values;
+    int capacity, weight, value, best;
+    uint64_t leaves;
+    std::vector<int> remaining;
+  };
+
+  // Exact knapsack optimum by dynamic programming
+  int KnapsackDP(const std::vector<int>& weights, const std::vector<int>& values, int capacity)
+  {
+    std::vector<int> best(capacity + 1, 0);
+    for (size_t i = 0; i < weights.size(); ++i)
+      for (int c = capacity; c >= weights[i]; --c)
+        best[c] = std::max(best[c], best[c - weights[i]] + values[i]);
+    return best[capacity];
+  }
+}
+#endif /* DOXYGEN_SKIP */
+
+// Test exhaustive enumeration
+TEST(TestSubsetSearch, Enumerate)
+{
+  // No element - only the empty subset
+  {
+    CountVisitor visitor;
+    SubsetSearch(0, visitor);
+    EXPECT_EQ(1, visitor.leaves);
+  }
+
+  // 2^n subsets, each size k appearing C(n, k) times
+  {
+    CountVisitor visitor;
+    SubsetSearch(10, visitor);
+    EXPECT_EQ(1024, visitor.leaves);
+    EXPECT_EQ(10, visitor.sizes.front()); // Include first
+    EXPECT_EQ(0, visitor.sizes.back());
+    EXPECT_EQ(252, std::count(visitor.sizes.begin(), visitor.sizes.end(), 5));
+  }
+
+  // Parallel - Every subset visited once whatever the split
+  for (size_t splitDepth : {0, 3, 10, 15})
+  {
+    auto visitors = ParallelSubsetSearch(10, CountVisitor(), splitDepth, 4);
+    uint64_t leaves = 0;
+    for (auto it = visitors.begin(); it != visitors.end(); ++it)
+    {
+      leaves += it->leaves;
+      EXPECT_EQ(0, it->size); // Visitors are back to their initial state
+    }
+    EXPECT_EQ(1024, leaves);
+  }
+}
+
+// Test branch and bound pruning on knapsack instances
+TEST(TestSubsetSearch, Knapsack)
+{
+  std::mt19937 mt(0);
+  const size_t kSize = 24;
+  std::vector<int> weights(kSize), values(kSize);
+  for (size_t i = 0; i < kSize; ++i)
+  {
+    weights[i] = 1 + static_cast<int>(mt() % 50);
+    values[i] = 1 + static_cast<int>(mt() % 80);
+  }
+  const int kCapacity = 150;
+  const int kExpected = KnapsackDP(weights, values, kCapacity);
+
+  // Sequential search - optimum found exploring a fraction of the subsets
+  {
+    KnapsackVisitor visitor(weights, values, kCapacity);
+    SubsetSearch(kSize, visitor);
+    EXPECT_EQ(kExpected, visitor.best);
+    EXPECT_LT(visitor.leaves, uint64_t(1) << (kSize / 2));
+  }
+
+  // Parallel search - the best of the threads is the optimum
+  {
+    auto visitors = ParallelSubsetSearch(kSize, KnapsackVisitor(weights, values, kCapacity), 6, 4);
+    int best = 0;
+    for (auto it = visitors.begin(); it != visitors.end(); ++it)
+    {
+      best = std::max(best, it->best);
+      EXPECT_EQ(0, it->weight);
+    }
+    EXPECT_EQ(kExpected, best);
+  }
+}
@@ -0,0 +1,112 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#include <gtest/gtest.h>
+#include <subset_sum.hxx>
+
+// STD includes
+#include <cstdlib>
+#include <random>
+
+using namespace huc::combinatory;
+
+#ifndef DOXYGEN_SKIP
+namespace {
+  // Reference: sums of the 2^n subsets, enumerated through their bit masks
+  std::vector<int64_t> BruteForceSums(const std::vector<int64_t>& values)
+  {
+    std::vector<int64_t> sums;
+    for (uint64_t mask = 0; mask < (uint64_t(1) << values.size()); ++mask)
+    {
+      int64_t sum = 0;
+      for (size_t i = 0; i < values.size(); ++i)
+        if (mask & (uint64_t(1) << i))
+          sum += values[i];
+      sums.push_back(sum);
+    }
+    return sums;
+  }
+}
+#endif /* DOXYGEN_SKIP */
+
+// Test Gray code enumeration and sorting of the sums
+TEST(TestSubsetSum, SubsetSums)
+{
+  const std::vector<int64_t> kValues = {5, -3, 12, 7, 7, -20, 1};
+
+  auto sums = SubsetSums(kValues.begin(), kValues.end());
+  auto expected = BruteForceSums(kValues);
+  ASSERT_EQ(expected.size(), sums.size());
+  EXPECT_EQ(0, sums[0]);
+
+  SortSums(sums);
+  std::sort(expected.begin(), expected.end());
+  EXPECT_EQ(expected, sums);
+
+  // Empty collection - only the empty subset
+  const std::vector<int64_t> kEmpty;
+  EXPECT_EQ(std::vector<int64_t>(1, 0), SubsetSums(kEmpty.begin(), kEmpty.end()));
+}
+
+// Test queries against the brute force enumeration
+TEST(TestSubsetSum, Queries)
+{
+  std::mt19937 generator(84);
+  std::uniform_int_distribution<int> distribution(-50, 50);
+  std::vector<int64_t> values(15);
+  for (auto it = values.begin(); it != values.end(); ++it)
+    *it = distribution(generator);
+
+  const MeetInTheMiddle kSolver(values.begin(), values.end());
+  const auto kSums = BruteForceSums(values);
+  for (int64_t target = -400; target <= 400; target += 7)
+  {
+    const uint64_t kCount = static_cast<uint64_t>(std::count(kSums.begin(), kSums.end(), target));
+    EXPECT_EQ(kCount, kSolver.Count(target));
+    EXPECT_EQ(kCount > 0, kSolver.Exists(target));
+
+    int64_t closest = kSums[0];
+    for (auto it = kSums.begin(); it != kSums.end(); ++it)
+      if (std::llabs(*it - target) < std::llabs(closest - target) ||
+          (std::llabs(*it - target) == std::llabs(closest - target) && *it < closest))
+        closest = *it;
+    EXPECT_EQ(closest, kSolver.Closest(target));
+  }
+}
+
+// Test a size out of reach of the exhaustive enumeration
+TEST(TestSubsetSum, LargeInstance)
+{
+  // 40 ones: C(40, 20) subsets sum to 20
+  const std::vector<int> kOnes(40, 1);
+  const MeetInTheMiddle kSolver(kOnes.begin(), kOnes.end());
+  EXPECT_EQ(137846528820ull, kSolver.Count(20));
+  EXPECT_TRUE(kSolver.Exists(40));
+  EXPECT_FALSE(kSolver.Exists(41));
+  EXPECT_EQ(40, kSolver.Closest(1000));
+  EXPECT_EQ(0, kSolver.Closest(-5));
+
+  // Powers of two: each sum is reached by exactly one subset
+  std::vector<int64_t> powers;
+  for (int i = 0; i < 36; ++i)
+    powers.push_back(int64_t(1) << i);
+  const MeetInTheMiddle kPowers(powers.begin(), powers.end());
+  EXPECT_EQ(1, kPowers.Count(0x5A5A5A5A5ll));
+  EXPECT_EQ(0, kPowers.Count(int64_t(1) << 36));
+}
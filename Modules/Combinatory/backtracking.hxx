@@ -0,0 +1,179 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#ifndef MODULE_COMBINATORY_BACKTRACKING_HXX
+#define MODULE_COMBINATORY_BACKTRACKING_HXX
+
+#include <Combinatory/intrinsics.hxx>
+#include <Combinatory/parallel.hxx>
+
+// STD includes
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace huc
+{
+  namespace combinatory
+  {
+    /// BacktrackingFrame - Node of the explicit backtracking stack: its state and the choices left to try.
+    template <typename State>
+    struct BacktrackingFrame
+    {
+      BacktrackingFrame(const State& state, uint64_t candidates) : state(state), candidates(candidates) {}
+
+      State state;         // State of the node
+      uint64_t candidates; // Choices not explored yet, one bit per choice
+    };
+
+    /// Backtrack - Depth first search of the solutions below a node, using an explicit stack.
+    ///
+    /// The Problem type describes the search, its candidate choices being the bits of a 64-bit mask:
+    /// - typedef State: state of a node, copied on the stack (keep it small: a few masks).
+    /// - uint64_t Candidates(const State& state, size_t depth) const: choices available from a node.
+    /// - State Apply(const State& state, size_t depth, uint32_t choice) const: child reached by a choice.
+    /// - bool IsSolution(const State& state, size_t depth) const: whether a node is a solution (leaf).
+    ///
+    /// Choices are extracted lowest bit first with CountTrailingZeros, a node without candidate is a dead end.
+    ///
+    /// @tparam Problem type of the problem.
+    /// @tparam Functor type of the functor called on each solution with its state and depth.
+    ///
+    /// @param problem the problem to be solved.
+    /// @param root state of the node to start from.
+    /// @param rootDepth depth of the node to start from.
+    /// @param onSolution the functor called on each solution.
+    ///
+    /// @return the number of solutions found.
+    template <typename Problem, typename Functor>
+    uint64_t Backtrack(const Problem& problem, const typename Problem::State& root, size_t rootDepth,
+                       Functor onSolution)
+    {
+      typedef typename Problem::State State;
+
+      if (problem.IsSolution(root, rootDepth))
+      {
+        onSolution(root, rootDepth);
+        return 1;
+      }
+
+      uint64_t count = 0;
+      std::vector<BacktrackingFrame<State>> stack;
+      stack.reserve(64);
+      stack.push_back(BacktrackingFrame<State>(root, problem.Candidates(root, rootDepth)));
+      while (!stack.empty())
+      {
+        auto& top = stack.back();
+        if (top.candidates == 0)
+        {
+          stack.pop_back();
+          continue;
+        }
+
+        // Take the lowest choice left
+        const uint32_t kChoice = CountTrailingZeros(top.candidates);
+        top.candidates &= top.candidates - 1;
+
+        const size_t kDepth = rootDepth + stack.size();
+        State child = problem.Apply(top.state, kDepth - 1, kChoice);
+        if (problem.IsSolution(child, kDepth))
+        {
+          onSolution(child, kDepth);
+          ++count;
+          continue;
+        }
+
+        const uint64_t kCandidates = problem.Candidates(child, kDepth);
+        if (kCandidates != 0)
+          stack.push_back(BacktrackingFrame<State>(child, kCandidates));
+      }
+
+      return count;
+    }
+
+    /// CountSolutions - Return the number of solutions of a bitmask backtracking problem (cf. Backtrack).
+    ///
+    /// @return the number of solutions.
+    template <typename Problem>
+    uint64_t CountSolutions(const Problem& problem, const typename Problem::State& root)
+    { return Backtrack(problem, root, 0, [](const typename Problem::State&, size_t) {}); }
+
+    /// ParallelCountSolutions - Return the number of solutions of a bitmask backtracking problem, searched
+    /// on several threads (cf. Backtrack).
+    ///
+    /// The tree is first expanded breadth first down to splitDepth, each node of this frontier becoming an
+    /// independent task. Idle threads pull the next task, each task counts within a local variable published
+    /// once into the counter of its thread: counters are only summed once every task is done, so neither
+    /// atomic operation nor shared write occurs within the search.
+    ///
+    /// @tparam Problem type of the problem, its methods must be safe to call concurrently.
+    ///
+    /// @param problem the problem to be solved.
+    /// @param root state of the root node.
+    /// @param splitDepth depth of the nodes turned into tasks.
+    /// @param threadCount number of threads to be used, every hardware thread by default.
+    ///
+    /// @return the number of solutions.
+    template <typename Problem>
+    uint64_t ParallelCountSolutions(const Problem& problem, const typename Problem::State& root,
+                                    size_t splitDepth = 3, uint32_t threadCount = 0)
+    {
+      typedef typename Problem::State State;
+      threadCount = GetThreadCount(threadCount);
+
+      // Breadth first expansion down to the split depth, counting the solutions above it
+      uint64_t count = 0;
+      std::vector<State> frontier(1, root);
+      size_t depth = 0;
+      if (problem.IsSolution(root, 0))
+        return 1;
+
+      for (; depth < splitDepth && !frontier.empty(); ++depth)
+      {
+        std::vector<State> next;
+        for (auto it = frontier.begin(); it != frontier.end(); ++it)
+          for (uint64_t candidates = problem.Candidates(*it, depth); candidates != 0;
+               candidates &= candidates - 1)
+          {
+            State child = problem.Apply(*it, depth, CountTrailingZeros(candidates));
+            if (problem.IsSolution(child, depth + 1))
+              ++count;
+            else
+              next.push_back(child);
+          }
+        frontier.swap(next);
+      }
+
+      // Each task counts locally and publishes its count once into the counter of its thread
+      std::vector<uint64_t> counters(threadCount, 0);
+      ParallelTasks(frontier.size(), threadCount, [&](size_t task, uint32_t threadIdx)
+      {
+        const uint64_t kTaskCount = Backtrack(problem, frontier[task], depth, [](const State&, size_t) {});
+        counters[threadIdx] += kTaskCount;
+      });
+
+      for (auto it = counters.begin(); it != counters.end(); ++it)
+        count += *it;
+
+      return count;
+    }
+  }
+}
+
+#endif // MODULE_COMBINATORY_BACKTRACKING_HXX
@@ -0,0 +1,205 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#ifndef MODULE_COMBINATORY_CARTESIAN_PRODUCT_HXX
+#define MODULE_COMBINATORY_CARTESIAN_PRODUCT_HXX
+
+// STD includes
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+
+namespace huc
+{
+  namespace combinatory
+  {
+    /// IndexSequence - Compile-time sequence of indices used to expand tuples (std::index_sequence in C++14).
+    template <size_t... Idx> struct IndexSequence {};
+    template <size_t N, size_t... Idx> struct MakeIndexSequence : MakeIndexSequence<N - 1, N - 1, Idx...> {};
+    template <size_t... Idx> struct MakeIndexSequence<0, Idx...> { typedef IndexSequence<Idx...> type; };
+
+    /// CartesianProductView - Lazy view over the cartesian product of several collections.
+    ///
+    /// Tuples are never materialized: the view iterates like a mixed-radix odometer (the last collection
+    /// varying the fastest) and each element is a tuple of references to the elements of the collections.
+    /// Any tuple can also be reached directly by its index (unranking), which allows to split the product
+    /// into independent shards [At(first), At(last)).
+    ///
+    /// @warning the view keeps references to the collections: they must outlive it and not be modified.
+    ///
+    /// @tparam Containers types of the collections.
+    template <typename... Containers>
+    class CartesianProductView
+    {
+      static_assert(sizeof...(Containers) > 0, "CartesianProductView requires at least one collection.");
+
+    public:
+      static const size_t kDimension = sizeof...(Containers);
+      typedef std::tuple<const typename Containers::value_type&...> Reference;
+      typedef std::tuple<typename Containers::const_iterator...> Iterators;
+      typedef typename MakeIndexSequence<sizeof...(Containers)>::type Dimensions;
+
+      /// CartesianProductView constructor.
+      ///
+      /// @param containers the collections of the product.
+      explicit CartesianProductView(const Containers&... containers) : containers(&containers...)
+      { InitSizes(Dimensions()); }
+
+      /// Iterator - Odometer going through the tuples of the product.
+      ///
+      /// Proxy iterator: dereferencing returns the Reference tuple by value, hence the input iterator category
+      /// although the iterator can go through the product several times.
+      class Iterator
+      {
+      public:
+        typedef std::input_iterator_tag iterator_category;
+        typedef Reference value_type;
+        typedef int64_t difference_type;
+        typedef void pointer;
+        typedef Reference reference;
+
+        /// Iterator default constructor - Singular iterator, to be assigned before use.
+        Iterator() : view(nullptr), index(0), digits() {}
+
+        /// Iterator constructor - Unrank the index into the digits of each collection.
+        Iterator(const CartesianProductView* view, uint64_t index) : view(view), index(index), digits()
+        {
+          if (index < view->Size())
+            Unrank(index, Dimensions());
+        }
+
+        Reference operator*() const { return Dereference(Dimensions()); }
+
+        Iterator& operator++()
+        {
+          ++this->index;
+          Increment(std::integral_constant<size_t, kDimension - 1>());
+          return *this;
+        }
+
+        Iterator operator++(int) { Iterator it(*this); ++(*this); return it; }
+
+        bool operator==(const Iterator& it) const { return this->index == it.index; }
+        bool operator!=(const Iterator& it) const { return this->index != it.index; }
+
+        /// Index of the current tuple within the product.
+        uint64_t Index() const { return this->index; }
+        /// Digit of the current tuple for the collection K.
+        uint64_t Digit(size_t k) const { return this->digits[k]; }
+
+      private:
+        const CartesianProductView* view;      // Product being iterated
+        uint64_t index;                        // Rank of the current tuple
+        std::array<uint64_t, kDimension> digits; // Mixed-radix digits: position within each collection
+        Iterators iterators;                   // Iterator within each collection
+
+        template <size_t... Idx>
+        Reference Dereference(IndexSequence<Idx...>) const
+        { return Reference(*std::get<Idx>(this->iterators)...); }
+
+        template <size_t... Idx>
+        void Unrank(uint64_t rank, IndexSequence<Idx...>)
+        {
+          // Digits from the fastest varying collection (last one) to the slowest
+          for (size_t k = kDimension; k-- > 0;)
+          {
+            this->digits[k] = rank % this->view->sizes[k];
+            rank /= this->view->sizes[k];
+          }
+
+          int expand[] = { (std::get<Idx>(this->iterators) = std::next(std::get<Idx>(this->view->containers)->begin(),
+                            static_cast<int64_t>(this->digits[Idx])), 0)... };
+          (void)expand;
+        }
+
+        /// Increment the digit K, resetting it and carrying to the digit K - 1 on overflow.
+        template <size_t K>
+        void Increment(std::integral_constant<size_t, K>)
+        {
+          ++std::get<K>(this->iterators);
+          if (++this->digits[K] < this->view->sizes[K])
+            return;
+
+          this->digits[K] = 0;
+          std::get<K>(this->iterators) = std::get<K>(this->view->containers)->begin();
+          Increment(std::integral_constant<size_t, K - 1>());
+        }
+        void Increment(std::integral_constant<size_t, 0>)
+        {
+          ++std::get<0>(this->iterators);
+          ++this->digits[0];
+        }
+      };
+
+      Iterator begin() const { return Iterator(this, 0); }
+      Iterator end() const { return Iterator(this, this->Size()); }
+
+      /// At - Return an iterator on the tuple of rank index, end() if out of the product.
+      /// O(k) with random access collections, the iterators of the others being advanced step by step.
+      Iterator At(uint64_t index) const { return Iterator(this, std::min(index, this->Size())); }
+
+      /// Unrank - Return the tuple of rank index.
+      ///
+      /// @warning index must be lower than Size().
+      Reference operator[](uint64_t index) const { return *Iterator(this, index); }
+
+      /// Size - Number of tuples within the product, 0 if any collection is empty.
+      ///
+      /// @warning the size is not checked against overflow of a 64-bit integer.
+      uint64_t Size() const { return this->size; }
+
+      /// Radix - Size of the collection k.
+      uint64_t Radix(size_t k) const { return this->sizes[k]; }
+
+    private:
+      std::tuple<const Containers*...> containers; // Collections of the product
+      std::array<uint64_t, kDimension> sizes;      // Size of each collection
+      uint64_t size;                               // Number of tuples
+
+      template <size_t... Idx>
+      void InitSizes(IndexSequence<Idx...>)
+      {
+        this->size = 1;
+        int expand[] = { (this->sizes[Idx] = static_cast<uint64_t>(std::get<Idx>(this->containers)->size()), 0)... };
+        (void)expand;
+        for (size_t k = 0; k < kDimension; ++k)
+          this->size *= this->sizes[k];
+      }
+    };
+
+    /// CartesianProduct - Return a lazy view on all the tuples combining one element of each collection.
+    ///
+    /// @tparam Containers types of the collections.
+    ///
+    /// @param containers the collections of the product, referenced by the view.
+    ///
+    /// @complexity O(1) amortized per tuple, O(k) to reach a tuple by its index within random access
+    /// collections (linear in the digits otherwise).
+    ///
+    /// @return a view over the product: no tuple is built until dereferenced.
+    template <typename... Containers>
+    CartesianProductView<Containers...> CartesianProduct(const Containers&... containers)
+    { return CartesianProductView<Containers...>(containers...); }
+  }
+}
+
+#endif // MODULE_COMBINATORY_CARTESIAN_PRODUCT_HXX
@@ -0,0 +1,303 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#ifndef MODULE_COMBINATORY_COMPACT_PERMUTATION_HXX
+#define MODULE_COMBINATORY_COMPACT_PERMUTATION_HXX
+
+#include <Combinatory/intrinsics.hxx>
+
+// STD includes
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace huc
+{
+  namespace combinatory
+  {
+    /// ShuffleBytes - output[i] = table[indices[i]] for the first size bytes (up to 64).
+    /// With SSSE3 each 16 bytes are looked up by pshufb within each 16 bytes quarter of the table, the
+    /// quarter being selected by the high nibble of the index.
+    ///
+    /// @warning table and indices must be readable over 64 bytes, indices within [0, 64).
+    ///
+    /// @param table the 64 bytes looked up.
+    /// @param indices the indices of the bytes to be looked up.
+    /// @param output the looked up bytes, written over size bytes rounded up to 16.
+    /// @param size the number of bytes to be looked up.
+    ///
+    /// @return void.
+    inline void ShuffleBytes(const uint8_t* table, const uint8_t* indices, uint8_t* output, uint32_t size)
+    {
+#if defined(HUC_USE_SSSE3)
+      const uint32_t kQuarters = (size + 15) / 16;
+      __m128i quarters[4];
+      for (uint32_t k = 0; k < kQuarters; ++k)
+        quarters[k] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(table + 16 * k));
+
+      const __m128i kLowNibble = _mm_set1_epi8(0x0F);
+      for (uint32_t i = 0; i < size; i += 16)
+      {
+        const __m128i kIndices = _mm_loadu_si128(reinterpret_cast<const __m128i*>(indices + i));
+        __m128i result = _mm_shuffle_epi8(quarters[0], kIndices);
+        if (kQuarters > 1)
+        {
+          // Keep the lookup of the quarter designated by the high nibble
+          const __m128i kQuarter = _mm_and_si128(_mm_srli_epi16(kIndices, 4), kLowNibble);
+          result = _mm_and_si128(_mm_cmpeq_epi8(kQuarter, _mm_setzero_si128()), result);
+          for (uint32_t k = 1; k < kQuarters; ++k)
+          {
+            const __m128i kSelected = _mm_cmpeq_epi8(kQuarter, _mm_set1_epi8(static_cast<char>(k)));
+            result = _mm_or_si128(result, _mm_and_si128(kSelected, _mm_shuffle_epi8(quarters[k], kIndices)));
+          }
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), result);
+      }
+#else
+      for (uint32_t i = 0; i < size; ++i)
+        output[i] = table[indices[i]];
+#endif
+    }
+
+    /// @class CompactPermutation
+    ///
+    /// Permutation of up to 64 elements stored as the 64 bytes of its images: image[i] is the position the
+    /// i-th element is taken from (output[i] = input[image[i]]). Bytes beyond the size hold the identity so
+    /// that SIMD lookups can always run over whole 16 bytes blocks.
+    ///
+    /// Composition and application to byte arrays are table lookups (pshufb with SSSE3), the inverse a
+    /// scatter, and powers rotate each cycle instead of composing repeatedly.
+    ///
+    /// @advantages
+    /// - 65 bytes per permutation, no allocation: millions of them fit contiguously in memory.
+    /// - Composition of permutations of up to 16 elements in a single pshufb.
+    ///
+    /// @drawbacks
+    /// - At most 64 elements.
+    class CompactPermutation
+    {
+    public:
+      enum : uint32_t { kMaxSize = 64 };
+
+      /// CompactPermutation constructor - Identity of size elements.
+      ///
+      /// @param size the number of elements, at most kMaxSize.
+      explicit CompactPermutation(uint32_t size = 0)
+        : size(static_cast<uint8_t>(size < kMaxSize ? size : kMaxSize))
+      {
+        for (uint32_t i = 0; i < kMaxSize; ++i)
+          this->images[i] = static_cast<uint8_t>(i);
+      }
+
+      /// FromImages - Build the permutation mapping each index i to the i-th image of [begin, end[.
+      ///
+      /// @tparam IT type using to go through the collection of images.
+      ///
+      /// @param begin,end iterators to the initial and final positions of the images.
+      ///
+      /// @return the permutation, nullptr if the images are not a permutation of [0, n) with n <= 64.
+      template <typename IT>
+      static std::unique_ptr<CompactPermutation> FromImages(const IT& begin, const IT& end)
+      {
+        const auto kSize = std::distance(begin, end);
+        if (kSize < 0 || kSize > static_cast<decltype(kSize)>(kMaxSize))
+          return nullptr;
+
+        std::unique_ptr<CompactPermutation> permutation(new CompactPermutation(static_cast<uint32_t>(kSize)));
+        uint64_t seen = 0;
+        uint32_t i = 0;
+        for (auto it = begin; it != end; ++it, ++i)
+        {
+          const uint64_t kImage = static_cast<uint64_t>(*it);
+          if (kImage >= static_cast<uint64_t>(kSize) || (seen >> kImage) & 1)
+            return nullptr;
+          seen |= uint64_t(1) << kImage;
+          permutation->images[i] = static_cast<uint8_t>(kImage);
+        }
+        return permutation;
+      }
+
+      uint32_t Size() const { return this->size; }
+      uint8_t operator[](uint32_t index) const { return this->images[index]; }
+      const uint8_t* Images() const { return this->images; }
+
+      /// Compose - Return this o other: (this o other)[i] = this[other[i]], applying this then other.
+      ///
+      /// @warning both permutations must have the same size.
+      CompactPermutation Compose(const CompactPermutation& other) const
+      {
+        CompactPermutation result(this->size);
+        ShuffleBytes(this->images, other.images, result.images, this->size);
+        return result;
+      }
+
+      CompactPermutation operator*(const CompactPermutation& other) const { return Compose(other); }
+
+      /// Inverse - Return the permutation p such as p o this and this o p are the identity.
+      CompactPermutation Inverse() const
+      {
+        CompactPermutation result(this->size);
+        for (uint32_t i = 0; i < this->size; ++i)
+          result.images[this->images[i]] = static_cast<uint8_t>(i);
+        return result;
+      }
+
+      /// Power - Return this composed k times with itself (k < 0 for the powers of the inverse).
+      /// Each cycle of length l is rotated by k mod l: O(n) whatever k.
+      CompactPermutation Power(int64_t k) const
+      {
+        CompactPermutation result(this->size);
+        uint64_t visited = 0;
+        uint8_t cycle[kMaxSize];
+        for (uint32_t start = 0; start < this->size; ++start)
+        {
+          if ((visited >> start) & 1)
+            continue;
+
+          uint32_t length = 0;
+          for (uint32_t i = start; !((visited >> i) & 1); i = this->images[i])
+          {
+            visited |= uint64_t(1) << i;
+            cycle[length++] = static_cast<uint8_t>(i);
+          }
+
+          const uint32_t kShift = static_cast<uint32_t>(((k % length) + length) % length);
+          for (uint32_t j = 0; j < length; ++j)
+            result.images[cycle[j]] = cycle[(j + kShift) % length];
+        }
+        return result;
+      }
+
+      /// Cycles - Return the cycles of the permutation, each one starting by its smallest element.
+      std::vector<std::vector<uint8_t>> Cycles() const
+      {
+        std::vector<std::vector<uint8_t>> cycles;
+        uint64_t visited = 0;
+        for (uint32_t start = 0; start < this->size; ++start)
+        {
+          if ((visited >> start) & 1)
+            continue;
+
+          cycles.push_back(std::vector<uint8_t>());
+          for (uint32_t i = start; !((visited >> i) & 1); i = this->images[i])
+          {
+            visited |= uint64_t(1) << i;
+            cycles.back().push_back(static_cast<uint8_t>(i));
+          }
+        }
+        return cycles;
+      }
+
+      /// CycleCount - Return the number of cycles, fixed points included.
+      uint32_t CycleCount() const
+      {
+        uint32_t count = 0;
+        uint64_t visited = 0;
+        for (uint32_t start = 0; start < this->size; ++start)
+          if (!((visited >> start) & 1))
+          {
+            ++count;
+            for (uint32_t i = start; !((visited >> i) & 1); i = this->images[i])
+              visited |= uint64_t(1) << i;
+          }
+        return count;
+      }
+
+      /// Parity - Return 0 for an even permutation, 1 for an odd one: (n - cycles) mod 2.
+      uint32_t Parity() const { return (this->size - CycleCount()) & 1; }
+
+      /// Order - Return the smallest k > 0 such as Power(k) is the identity: lcm of the cycle lengths.
+      uint64_t Order() const
+      {
+        uint64_t order = 1;
+        const auto kCycles = Cycles();
+        for (auto it = kCycles.begin(); it != kCycles.end(); ++it)
+        {
+          uint64_t gcd = order, rest = it->size();
+          while (rest) { const uint64_t kNext = gcd % rest; gcd = rest; rest = kNext; }
+          order = order / gcd * it->size();
+        }
+        return order;
+      }
+
+      bool IsIdentity() const { return *this == CompactPermutation(this->size); }
+
+      bool operator==(const CompactPermutation& other) const
+      { return this->size == other.size && std::memcmp(this->images, other.images, this->size) == 0; }
+      bool operator!=(const CompactPermutation& other) const { return !(*this == other); }
+
+      /// Apply - Permute an array of Size() elements: output[i] = input[image[i]].
+      ///
+      /// @tparam T type of the elements.
+      ///
+      /// @param input the array to be permuted.
+      /// @param output the permuted array, must not overlap input.
+      ///
+      /// @return void.
+      template <typename T>
+      void Apply(const T* input, T* output) const
+      {
+        for (uint32_t i = 0; i < this->size; ++i)
+          output[i] = input[this->images[i]];
+      }
+
+      void Apply(const uint8_t* input, uint8_t* output) const { ApplyBatch(input, output, 1); }
+
+      /// ApplyBatch - Permute count contiguous arrays of Size() elements each (cf. Apply).
+      ///
+      /// @tparam T type of the elements.
+      ///
+      /// @param inputs the arrays to be permuted.
+      /// @param outputs the permuted arrays, must not overlap inputs.
+      /// @param count the number of arrays.
+      ///
+      /// @return void.
+      template <typename T>
+      void ApplyBatch(const T* inputs, T* outputs, size_t count) const
+      {
+        for (size_t array = 0; array < count; ++array, inputs += this->size, outputs += this->size)
+          for (uint32_t i = 0; i < this->size; ++i)
+            outputs[i] = inputs[this->images[i]];
+      }
+
+      /// Byte arrays are permuted by table lookups, through 64 bytes buffers.
+      void ApplyBatch(const uint8_t* inputs, uint8_t* outputs, size_t count) const
+      {
+        if (this->size == 0 || count == 0)
+          return;
+
+        uint8_t table[kMaxSize] = {0}, result[kMaxSize];
+        for (size_t array = 0; array < count; ++array, inputs += this->size, outputs += this->size)
+        {
+          std::memcpy(table, inputs, this->size);
+          ShuffleBytes(table, this->images, result, this->size);
+          std::memcpy(outputs, result, this->size);
+        }
+      }
+
+    private:
+      uint8_t images[kMaxSize]; // Image of each index, identity beyond size
+      uint8_t size;             // Number of elements
+    };
+  }
+}
+
+#endif // MODULE_COMBINATORY_COMPACT_PERMUTATION_HXX
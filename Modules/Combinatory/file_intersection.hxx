@@ -0,0 +1,419 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#ifndef MODULE_COMBINATORY_FILE_INTERSECTION_HXX
+#define MODULE_COMBINATORY_FILE_INTERSECTION_HXX
+
+#include <Combinatory/intersection.hxx>
+
+// STD includes
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if !defined(_WIN32)
+  #include <fcntl.h>
+  #include <sys/types.h>
+#endif
+
+namespace huc
+{
+  namespace combinatory
+  {
+    // Default size in bytes of the blocks read from and written to the files.
+    const size_t kFileBlockSize = 1 << 20;
+
+    /// SeekFile - Move the position of a file to a 64 bits offset from its beginning.
+    ///
+    /// @return true on success, false otherwise.
+    inline bool SeekFile(std::FILE* file, uint64_t offset)
+    {
+#if defined(_WIN32)
+      return _fseeki64(file, static_cast<__int64>(offset), SEEK_SET) == 0;
+#else
+      return fseeko(file, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+    }
+
+    /// FileSize - Return the size in bytes of a file, -1 on failure. The position is moved to the beginning.
+    inline int64_t FileSize(std::FILE* file)
+    {
+#if defined(_WIN32)
+      if (_fseeki64(file, 0, SEEK_END) != 0)
+        return -1;
+      const int64_t kSize = _ftelli64(file);
+#else
+      if (fseeko(file, 0, SEEK_END) != 0)
+        return -1;
+      const int64_t kSize = static_cast<int64_t>(ftello(file));
+#endif
+      return SeekFile(file, 0) ? kSize : -1;
+    }
+
+    /// @class SortedFileReader
+    ///
+    /// Reader of a binary file of sorted fixed size records, loaded one block at a time into a buffer.
+    /// A sparse index holds the first value (head) of the blocks so that SkipTo gallops over the blocks
+    /// before reading any of them: long runs of values absent from the other input are never read.
+    /// The index is filled lazily: heads are recorded as blocks are loaded, and the ones SkipTo probes
+    /// ahead are read on demand (one record each), so opening a file reads its first block only.
+    ///
+    /// Memory is the size of a block plus one value per block, whatever the size of the file. On POSIX
+    /// systems the kernel is told about the sequential access pattern to enlarge its readahead.
+    ///
+    /// @tparam T trivially copyable type of the records, stored in the native byte order.
+    template <typename T>
+    class SortedFileReader
+    {
+    public:
+      /// Open - Open a file of sorted records and load its first block.
+      ///
+      /// @param path the path of the file.
+      /// @param blockSize the size in bytes of the blocks.
+      ///
+      /// @return the reader, nullptr if the file cannot be read or is not made of whole records.
+      static std::unique_ptr<SortedFileReader> Open(const std::string& path, size_t blockSize = kFileBlockSize)
+      {
+        std::FILE* file = std::fopen(path.c_str(), "rb");
+        if (!file)
+          return nullptr;
+
+        std::unique_ptr<SortedFileReader> reader(new SortedFileReader(file, blockSize));
+        const int64_t kSize = FileSize(file);
+        if (kSize < 0 || kSize % static_cast<int64_t>(sizeof(T)) != 0)
+          return nullptr;
+
+        reader->recordCount = static_cast<uint64_t>(kSize) / sizeof(T);
+        reader->blockCount = static_cast<size_t>((reader->recordCount + reader->blockRecords - 1) /
+                                                 reader->blockRecords);
+        if (!reader->LoadBlock(0))
+          return nullptr;
+
+#if !defined(_WIN32) && defined(POSIX_FADV_SEQUENTIAL)
+        posix_fadvise(fileno(file), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+        return reader;
+      }
+
+      ~SortedFileReader() { std::fclose(this->file); }
+
+      /// Whether every record has been consumed, or a read failed.
+      bool AtEnd() const { return this->position >= this->buffer.size(); }
+
+      /// Whether a read failed.
+      bool Failed() const { return this->failed; }
+
+      /// Return the current record.
+      const T& Value() const { return this->buffer[this->position]; }
+
+      /// Next - Move to the next record.
+      void Next()
+      {
+        if (++this->position == this->buffer.size())
+          LoadBlock(this->block + 1);
+      }
+
+      /// SkipTo - Move to the first record not less than target, from the current one.
+      /// Galloping within the current block, then over the heads of the next blocks to the block holding the
+      /// result, reading the heads it probes only.
+      ///
+      /// @param target the value to be reached.
+      ///
+      /// @return void.
+      void SkipTo(const T& target)
+      {
+        while (!AtEnd())
+        {
+          if (!(this->buffer.back() < target))
+          {
+            this->position = static_cast<size_t>(
+              GallopLowerBound(this->buffer.begin() + static_cast<std::ptrdiff_t>(this->position),
+                               this->buffer.end(), target) - this->buffer.begin());
+            return;
+          }
+
+          // First block starting at target or above, within [low, high): gallop then binary search
+          size_t low = this->block + 1, high = low;
+          for (size_t step = 1; high < this->blockCount; high = low + step, step *= 2)
+          {
+            const T* kHead = Head(high);
+            if (!kHead)
+              return;
+            if (!(*kHead < target))
+              break;
+            low = high + 1;
+          }
+          high = std::min(high, this->blockCount);
+          while (low < high)
+          {
+            const size_t kMiddle = low + (high - low) / 2;
+            const T* kHead = Head(kMiddle);
+            if (!kHead)
+              return;
+            if (*kHead < target)
+              low = kMiddle + 1;
+            else
+              high = kMiddle;
+          }
+
+          // Values equal to target may end the block before
+          LoadBlock(std::max(this->block + 1, low - 1));
+        }
+      }
+
+      uint64_t RecordCount() const { return this->recordCount; }
+      size_t BlockCount() const { return this->blockCount; }
+      uint64_t BlocksRead() const { return this->blocksRead; }
+      uint64_t HeadsRead() const { return this->headsRead; }
+
+    private:
+      std::FILE* file;                // File being read
+      size_t blockRecords;            // Number of records per block
+      uint64_t recordCount;           // Number of records within the file
+      size_t blockCount;              // Number of blocks within the file
+      std::vector<T> index;           // First record of each block, allocated by the first probe
+      std::vector<uint8_t> isIndexed; // Whether the first record of each block is known
+      std::vector<T> buffer;          // Records of the current block
+      size_t block;                   // Index of the current block
+      size_t position;                // Position of the current record within the buffer
+      size_t filePosition;            // Block at the current position of the file
+      uint64_t blocksRead;            // Number of blocks loaded
+      uint64_t headsRead;             // Number of first records read on their own
+      bool failed;                    // Whether a read failed
+
+      SortedFileReader(std::FILE* file, size_t blockSize) :
+        file(file), blockRecords(std::max<size_t>(1, blockSize / sizeof(T))), recordCount(0), blockCount(0),
+        block(0), position(0), filePosition(0), blocksRead(0), headsRead(0), failed(false)
+      { this->buffer.reserve(this->blockRecords); }
+
+      SortedFileReader(const SortedFileReader&);
+      SortedFileReader& operator=(const SortedFileReader&);
+
+      /// Return the first record of a block, read if not indexed yet. On failure the reader is at its end.
+      const T* Head(size_t block)
+      {
+        if (this->index.empty())
+        {
+          this->index.resize(this->blockCount);
+          this->isIndexed.assign(this->blockCount, 0);
+          if (!this->buffer.empty())
+          {
+            this->index[this->block] = this->buffer.front();
+            this->isIndexed[this->block] = 1;
+          }
+        }
+
+        if (!this->isIndexed[block])
+        {
+          this->filePosition = this->blockCount; // Position unknown: seek before the next block
+          if (!SeekFile(this->file, static_cast<uint64_t>(block) * this->blockRecords * sizeof(T)) ||
+              std::fread(&this->index[block], sizeof(T), 1, this->file) != 1)
+          {
+            this->buffer.clear();
+            this->failed = true;
+            return nullptr;
+          }
+          this->isIndexed[block] = 1;
+          ++this->headsRead;
+        }
+        return &this->index[block];
+      }
+
+      /// Load a block into the buffer, the reader being at its end past the last block or on failure.
+      bool LoadBlock(size_t block)
+      {
+        this->block = block;
+        this->position = 0;
+        this->buffer.clear();
+        if (block >= this->blockCount)
+          return true;
+
+        const uint64_t kFirst = static_cast<uint64_t>(block) * this->blockRecords;
+        const size_t kRecords = static_cast<size_t>(std::min<uint64_t>(this->blockRecords,
+                                                                       this->recordCount - kFirst));
+        this->buffer.resize(kRecords);
+        if ((block != this->filePosition && !SeekFile(this->file, kFirst * sizeof(T))) ||
+            std::fread(this->buffer.data(), sizeof(T), kRecords, this->file) != kRecords)
+        {
+          this->buffer.clear();
+          this->failed = true;
+          return false;
+        }
+
+        this->filePosition = block + 1;
+        ++this->blocksRead;
+        if (!this->index.empty())
+        {
+          this->index[block] = this->buffer.front();
+          this->isIndexed[block] = 1;
+        }
+        return true;
+      }
+    };
+
+    /// @class AppendFileWriter
+    ///
+    /// Buffered writer appending fixed size records at the end of a binary file.
+    ///
+    /// @tparam T trivially copyable type of the records, stored in the native byte order.
+    template <typename T>
+    class AppendFileWriter
+    {
+    public:
+      /// Open - Open a file for appending, it is created if missing.
+      ///
+      /// @param path the path of the file.
+      /// @param blockSize the size in bytes of the buffer.
+      ///
+      /// @return the writer, nullptr if the file cannot be opened.
+      static std::unique_ptr<AppendFileWriter> Open(const std::string& path, size_t blockSize = kFileBlockSize)
+      {
+        std::FILE* file = std::fopen(path.c_str(), "ab");
+        if (!file)
+          return nullptr;
+        return std::unique_ptr<AppendFileWriter>(new AppendFileWriter(file, blockSize));
+      }
+
+      ~AppendFileWriter()
+      {
+        Flush();
+        std::fclose(this->file);
+      }
+
+      /// Write - Append a record.
+      void Write(const T& value)
+      {
+        this->buffer.push_back(value);
+        if (this->buffer.size() == this->buffer.capacity())
+          Flush();
+      }
+
+      /// Flush - Write the buffered records to the file.
+      ///
+      /// @return false if a write failed since the opening of the file, true otherwise.
+      bool Flush()
+      {
+        if (!this->buffer.empty())
+        {
+          this->failed |= std::fwrite(this->buffer.data(), sizeof(T), this->buffer.size(), this->file) !=
+                          this->buffer.size();
+          this->written += this->buffer.size();
+          this->buffer.clear();
+        }
+
+        this->failed |= std::fflush(this->file) != 0;
+        return !this->failed;
+      }
+
+      /// Return the number of records written.
+      uint64_t Written() const { return this->written + this->buffer.size(); }
+
+    private:
+      std::FILE* file;       // File being written
+      std::vector<T> buffer; // Records waiting to be written
+      uint64_t written;      // Number of records written to the file
+      bool failed;           // Whether a write failed
+
+      AppendFileWriter(std::FILE* file, size_t blockSize) : file(file), written(0), failed(false)
+      { this->buffer.reserve(std::max<size_t>(1, blockSize / sizeof(T))); }
+
+      AppendFileWriter(const AppendFileWriter&);
+      AppendFileWriter& operator=(const AppendFileWriter&);
+    };
+
+    /// FileIntersection - Intersection of two binary files of sorted records, appended to a third file.
+    /// Same multiset semantic as std::set_intersection, in constant memory: each input is read block by
+    /// block and the one behind gallops to the value of the other (cf. SortedFileReader::SkipTo).
+    ///
+    /// @tparam T trivially copyable type of the records, stored in the native byte order.
+    ///
+    /// @param lhsPath,rhsPath the paths of the sorted input files.
+    /// @param outputPath the path of the file the intersection is appended to.
+    /// @param count if not null, receives the number of records written.
+    /// @param blockSize the size in bytes of the blocks.
+    ///
+    /// @return true on success, false if a file cannot be opened, read or written.
+    template <typename T>
+    bool FileIntersection(const std::string& lhsPath, const std::string& rhsPath, const std::string& outputPath,
+                          uint64_t* count = nullptr, size_t blockSize = kFileBlockSize)
+    {
+      auto lhs = SortedFileReader<T>::Open(lhsPath, blockSize);
+      auto rhs = SortedFileReader<T>::Open(rhsPath, blockSize);
+      auto output = (lhs && rhs) ? AppendFileWriter<T>::Open(outputPath, blockSize) : nullptr;
+      if (!output)
+        return false;
+
+      while (!lhs->AtEnd() && !rhs->AtEnd())
+      {
+        if (lhs->Value() < rhs->Value())
+          lhs->SkipTo(rhs->Value());
+        else if (rhs->Value() < lhs->Value())
+          rhs->SkipTo(lhs->Value());
+        else
+        {
+          output->Write(lhs->Value());
+          lhs->Next();
+          rhs->Next();
+        }
+      }
+
+      if (count)
+        *count = output->Written();
+      return output->Flush() && !lhs->Failed() && !rhs->Failed();
+    }
+
+    /// FileMerge - Merge of two binary files of sorted records, appended to a third file.
+    /// Same semantic as std::merge, in constant memory.
+    ///
+    /// @tparam T trivially copyable type of the records, stored in the native byte order.
+    ///
+    /// @param lhsPath,rhsPath the paths of the sorted input files.
+    /// @param outputPath the path of the file the merge is appended to.
+    /// @param count if not null, receives the number of records written.
+    /// @param blockSize the size in bytes of the blocks.
+    ///
+    /// @return true on success, false if a file cannot be opened, read or written.
+    template <typename T>
+    bool FileMerge(const std::string& lhsPath, const std::string& rhsPath, const std::string& outputPath,
+                   uint64_t* count = nullptr, size_t blockSize = kFileBlockSize)
+    {
+      auto lhs = SortedFileReader<T>::Open(lhsPath, blockSize);
+      auto rhs = SortedFileReader<T>::Open(rhsPath, blockSize);
+      auto output = (lhs && rhs) ? AppendFileWriter<T>::Open(outputPath, blockSize) : nullptr;
+      if (!output)
+        return false;
+
+      while (!lhs->AtEnd() || !rhs->AtEnd())
+      {
+        auto& next = (rhs->AtEnd() || (!lhs->AtEnd() && !(rhs->Value() < lhs->Value()))) ? lhs : rhs;
+        output->Write(next->Value());
+        next->Next();
+      }
+
+      if (count)
+        *count = output->Written();
+      return output->Flush() && !lhs->Failed() && !rhs->Failed();
+    }
+  }
+}
+
+#endif // MODULE_COMBINATORY_FILE_INTERSECTION_HXX
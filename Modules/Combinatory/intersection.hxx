@@ -20,54 +20,380 @@
 #ifndef MODULE_COMBINATORY_INTERSECTION_HXX
 #define MODULE_COMBINATORY_INTERSECTION_HXX
 
+#include <Combinatory/intrinsics.hxx>
+#include <DataStructures/flat_hash_counter.hxx>
+
 // STD includes
+#include <algorithm>
+#include <iterator>
 #include <set>
+#include <string>
+#include <type_traits>
+#include <vector>
 
 namespace huc
 {
   namespace combinatory
   {
+    /// IntersectionStrategy - Algorithms available to the Intersection engine.
+    enum class IntersectionStrategy
+    {
+      Auto,      // Inspect the inputs and choose one of the strategies below
+      Tree,      // Count the smaller sequence within a std::multiset - O(n.log(m)), any ordered type
+      Hash,      // Count the smaller sequence within a flat hash table - O(n + m), unsorted inputs
+      Merge,     // Linear merge of sorted inputs - O(n + m), sizes of the same order
+      Galloping, // Exponential search through the larger sorted input - O(m.log(n/m)), skewed sizes
+      Block      // SIMD 4x4 block comparisons - O(n + m), strictly increasing 32-bit integers
+    };
+
+    /// Minimum size ratio between the sorted sequences for the galloping strategy to be chosen.
+    const size_t kGallopingRatio = 32;
+
+    /// GallopLowerBound - Return the first element of the sorted sequence that is not less than value.
+    /// The bound is first located by exponential steps from begin, then refined by a binary search: its
+    /// cost only depends on the distance to the result, not on the size of the sequence.
+    ///
+    /// @tparam IT type using to go through the collection.
+    ///
+    /// @param begin,end - iterators to the initial and final positions of the sorted sequence.
+    /// @param value the value to compare the elements to.
+    ///
+    /// @complexity O(log(d)), d being the distance between begin and the result (O(d) steps for non random
+    /// access iterators).
+    ///
+    /// @return iterator to the first element not less than value, end if none.
+    template <typename IT>
+    IT GallopLowerBound(const IT& begin, const IT& end, const typename std::iterator_traits<IT>::value_type& value)
+    {
+      const auto kSize = std::distance(begin, end);
+      if (kSize == 0 || !(*begin < value))
+        return begin;
+
+      // Invariant: the element at bound / 2 is less than value
+      typename std::iterator_traits<IT>::difference_type bound = 1;
+      while (bound < kSize && *std::next(begin, bound) < value)
+        bound *= 2;
+
+      return std::lower_bound(std::next(begin, bound / 2 + 1), std::next(begin, std::min(bound + 1, kSize)),
+                              value);
+    }
+
+    /// TreeIntersection - Intersection counting the first sequence within a std::multiset.
+    ///
+    /// @return output iterator to the element past the last written element.
+    template <typename IT, typename OutputIT>
+    OutputIT TreeIntersection(const IT& beginCount, const IT& endCount,
+                              const IT& beginProbe, const IT& endProbe, OutputIT out)
+    {
+      std::multiset<typename std::iterator_traits<IT>::value_type> count(beginCount, endCount);
+
+      // Move element from count to intersection if found
+      for (auto it = beginProbe; it != endProbe; ++it)
+      {
+        auto foundIt = count.find(*it);
+        if (foundIt != count.end())
+        {
+          *out++ = *it;
+          count.erase(foundIt);
+        }
+      }
+
+      return out;
+    }
+
+    /// HashIntersection - Intersection counting the first sequence within a FlatHashCounter.
+    ///
+    /// @return output iterator to the element past the last written element.
+    template <typename IT, typename OutputIT>
+    OutputIT HashIntersection(const IT& beginCount, const IT& endCount,
+                              const IT& beginProbe, const IT& endProbe, OutputIT out)
+    {
+      FlatHashCounter<typename std::iterator_traits<IT>::value_type>
+        count(static_cast<size_t>(std::distance(beginCount, endCount)));
+      for (auto it = beginCount; it != endCount; ++it)
+        count.Add(*it);
+
+      // Consume one occurrence from count for each element found
+      for (auto it = beginProbe; it != endProbe; ++it)
+        if (count.Consume(*it))
+          *out++ = *it;
+
+      return out;
+    }
+
+    /// MergeIntersection - Intersection of two sorted sequences walking both of them once.
+    ///
+    /// @return output iterator to the element past the last written element.
+    template <typename IT, typename OutputIT>
+    OutputIT MergeIntersection(const IT& beginFirst, const IT& endFirst,
+                               const IT& beginSecond, const IT& endSecond, OutputIT out)
+    {
+      auto itFirst = beginFirst;
+      auto itSecond = beginSecond;
+      while (itFirst != endFirst && itSecond != endSecond)
+      {
+        if (*itFirst < *itSecond)
+          ++itFirst;
+        else if (*itSecond < *itFirst)
+          ++itSecond;
+        else
+        {
+          *out++ = *itSecond;
+          ++itFirst;
+          ++itSecond;
+        }
+      }
+
+      return out;
+    }
+
+    /// GallopingIntersection - Intersection of two sorted sequences galloping through the larger one.
+    ///
+    /// @return output iterator to the element past the last written element.
+    template <typename IT, typename OutputIT>
+    OutputIT GallopingIntersection(const IT& beginSmall, const IT& endSmall,
+                                   const IT& beginLarge, const IT& endLarge, OutputIT out)
+    {
+      auto largeIt = beginLarge;
+      for (auto it = beginSmall; it != endSmall && largeIt != endLarge; ++it)
+      {
+        largeIt = GallopLowerBound(largeIt, endLarge, *it);
+        if (largeIt != endLarge && !(*it < *largeIt))
+        {
+          *out++ = *largeIt;
+          ++largeIt;
+        }
+      }
+
+      return out;
+    }
+
+    /// BlockIntersection - Intersection of two strictly increasing sequences of 32-bit integers.
+    ///
+    /// Blocks of 4 elements of each sequence are compared all-against-all with 4 SIMD comparisons
+    /// (the second block being rotated between each of them), the block holding the smallest maximum is
+    /// then skipped (D. Lemire, L. Boytsov, N. Kurz - SIMD Compression and the Intersection of Sorted
+    /// Integers). Remaining elements are merged one by one.
+    ///
+    /// @warning inputs must not contain duplicates, an element matching several others would be
+    /// written several times.
+    ///
+    /// @return output iterator to the element past the last written element.
+    template <typename Value, typename OutputIT>
+    OutputIT BlockIntersection(const Value* first, size_t firstSize,
+                               const Value* second, size_t secondSize, OutputIT out)
+    {
+      static_assert(std::is_integral<Value>::value && sizeof(Value) == 4,
+                    "BlockIntersection requires 32-bit integers.");
+
+      size_t i = 0;
+      size_t j = 0;
+#ifdef HUC_USE_SSE2
+      while (i + 4 <= firstSize && j + 4 <= secondSize)
+      {
+        const __m128i firstBlock = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i));
+        __m128i secondBlock = _mm_loadu_si128(reinterpret_cast<const __m128i*>(second + j));
+
+        // Compare the first block with the 4 rotations of the second one
+        __m128i match = _mm_cmpeq_epi32(firstBlock, secondBlock);
+        for (int rotation = 0; rotation < 3; ++rotation)
+        {
+          secondBlock = _mm_shuffle_epi32(secondBlock, _MM_SHUFFLE(0, 3, 2, 1));
+          match = _mm_or_si128(match, _mm_cmpeq_epi32(firstBlock, secondBlock));
+        }
+
+        // Write matching elements of the first block in order
+        for (uint64_t mask = _mm_movemask_ps(_mm_castsi128_ps(match)); mask != 0; mask &= mask - 1)
+          *out++ = first[i + CountTrailingZeros(mask)];
+
+        // Skip the block(s) that cannot match anymore
+        const Value kFirstMax = first[i + 3];
+        const Value kSecondMax = second[j + 3];
+        if (kFirstMax <= kSecondMax)
+          i += 4;
+        if (kSecondMax <= kFirstMax)
+          j += 4;
+      }
+#endif
+
+      return MergeIntersection(first + i, first + firstSize, second + j, second + secondSize, out);
+    }
+
+    /// IsContiguousIterator - Whether or not IT walks through contiguous memory (pointer or vector).
+    template <typename IT>
+    struct IsContiguousIterator : std::integral_constant<bool,
+      std::is_pointer<IT>::value ||
+      std::is_same<IT, typename std::vector<typename std::iterator_traits<IT>::value_type>::iterator>::value ||
+      std::is_same<IT, typename std::vector<typename std::iterator_traits<IT>::value_type>::const_iterator>::value>
+    {};
+
+    /// IsHashable - Whether or not the FlatHashCounter can be used on values of type T.
+    template <typename T>
+    struct IsHashable : std::integral_constant<bool,
+      std::is_arithmetic<T>::value || std::is_pointer<T>::value || std::is_same<T, std::string>::value>
+    {};
+
+    /// IsBlockEligible - Whether or not the SIMD block intersection can be used on IT.
+    template <typename IT>
+    struct IsBlockEligible : std::integral_constant<bool,
+      IsContiguousIterator<IT>::value &&
+      std::is_integral<typename std::iterator_traits<IT>::value_type>::value &&
+      sizeof(typename std::iterator_traits<IT>::value_type) == 4>
+    {};
+
+    /// IsRandomAccess - Whether or not IT jumps in constant time, as required by the galloping search.
+    template <typename IT>
+    struct IsRandomAccess : std::is_base_of<std::random_access_iterator_tag,
+                                            typename std::iterator_traits<IT>::iterator_category>
+    {};
+
+    /// SortedState - Result of the inspection of a sequence order.
+    enum class SortedState { Unsorted, Sorted, StrictlyIncreasing };
+
+    /// GetSortedState - Inspect a sequence, stopping as soon as an element is found out of order.
+    ///
+    /// @return the order state of the sequence.
+    template <typename IT>
+    SortedState GetSortedState(const IT& begin, const IT& end)
+    {
+      if (begin == end)
+        return SortedState::StrictlyIncreasing;
+
+      bool isStrict = true;
+      for (auto prevIt = begin, it = std::next(begin); it != end; ++prevIt, ++it)
+      {
+        if (*it < *prevIt)
+          return SortedState::Unsorted;
+        if (!(*prevIt < *it))
+          isStrict = false;
+      }
+
+      return (isStrict) ? SortedState::StrictlyIncreasing : SortedState::Sorted;
+    }
+
+    /// Dispatch of the Block and Hash strategies to their fallback when not usable on the value type.
+    template <typename IT, typename OutputIT>
+    OutputIT DispatchBlockIntersection(const IT& beginFirst, const IT& endFirst,
+                                       const IT& beginSecond, const IT& endSecond, OutputIT out, std::true_type)
+    {
+      if (beginFirst == endFirst || beginSecond == endSecond)
+        return out;
+
+      return BlockIntersection(&*beginFirst, static_cast<size_t>(std::distance(beginFirst, endFirst)),
+                               &*beginSecond, static_cast<size_t>(std::distance(beginSecond, endSecond)), out);
+    }
+    template <typename IT, typename OutputIT>
+    OutputIT DispatchBlockIntersection(const IT& beginFirst, const IT& endFirst,
+                                       const IT& beginSecond, const IT& endSecond, OutputIT out, std::false_type)
+    { return MergeIntersection(beginFirst, endFirst, beginSecond, endSecond, out); }
+
+    template <typename IT, typename OutputIT>
+    OutputIT DispatchHashIntersection(const IT& beginCount, const IT& endCount,
+                                      const IT& beginProbe, const IT& endProbe, OutputIT out, std::true_type)
+    { return HashIntersection(beginCount, endCount, beginProbe, endProbe, out); }
+    template <typename IT, typename OutputIT>
+    OutputIT DispatchHashIntersection(const IT& beginCount, const IT& endCount,
+                                      const IT& beginProbe, const IT& endProbe, OutputIT out, std::false_type)
+    { return TreeIntersection(beginCount, endCount, beginProbe, endProbe, out); }
+
+    /// ChooseIntersectionStrategy - Select the fastest strategy given the shape of the inputs.
+    ///
+    /// - Both inputs sorted within random access sequences and sizes skewed by more than kGallopingRatio:
+    ///   Galloping.
+    /// - Both inputs strictly increasing 32-bit integers within contiguous memory: Block.
+    /// - Both inputs sorted: Merge.
+    /// - Otherwise: Hash, or Tree if the values cannot be hashed.
+    ///
+    /// @complexity O(n + m) in the worst case, the inspection stops at the first unordered element.
+    ///
+    /// @return the strategy to be used, never IntersectionStrategy::Auto.
+    template <typename IT>
+    IntersectionStrategy ChooseIntersectionStrategy(const IT& beginSmall, const IT& endSmall,
+                                                    const IT& beginLarge, const IT& endLarge)
+    {
+      const auto kUnsortedStrategy = (IsHashable<typename std::iterator_traits<IT>::value_type>::value) ?
+        IntersectionStrategy::Hash : IntersectionStrategy::Tree;
+
+      const auto kSmallState = GetSortedState(beginSmall, endSmall);
+      if (kSmallState == SortedState::Unsorted)
+        return kUnsortedStrategy;
+      const auto kLargeState = GetSortedState(beginLarge, endLarge);
+      if (kLargeState == SortedState::Unsorted)
+        return kUnsortedStrategy;
+
+      const auto kSmallSize = static_cast<size_t>(std::distance(beginSmall, endSmall));
+      const auto kLargeSize = static_cast<size_t>(std::distance(beginLarge, endLarge));
+      if (IsRandomAccess<IT>::value && kLargeSize / std::max<size_t>(kSmallSize, 1) >= kGallopingRatio)
+        return IntersectionStrategy::Galloping;
+
+      if (IsBlockEligible<IT>::value &&
+          kSmallState == SortedState::StrictlyIncreasing && kLargeState == SortedState::StrictlyIncreasing)
+        return IntersectionStrategy::Block;
+
+      return IntersectionStrategy::Merge;
+    }
+
     /// Intersection - Return Intersection of the two sequences.
     ///
     /// @remark Retrieve the intersection of two sequences keeping dupplicate keys distinct.
     ///
+    /// The engine inspects both sequences and picks the most suited algorithm (cf. IntersectionStrategy):
+    /// a linear merge or a galloping search when both of them are sorted, SIMD blocks comparisons for
+    /// sorted 32-bit ids and a flat hash table otherwise.
+    ///
+    /// @warning the Merge, Galloping and Block strategies require sorted inputs, the Block strategy
+    /// also requires the inputs to be free of duplicates: only force them on inputs known to comply.
+    ///
+    /// @tparam Container type of the output collection.
     /// @tparam IT type using to go through the collection.
     ///
     /// @param beginFirst,endFirst,beginSecond,endSecond - iterators to the initial and final positions of
     /// the sequences. The range used is [first,last), which contains all the elements between
     /// first and last, including the element pointed by first but not the element pointed by last.
+    /// @param strategy the algorithm to be used, automatically chosen by default.
     ///
     /// @return a vector containing the intersection of both sequences.
     template <typename Container, typename IT>
     Container Intersection(const IT& beginFirst, const IT& endFirst,
-                           const IT& beginSecond, const IT& endSecond)
+                           const IT& beginSecond, const IT& endSecond,
+                           IntersectionStrategy strategy = IntersectionStrategy::Auto)
     {
       // Take the smallest sequence for initial count
       const auto kFirstSize = std::distance(beginFirst, endFirst);
       const auto kSecondSize = std::distance(beginSecond, endSecond);
       const bool kIsFirstSmaller = (kFirstSize <= kSecondSize);
+      const auto kBeginSmall = (kIsFirstSmaller) ? beginFirst : beginSecond;
+      const auto kEndSmall = (kIsFirstSmaller) ? endFirst : endSecond;
+      const auto kBeginLarge = (kIsFirstSmaller) ? beginSecond : beginFirst;
+      const auto kEndLarge = (kIsFirstSmaller) ? endSecond : endFirst;
 
       // Create and set enough capacity for the intersection
       Container intersection;
       intersection.reserve((kIsFirstSmaller) ? kFirstSize : kSecondSize);
 
-      // Count each element of the smaller array
-      std::multiset<typename std::iterator_traits<IT>::value_type> count;
-      const auto kCountEndIt = (kIsFirstSmaller) ? endFirst : endSecond;
-      for (auto it = (kIsFirstSmaller) ? beginFirst : beginSecond; it != kCountEndIt; ++it)
-          count.insert(*it);
+      if (strategy == IntersectionStrategy::Auto)
+        strategy = ChooseIntersectionStrategy(kBeginSmall, kEndSmall, kBeginLarge, kEndLarge);
 
-      // Push the element if find into the multiset and delete its instance from the counter
-      auto kIntersectEndIt = (kIsFirstSmaller) ? endSecond : endFirst;
-      for (auto it = (kIsFirstSmaller) ? beginSecond : beginFirst; it != kIntersectEndIt; ++it)
+      auto out = std::back_inserter(intersection);
+      switch (strategy)
       {
-        // Move element from count to intersection if found
-        auto foundIt = count.find(*it);
-        if (foundIt != count.end())
-        {
-          intersection.push_back(*it);
-          count.erase(foundIt);
-        }
+        case IntersectionStrategy::Merge:
+          MergeIntersection(kBeginSmall, kEndSmall, kBeginLarge, kEndLarge, out);
+          break;
+        case IntersectionStrategy::Galloping:
+          GallopingIntersection(kBeginSmall, kEndSmall, kBeginLarge, kEndLarge, out);
+          break;
+        case IntersectionStrategy::Block:
+          DispatchBlockIntersection(kBeginSmall, kEndSmall, kBeginLarge, kEndLarge, out,
+                                    IsBlockEligible<IT>());
+          break;
+        case IntersectionStrategy::Hash:
+          DispatchHashIntersection(kBeginSmall, kEndSmall, kBeginLarge, kEndLarge, out,
+                                   IsHashable<typename std::iterator_traits<IT>::value_type>());
+          break;
+        default:
+          TreeIntersection(kBeginSmall, kEndSmall, kBeginLarge, kEndLarge, out);
+          break;
       }
 
       return intersection;
@@ -0,0 +1,130 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#ifndef MODULE_COMBINATORY_INTRINSICS_HXX
+#define MODULE_COMBINATORY_INTRINSICS_HXX
+
+// STD includes
+#include <cstdint>
+
+// SIMD instruction sets available at compile time.
+// Each HUC_USE_* macro is only defined when the compiler targets the instruction set, every algorithm
+// using them keeps a portable scalar path.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #define HUC_USE_SSE2
+  #include <emmintrin.h>
+#endif
+#if defined(__SSSE3__)
+  #define HUC_USE_SSSE3
+  #include <tmmintrin.h>
+#endif
+#if defined(__SSE4_1__)
+  #define HUC_USE_SSE41
+  #include <smmintrin.h>
+#endif
+#if defined(__AVX2__)
+  #define HUC_USE_AVX2
+  #include <immintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+  #include <intrin.h>
+#endif
+
+namespace huc
+{
+  namespace combinatory
+  {
+    /// PopCount - Return the number of bits set within value.
+    ///
+    /// @param value the 64 bits word.
+    ///
+    /// @return the number of bits set.
+    inline uint32_t PopCount(uint64_t value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+      return static_cast<uint32_t>(__builtin_popcountll(value));
+#else
+      value = value - ((value >> 1) & 0x5555555555555555ull);
+      value = (value & 0x3333333333333333ull) + ((value >> 2) & 0x3333333333333333ull);
+      value = (value + (value >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+      return static_cast<uint32_t>((value * 0x0101010101010101ull) >> 56);
+#endif
+    }
+
+    /// CountTrailingZeros - Return the index of the lowest bit set within value.
+    ///
+    /// @warning value must not be 0.
+    ///
+    /// @param value the 64 bits word.
+    ///
+    /// @return the number of trailing zero bits.
+    inline uint32_t CountTrailingZeros(uint64_t value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+      return static_cast<uint32_t>(__builtin_ctzll(value));
+#elif defined(_MSC_VER) && defined(_M_X64)
+      unsigned long index;
+      _BitScanForward64(&index, value);
+      return static_cast<uint32_t>(index);
+#else
+      uint32_t count = 0;
+      while (!(value & 1)) { value >>= 1; ++count; }
+      return count;
+#endif
+    }
+
+    /// CountLeadingZeros - Return the number of zero bits above the highest bit set within value.
+    ///
+    /// @warning value must not be 0.
+    ///
+    /// @param value the 64 bits word.
+    ///
+    /// @return the number of leading zero bits.
+    inline uint32_t CountLeadingZeros(uint64_t value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+      return static_cast<uint32_t>(__builtin_clzll(value));
+#elif defined(_MSC_VER) && defined(_M_X64)
+      unsigned long index;
+      _BitScanReverse64(&index, value);
+      return 63 - static_cast<uint32_t>(index);
+#else
+      uint32_t count = 0;
+      while (!(value & 0x8000000000000000ull)) { value <<= 1; ++count; }
+      return count;
+#endif
+    }
+
+    /// Mix64 - Bijective mix of a 64 bits word (SplitMix64 finalizer): each input bit affects each output
+    /// bit, turning weak hashes (e.g. identity of std::hash on integers) or counters into uniform values.
+    ///
+    /// @param value the 64 bits word.
+    ///
+    /// @return the mixed word.
+    inline uint64_t Mix64(uint64_t value)
+    {
+      value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+      value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+      return value ^ (value >> 31);
+    }
+  }
+}
+
+#endif // MODULE_COMBINATORY_INTRINSICS_HXX
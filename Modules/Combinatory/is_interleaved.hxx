@@ -20,26 +20,36 @@
 #ifndef MODULE_COMBINATORY_IS_INTERLEAVED_HXX
 #define MODULE_COMBINATORY_IS_INTERLEAVED_HXX
 
+#include <Combinatory/intersection.hxx>
+#include <DataStructures/flat_hash_counter.hxx>
+
 // STD includes
+#include <algorithm>
 #include <map>
+#include <type_traits>
+#include <vector>
 
 namespace huc
 {
   namespace combinatory
   {
-    /// IsInterleaved - Return whether or not if a sequence is the interleave of the two others.
-    ///
-    /// @tparam IT type using to go through the collection.
-    ///
-    /// @param beginFirst,endFirst,beginSecond,endSecond,beginFull,endFull - iterators to the initial and
-    /// final positions of the sequences. The range used is [first,last), which contains all the elements
-    /// between first and last, including the element pointed by first but not the element pointed by last.
-    ///
-    /// @return true if the last sequence is the interleave of the two others, false otherwise.
+    /// IsDenselyCountable - Whether or not the values of type T can index a dense count array (at most
+    /// 16-bit integers: 256 or 65536 counters).
+    template <typename T>
+    struct IsDenselyCountable : std::integral_constant<bool,
+      std::is_integral<T>::value && !std::is_same<T, bool>::value && sizeof(T) <= 2>
+    {};
+
+    /// Counting strategies used by IsInterleaved given the value type.
+    typedef std::integral_constant<int, 0> TreeCountTag;
+    typedef std::integral_constant<int, 1> HashCountTag;
+    typedef std::integral_constant<int, 2> DenseCountTag;
+
+    /// Count occurrences within a std::map - Any ordered type.
     template <typename IT>
-    bool IsInterleaved(const IT& beginFirst, const IT& endFirst,
-                       const IT& beginSecond, const IT& endSecond,
-                       const IT& beginFull, const IT& endFull)
+    bool IsCountInterleaved(const IT& beginFirst, const IT& endFirst,
+                            const IT& beginSecond, const IT& endSecond,
+                            const IT& beginFull, const IT& endFull, TreeCountTag)
     {
       // Lambda that count each element occurence within the map "count"
       std::map<typename std::iterator_traits<IT>::value_type, int> count;
@@ -73,6 +83,277 @@ namespace huc
 
       return true;
     }
+
+    /// Count occurrences within a FlatHashCounter - Hashable types.
+    template <typename IT>
+    bool IsCountInterleaved(const IT& beginFirst, const IT& endFirst,
+                            const IT& beginSecond, const IT& endSecond,
+                            const IT& beginFull, const IT& endFull, HashCountTag)
+    {
+      FlatHashCounter<typename std::iterator_traits<IT>::value_type>
+        count(static_cast<size_t>(std::distance(beginFull, endFull)));
+      for (auto it = beginFirst; it != endFirst; ++it)
+        count.Add(*it);
+      for (auto it = beginSecond; it != endSecond; ++it)
+        count.Add(*it);
+
+      // Sizes are equal: consuming every element of the full sequence empties the counter
+      for (auto it = beginFull; it != endFull; ++it)
+        if (!count.Consume(*it))
+          return false;
+
+      return true;
+    }
+
+    /// Count occurrences within a dense array indexed by the value - Small alphabets (8 or 16-bit integers).
+    /// Bytes are spread over 4 interleaved histograms so that consecutive equal values do not wait for each
+    /// other increment (store to load forwarding), the histograms being summed at the end.
+    /// The 65536 counters of 16-bit values are only worth clearing and scanning for long sequences: shorter
+    /// ones are counted within a FlatHashCounter.
+    template <typename IT>
+    bool IsCountInterleaved(const IT& beginFirst, const IT& endFirst,
+                            const IT& beginSecond, const IT& endSecond,
+                            const IT& beginFull, const IT& endFull, DenseCountTag)
+    {
+      typedef typename std::make_unsigned<typename std::iterator_traits<IT>::value_type>::type Index;
+      const size_t kAlphabetSize = size_t(1) << (8 * sizeof(Index));
+      const size_t kLaneCount = (sizeof(Index) == 1) ? 4 : 1;
+      if (sizeof(Index) > 1 && static_cast<size_t>(std::distance(beginFull, endFull)) < kAlphabetSize / 8)
+        return IsCountInterleaved(beginFirst, endFirst, beginSecond, endSecond, beginFull, endFull,
+                                  HashCountTag());
+
+      std::vector<int64_t> count(kAlphabetSize * kLaneCount, 0);
+      auto lHistogram = [&count, kAlphabetSize, kLaneCount](const IT& begin, const IT& end, int64_t delta)
+      {
+        size_t lane = 0;
+        for (auto it = begin; it != end; ++it, lane = (lane + 1) & (kLaneCount - 1))
+          count[lane * kAlphabetSize + static_cast<Index>(*it)] += delta;
+      };
+
+      lHistogram(beginFirst, endFirst, 1);
+      lHistogram(beginSecond, endSecond, 1);
+      lHistogram(beginFull, endFull, -1);
+
+      for (size_t value = 0; value < kAlphabetSize; ++value)
+      {
+        int64_t total = 0;
+        for (size_t lane = 0; lane < kLaneCount; ++lane)
+          total += count[lane * kAlphabetSize + value];
+        if (total != 0)
+          return false;
+      }
+
+      return true;
+    }
+
+    /// IsInterleaved - Return whether or not if a sequence is the interleave of the two others.
+    ///
+    /// @remark Only the elements counts are compared: the full sequence should be a permutation of the
+    /// concatenation of both sequences, whatever their relative order (cf. IsOrderedInterleaved).
+    ///
+    /// Counting uses a dense array for 8-bit integers and long sequences of 16-bit integers, a flat hash table
+    /// for other hashable types and a std::map otherwise.
+    ///
+    /// @tparam IT type using to go through the collection.
+    ///
+    /// @param beginFirst,endFirst,beginSecond,endSecond,beginFull,endFull - iterators to the initial and
+    /// final positions of the sequences. The range used is [first,last), which contains all the elements
+    /// between first and last, including the element pointed by first but not the element pointed by last.
+    ///
+    /// @return true if the last sequence is the interleave of the two others, false otherwise.
+    template <typename IT>
+    bool IsInterleaved(const IT& beginFirst, const IT& endFirst,
+                       const IT& beginSecond, const IT& endSecond,
+                       const IT& beginFull, const IT& endFull)
+    {
+      typedef typename std::iterator_traits<IT>::value_type Value;
+
+      if (std::distance(beginFirst, endFirst) + std::distance(beginSecond, endSecond) !=
+          std::distance(beginFull, endFull))
+        return false;
+
+      typedef std::integral_constant<int,
+        (IsDenselyCountable<Value>::value) ? 2 : (IsHashable<Value>::value) ? 1 : 0> CountTag;
+      return IsCountInterleaved(beginFirst, endFirst, beginSecond, endSecond, beginFull, endFull, CountTag());
+    }
+
+    /// IsOrderedInterleavedBytes - Bit-parallel order-preserving interleave check of byte strings.
+    ///
+    /// The dynamic programming table (cf. IsOrderedInterleaved) is walked along the full string: after k of
+    /// its bytes, bit j of the state tells whether they interleave the first j bytes of the shorter string
+    /// and the first k - j bytes of the longer one. Reading byte c = full[k], bit j either stays (longer[k - j]
+    /// is c) or moves to j + 1 (shorter[j] is c), no carry chain being involved:
+    ///   state = (state & longerMask(c, k)) | ((state << 1) & shorterMask(c))
+    /// Match masks are precomputed per byte value, as for bit-parallel LCS: the shorter string ones once, the
+    /// longer string ones (over its reversed bytes, so that they only need a shift) per block of the full
+    /// string, keeping the memory proportional to the shorter string.
+    ///
+    /// @complexity O(n.m / 64 + n + m) word operations, O(min(n, m)) memory (256 masks of min(n, m) + 1024 bits).
+    ///
+    /// @return true if full is an interleave of both strings preserving their order, false otherwise.
+    inline bool IsOrderedInterleavedBytes(const uint8_t* first, size_t firstSize,
+                                          const uint8_t* second, size_t secondSize,
+                                          const uint8_t* full, size_t fullSize)
+    {
+      if (firstSize + secondSize != fullSize)
+        return false;
+
+      // State over the shorter string
+      const bool kIsFirstShorter = firstSize <= secondSize;
+      const uint8_t* shorter = (kIsFirstShorter) ? first : second;
+      const uint8_t* longer = (kIsFirstShorter) ? second : first;
+      const size_t kColumns = (kIsFirstShorter) ? firstSize : secondSize;
+      const size_t kRows = (kIsFirstShorter) ? secondSize : firstSize;
+      const size_t kWords = (kColumns + 1 + 63) / 64;
+
+      // Bit j of shorterMasks[c] is set if shorter[j - 1] == c, j in [1, columns]
+      std::vector<uint64_t> shorterMasks(256 * kWords, 0);
+      for (size_t j = 1; j <= kColumns; ++j)
+        shorterMasks[shorter[j - 1] * kWords + j / 64] |= uint64_t(1) << (j % 64);
+
+      // Blocks of the full string, the longer string masks covering the bytes reachable from a block:
+      // bit r of longerMasks[c] is set if longer[blockEnd - 1 - r] == c
+      const size_t kBlockWords = std::max<size_t>(kWords, 16);
+      const size_t kBlockSize = 64 * kBlockWords;
+      const size_t kWindowWords = kBlockWords + kWords + 1;
+      std::vector<uint64_t> longerMasks(256 * kWindowWords);
+
+      std::vector<uint64_t> state(kWords, 0);
+      state[0] = 1;
+      for (size_t blockBegin = 0; blockBegin < fullSize; blockBegin += kBlockSize)
+      {
+        const size_t kBlockEnd = std::min(blockBegin + kBlockSize, fullSize);
+        std::fill(longerMasks.begin(), longerMasks.end(), 0);
+        for (size_t r = 0; r < kBlockSize + kColumns && r < blockBegin + kBlockSize; ++r)
+        {
+          const size_t kPosition = blockBegin + kBlockSize - 1 - r;
+          if (kPosition < kRows)
+            longerMasks[longer[kPosition] * kWindowWords + r / 64] |= uint64_t(1) << (r % 64);
+        }
+
+        for (size_t k = blockBegin; k < kBlockEnd; ++k)
+        {
+          // longerMask(c, k) is longerMasks[c] shifted right by the distance to the end of the block
+          const size_t kOffset = blockBegin + kBlockSize - 1 - k;
+          const uint64_t* kLonger = &longerMasks[full[k] * kWindowWords + kOffset / 64];
+          const uint64_t* kShorter = &shorterMasks[full[k] * kWords];
+          const uint32_t kShift = kOffset % 64;
+
+          uint64_t carry = 0, isAlive = 0;
+          for (size_t w = 0; w < kWords; ++w)
+          {
+            const uint64_t kLongerMask =
+              (kShift == 0) ? kLonger[w] : (kLonger[w] >> kShift) | (kLonger[w + 1] << (64 - kShift));
+            const uint64_t kState = state[w];
+            state[w] = (kState & kLongerMask) | (((kState << 1) | carry) & kShorter[w]);
+            carry = kState >> 63;
+            isAlive |= state[w];
+          }
+
+          if (!isAlive)
+            return false;
+        }
+      }
+
+      return (state[kColumns / 64] >> (kColumns % 64)) & 1;
+    }
+
+    /// Order-preserving check using a rolling boolean row - Any comparable type.
+    template <typename IT>
+    bool IsOrderedInterleavedRolling(const IT& beginFirst, const IT& endFirst,
+                                     const IT& beginSecond, const IT& endSecond,
+                                     const IT& beginFull, const IT& endFull)
+    {
+      const auto kFirstSize = static_cast<size_t>(std::distance(beginFirst, endFirst));
+      const auto kSecondSize = static_cast<size_t>(std::distance(beginSecond, endSecond));
+      if (kFirstSize + kSecondSize != static_cast<size_t>(std::distance(beginFull, endFull)))
+        return false;
+
+      // Columns over the shorter sequence, rows over the longer one
+      const bool kIsFirstShorter = kFirstSize <= kSecondSize;
+      const IT shorter = (kIsFirstShorter) ? beginFirst : beginSecond;
+      const IT longer = (kIsFirstShorter) ? beginSecond : beginFirst;
+      const size_t kColumns = (kIsFirstShorter) ? kFirstSize : kSecondSize;
+      const size_t kRows = (kIsFirstShorter) ? kSecondSize : kFirstSize;
+
+      // row[j] - whether full[0, i + j) is an interleave of longer[0, i) and shorter[0, j)
+      std::vector<uint8_t> row(kColumns + 1, 0);
+      row[0] = 1;
+      for (size_t j = 1; j <= kColumns; ++j)
+        row[j] = row[j - 1] && shorter[j - 1] == beginFull[j - 1];
+
+      for (size_t i = 1; i <= kRows; ++i)
+      {
+        bool isAlive = false;
+        row[0] = row[0] && longer[i - 1] == beginFull[i - 1];
+        isAlive |= row[0] != 0;
+        for (size_t j = 1; j <= kColumns; ++j)
+        {
+          row[j] = (row[j] && longer[i - 1] == beginFull[i + j - 1]) ||
+                   (row[j - 1] && shorter[j - 1] == beginFull[i + j - 1]);
+          isAlive |= row[j] != 0;
+        }
+
+        if (!isAlive)
+          return false;
+      }
+
+      return row[kColumns] != 0;
+    }
+
+    template <typename IT>
+    bool DispatchOrderedInterleaved(const IT& beginFirst, const IT& endFirst,
+                                    const IT& beginSecond, const IT& endSecond,
+                                    const IT& beginFull, const IT& endFull, std::true_type)
+    {
+      auto lData = [](const IT& begin, const IT& end)
+        { return (begin == end) ? nullptr : reinterpret_cast<const uint8_t*>(&*begin); };
+
+      return IsOrderedInterleavedBytes(
+        lData(beginFirst, endFirst), static_cast<size_t>(std::distance(beginFirst, endFirst)),
+        lData(beginSecond, endSecond), static_cast<size_t>(std::distance(beginSecond, endSecond)),
+        lData(beginFull, endFull), static_cast<size_t>(std::distance(beginFull, endFull)));
+    }
+    template <typename IT>
+    bool DispatchOrderedInterleaved(const IT& beginFirst, const IT& endFirst,
+                                    const IT& beginSecond, const IT& endSecond,
+                                    const IT& beginFull, const IT& endFull, std::false_type)
+    {
+      return IsOrderedInterleavedRolling(beginFirst, endFirst, beginSecond, endSecond, beginFull, endFull);
+    }
+
+    /// IsOrderedInterleaved - Return whether or not a sequence is an interleave of the two others preserving
+    /// the relative order of the elements of each of them (e.g. "axbyc" interleaves "abc" and "xy").
+    ///
+    /// Dynamic programming: cell (i, j) tells whether the first i + j elements of the full sequence are an
+    /// interleave of the first i elements of a sequence and the first j elements of the other. Rows are
+    /// computed one after the other over the shorter sequence, stopping as soon as a row is empty.
+    /// Contiguous byte strings (std::string, std::vector<char>...) use a bit-parallel computation of the table
+    /// (cf. IsOrderedInterleavedBytes).
+    ///
+    /// @tparam IT type using to go through the collection (random access).
+    ///
+    /// @param beginFirst,endFirst,beginSecond,endSecond,beginFull,endFull - iterators to the initial and
+    /// final positions of the sequences. The range used is [first,last), which contains all the elements
+    /// between first and last, including the element pointed by first but not the element pointed by last.
+    ///
+    /// @complexity O(n.m) time (O(n.m / 64) for byte strings), O(min(n, m)) memory.
+    ///
+    /// @return true if the last sequence is an ordered interleave of the two others, false otherwise.
+    template <typename IT>
+    bool IsOrderedInterleaved(const IT& beginFirst, const IT& endFirst,
+                              const IT& beginSecond, const IT& endSecond,
+                              const IT& beginFull, const IT& endFull)
+    {
+      typedef typename std::iterator_traits<IT>::value_type Value;
+      typedef std::integral_constant<bool, std::is_integral<Value>::value && !std::is_same<Value, bool>::value &&
+        sizeof(Value) == 1 && (IsContiguousIterator<IT>::value ||
+        std::is_same<IT, std::string::iterator>::value || std::is_same<IT, std::string::const_iterator>::value)>
+        IsByteString;
+
+      return DispatchOrderedInterleaved(beginFirst, endFirst, beginSecond, endSecond, beginFull, endFull,
+                                        IsByteString());
+    }
   }
 }
 
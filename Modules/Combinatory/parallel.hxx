@@ -0,0 +1,130 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#ifndef MODULE_COMBINATORY_PARALLEL_HXX
+#define MODULE_COMBINATORY_PARALLEL_HXX
+
+// STD includes
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace huc
+{
+  namespace combinatory
+  {
+    /// GetThreadCount - Return the number of threads to be used.
+    ///
+    /// @param requested number of threads requested, 0 to use every hardware thread.
+    ///
+    /// @return the number of threads to be used, at least 1.
+    inline uint32_t GetThreadCount(uint32_t requested = 0)
+    {
+      if (requested > 0)
+        return requested;
+
+      const auto kHardware = std::thread::hardware_concurrency();
+      return (kHardware > 0) ? kHardware : 1;
+    }
+
+    /// ParallelRun - Run functor(threadIdx) on threadCount threads and wait for all of them.
+    /// The calling thread takes part of the work as thread 0.
+    ///
+    /// @tparam Functor type of the functor called with the thread index (uint32_t).
+    ///
+    /// @param threadCount number of threads to be used.
+    /// @param functor the functor to be run by each thread.
+    ///
+    /// @return void.
+    template <typename Functor>
+    void ParallelRun(uint32_t threadCount, Functor functor)
+    {
+      std::vector<std::thread> threads;
+      threads.reserve(threadCount);
+      for (uint32_t threadIdx = 1; threadIdx < threadCount; ++threadIdx)
+        threads.push_back(std::thread(functor, threadIdx));
+
+      functor(0);
+      for (auto it = threads.begin(); it != threads.end(); ++it)
+        it->join();
+    }
+
+    /// @class Barrier
+    ///
+    /// Reusable synchronization point of a team of threads (cf. ParallelRun): Wait returns once every thread of
+    /// the team has called it. It lets one team run the successive phases of an algorithm, instead of spawning
+    /// threads for each phase.
+    class Barrier
+    {
+    public:
+      explicit Barrier(uint32_t threadCount) : threadCount(threadCount), waitingCount(0), generation(0) {}
+
+      /// Wait - Block until every thread of the team has reached the barrier.
+      void Wait()
+      {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        const uint64_t kGeneration = this->generation;
+        if (++this->waitingCount == this->threadCount)
+        {
+          this->waitingCount = 0;
+          ++this->generation;
+          this->condition.notify_all();
+          return;
+        }
+        this->condition.wait(lock, [this, kGeneration]() { return this->generation != kGeneration; });
+      }
+
+    private:
+      Barrier(const Barrier&);           // Not Implemented
+      Barrier operator=(const Barrier&); // Not Implemented
+
+      std::mutex mutex;                   // Protects the counters
+      std::condition_variable condition;  // Signaled when the last thread arrives
+      const uint32_t threadCount;         // Number of threads of the team
+      uint32_t waitingCount;              // Number of threads waiting for the current generation
+      uint64_t generation;                // Number of times the team went through the barrier
+    };
+
+    /// ParallelTasks - Run functor(taskIdx, threadIdx) on each task of [0, taskCount) using threadCount
+    /// threads. Idle threads pull the next task from a shared counter, so uneven tasks stay balanced.
+    ///
+    /// @tparam Functor type of the functor called with the task index (size_t) and thread index (uint32_t).
+    ///
+    /// @param taskCount number of tasks to be run.
+    /// @param threadCount number of threads to be used.
+    /// @param functor the functor to be run on each task.
+    ///
+    /// @return void.
+    template <typename Functor>
+    void ParallelTasks(size_t taskCount, uint32_t threadCount, Functor functor)
+    {
+      std::atomic<size_t> nextTask(0);
+      ParallelRun(threadCount, [&nextTask, taskCount, &functor](uint32_t threadIdx)
+      {
+        for (size_t task = nextTask++; task < taskCount; task = nextTask++)
+          functor(task, threadIdx);
+      });
+    }
+  }
+}
+
+#endif // MODULE_COMBINATORY_PARALLEL_HXX
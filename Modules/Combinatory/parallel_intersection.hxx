@@ -0,0 +1,211 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#ifndef MODULE_COMBINATORY_PARALLEL_INTERSECTION_HXX
+#define MODULE_COMBINATORY_PARALLEL_INTERSECTION_HXX
+
+#include <Combinatory/intersection.hxx>
+#include <Combinatory/intrinsics.hxx>
+#include <Combinatory/parallel.hxx>
+#include <DataStructures/flat_hash_counter.hxx>
+
+// STD includes
+#include <functional>
+#include <iterator>
+#include <vector>
+
+namespace huc
+{
+  namespace combinatory
+  {
+    /// Number of elements of the smaller sequence per partition: its hash table should fit within L2 cache.
+    const size_t kIntersectionPartitionSize = 1 << 15;
+    /// Minimum size of the smaller sequence for ParallelIntersection to partition the sequences.
+    const size_t kParallelIntersectionMinSize = 1 << 16;
+
+    /// GetHashPartition - Return the partition of value among 2^partitionBits partitions.
+    /// The top bits of the SplitMix64 finalizer of the hash are used. The FlatHashCounter of each partition
+    /// takes its home slots from the top bits of the Fibonacci product of the same hash: partitioning on the
+    /// product would give all the keys of a partition the same leading home slot bits, clustering them
+    /// within 1 / 2^partitionBits of the table.
+    template <typename Value>
+    size_t GetHashPartition(const Value& value, uint32_t partitionBits)
+    {
+      if (partitionBits == 0)
+        return 0;
+
+      const uint64_t kHash = Mix64(static_cast<uint64_t>(std::hash<Value>()(value)));
+      return static_cast<size_t>(kHash >> (64 - partitionBits));
+    }
+
+    /// HashPartition - Scatter a sequence into 2^partitionBits partitions of a contiguous buffer.
+    ///
+    /// Each thread builds the histogram of its own chunk of the sequence, a prefix sum over the
+    /// (partition, thread) histograms then gives each thread a private write cursor per partition, so that
+    /// the scatter pass requires no synchronization and is stable regardless of scheduling.
+    ///
+    /// @tparam IT type using to go through the collection (random access).
+    ///
+    /// @param begin,end - iterators to the initial and final positions of the sequence.
+    /// @param partitionBits log2 of the number of partitions.
+    /// @param threadCount number of threads to be used.
+    /// @param partitioned output buffer receiving the elements grouped by partition.
+    /// @param offsets output offsets of each partition within the buffer (partition count + 1 values).
+    ///
+    /// @return void.
+    template <typename IT>
+    void HashPartition(const IT& begin, const IT& end, uint32_t partitionBits, uint32_t threadCount,
+                       std::vector<typename std::iterator_traits<IT>::value_type>& partitioned,
+                       std::vector<size_t>& offsets)
+    {
+      const size_t kSize = static_cast<size_t>(std::distance(begin, end));
+      const size_t kPartitionCount = size_t(1) << partitionBits;
+      const size_t kChunkSize = (kSize + threadCount - 1) / threadCount;
+
+      // Histogram of each thread chunk
+      std::vector<size_t> cursors(threadCount * kPartitionCount, 0);
+      ParallelRun(threadCount, [&](uint32_t threadIdx)
+      {
+        const size_t kFirst = std::min(kSize, threadIdx * kChunkSize);
+        const size_t kLast = std::min(kSize, kFirst + kChunkSize);
+        size_t* histogram = &cursors[threadIdx * kPartitionCount];
+        for (auto it = begin + kFirst; it != begin + kLast; ++it)
+          ++histogram[GetHashPartition(*it, partitionBits)];
+      });
+
+      // Exclusive prefix sum, partition major, then thread
+      offsets.assign(kPartitionCount + 1, 0);
+      size_t offset = 0;
+      for (size_t partition = 0; partition < kPartitionCount; ++partition)
+      {
+        offsets[partition] = offset;
+        for (uint32_t threadIdx = 0; threadIdx < threadCount; ++threadIdx)
+        {
+          const size_t kCount = cursors[threadIdx * kPartitionCount + partition];
+          cursors[threadIdx * kPartitionCount + partition] = offset;
+          offset += kCount;
+        }
+      }
+      offsets[kPartitionCount] = offset;
+
+      // Scatter each element at its thread private cursor
+      partitioned.resize(kSize);
+      ParallelRun(threadCount, [&](uint32_t threadIdx)
+      {
+        const size_t kFirst = std::min(kSize, threadIdx * kChunkSize);
+        const size_t kLast = std::min(kSize, kFirst + kChunkSize);
+        size_t* cursor = &cursors[threadIdx * kPartitionCount];
+        for (auto it = begin + kFirst; it != begin + kLast; ++it)
+          partitioned[cursor[GetHashPartition(*it, partitionBits)]++] = *it;
+      });
+    }
+
+    /// ParallelIntersection - Return Intersection of two unsorted sequences using every core.
+    ///
+    /// Both sequences are radix-partitioned by hash into P partitions sized to fit the cache, equal keys
+    /// landing in the same partition. Each pair of partitions is then intersected independently with a
+    /// thread local flat hash table, and the partial results are concatenated at prefix-summed offsets.
+    ///
+    /// @remark Retrieve the intersection keeping dupplicate keys distinct (as Intersection).
+    /// The order of the elements is unspecified: it depends on the hash and the number of threads.
+    /// Small inputs are processed by the sequential Intersection.
+    ///
+    /// @tparam Container type of the output collection, supporting resize and random access.
+    /// @tparam IT type using to go through the collection (random access), its values must be hashable.
+    ///
+    /// @param beginFirst,endFirst,beginSecond,endSecond - iterators to the initial and final positions of
+    /// the sequences. The range used is [first,last), which contains all the elements between
+    /// first and last, including the element pointed by first but not the element pointed by last.
+    /// @param threadCount number of threads to be used, every hardware thread by default.
+    ///
+    /// @complexity O((n + m) / threadCount) expected.
+    ///
+    /// @return a container holding the intersection of both sequences.
+    template <typename Container, typename IT>
+    Container ParallelIntersection(const IT& beginFirst, const IT& endFirst,
+                                   const IT& beginSecond, const IT& endSecond, uint32_t threadCount = 0)
+    {
+      typedef typename std::iterator_traits<IT>::value_type Value;
+
+      const auto kFirstSize = static_cast<size_t>(std::distance(beginFirst, endFirst));
+      const auto kSecondSize = static_cast<size_t>(std::distance(beginSecond, endSecond));
+      const bool kIsFirstSmaller = (kFirstSize <= kSecondSize);
+      const size_t kSmallSize = (kIsFirstSmaller) ? kFirstSize : kSecondSize;
+      threadCount = GetThreadCount(threadCount);
+
+      if (threadCount < 2 || kSmallSize < kParallelIntersectionMinSize)
+        return Intersection<Container, IT>(beginFirst, endFirst, beginSecond, endSecond,
+                                           IntersectionStrategy::Hash);
+
+      // Enough partitions to keep each hash table within cache and every thread busy
+      uint32_t partitionBits = 0;
+      while ((kSmallSize >> partitionBits) > kIntersectionPartitionSize ||
+             (size_t(1) << partitionBits) < 4 * threadCount)
+        ++partitionBits;
+      const size_t kPartitionCount = size_t(1) << partitionBits;
+
+      std::vector<Value> small, large;
+      std::vector<size_t> smallOffsets, largeOffsets;
+      HashPartition((kIsFirstSmaller) ? beginFirst : beginSecond, (kIsFirstSmaller) ? endFirst : endSecond,
+                    partitionBits, threadCount, small, smallOffsets);
+      HashPartition((kIsFirstSmaller) ? beginSecond : beginFirst, (kIsFirstSmaller) ? endSecond : endFirst,
+                    partitionBits, threadCount, large, largeOffsets);
+
+      // Intersect each pair of partitions, writing in place of the small partition (upper bound)
+      std::vector<size_t> counts(kPartitionCount + 1, 0);
+      std::vector<FlatHashCounter<Value>> counters(threadCount);
+      ParallelTasks(kPartitionCount, threadCount, [&](size_t partition, uint32_t threadIdx)
+      {
+        auto& counter = counters[threadIdx];
+        counter.Clear();
+        counter.Reserve(smallOffsets[partition + 1] - smallOffsets[partition]);
+        for (size_t i = smallOffsets[partition]; i < smallOffsets[partition + 1]; ++i)
+          counter.Add(small[i]);
+
+        size_t outIdx = smallOffsets[partition];
+        for (size_t i = largeOffsets[partition]; i < largeOffsets[partition + 1]; ++i)
+          if (counter.Consume(large[i]))
+            small[outIdx++] = large[i];
+        counts[partition] = outIdx - smallOffsets[partition];
+      });
+
+      // Concatenate the partial results at their prefix-summed offsets
+      size_t total = 0;
+      for (size_t partition = 0; partition <= kPartitionCount; ++partition)
+      {
+        const size_t kCount = counts[partition];
+        counts[partition] = total;
+        total += kCount;
+      }
+
+      Container intersection;
+      intersection.resize(total);
+      ParallelTasks(kPartitionCount, threadCount, [&](size_t partition, uint32_t)
+      {
+        std::copy(small.begin() + smallOffsets[partition],
+                  small.begin() + smallOffsets[partition] + (counts[partition + 1] - counts[partition]),
+                  intersection.begin() + counts[partition]);
+      });
+
+      return intersection;
+    }
+  }
+}
+
+#endif // MODULE_COMBINATORY_PARALLEL_INTERSECTION_HXX
@@ -0,0 +1,293 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#ifndef MODULE_COMBINATORY_PARTITIONS_HXX
+#define MODULE_COMBINATORY_PARTITIONS_HXX
+
+// STD includes
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace huc
+{
+  namespace combinatory
+  {
+    /// @class PartitionGenerator
+    ///
+    /// Lazy generator of the partitions of n (multisets of positive parts summing to n), in decreasing
+    /// lexicographic order with parts sorted in decreasing order: {n}, {n-1, 1}, {n-2, 2}, ..., {1, ..., 1}.
+    /// Only the current partition is stored, unlike the list returned by Combinations or Permutations.
+    ///
+    /// Follows ZS1 (Zoghbi and Stojmenovic): the last part greater than 1 is tracked so that each step only
+    /// rewrites the tail of the partition, in constant amortised time. The number of parts and the size of
+    /// the parts can be bounded: the step then decreases the last part whose remainder still fits.
+    ///
+    /// Usage: for (PartitionGenerator partition(n); partition.IsValid(); partition.Next()) ...
+    class PartitionGenerator
+    {
+    public:
+      /// PartitionGenerator constructor - Set the first partition: as many parts of maximal size as possible.
+      ///
+      /// @param n the integer to be partitioned.
+      /// @param maxParts maximum number of parts, 0 for no bound.
+      /// @param maxPartSize maximum size of the parts, 0 for no bound.
+      PartitionGenerator(uint32_t n, uint32_t maxParts = 0, uint32_t maxPartSize = 0) :
+        maxParts((maxParts == 0) ? n : maxParts), valid(true)
+      {
+        const uint32_t kPartSize = (maxPartSize == 0) ? n : std::min(n, maxPartSize);
+        this->parts.reserve(std::min<size_t>(n, this->maxParts));
+        if (n == 0)
+        {
+          this->lastBig = -1;
+          return;
+        }
+
+        this->valid = kPartSize > 0 && Fill(n, kPartSize, this->maxParts);
+        this->lastBig = (this->valid) ? FindLastBig() : -1;
+      }
+
+      /// Whether the generator holds a partition, false once all of them have been generated.
+      bool IsValid() const { return this->valid; }
+
+      /// Return the parts of the current partition, in decreasing order.
+      const std::vector<uint32_t>& Parts() const { return this->parts; }
+
+      /// Next - Move to the next partition.
+      ///
+      /// @return true if there is a next partition, false otherwise.
+      bool Next()
+      {
+        if (!this->valid)
+          return false;
+
+        // Parts after the last big one are 1s
+        uint64_t suffix = this->parts.size() - static_cast<size_t>(this->lastBig + 1);
+        for (std::ptrdiff_t h = this->lastBig; h >= 0; --h)
+        {
+          const uint32_t kPart = this->parts[static_cast<size_t>(h)] - 1;
+          const uint64_t kRemainder = suffix + 1;
+          const size_t kSlots = this->maxParts - static_cast<size_t>(h + 1);
+
+          // ZS1 fast path: a 2 becomes 1 + 1
+          if (kPart == 1 && h == this->lastBig && kRemainder <= kSlots)
+          {
+            this->parts[static_cast<size_t>(h)] = 1;
+            this->parts.push_back(1);
+            --this->lastBig;
+            return true;
+          }
+
+          if ((kRemainder + kPart - 1) / kPart <= kSlots)
+          {
+            this->parts[static_cast<size_t>(h)] = kPart;
+            this->parts.resize(static_cast<size_t>(h + 1));
+            Fill(kRemainder, kPart, kSlots);
+            this->lastBig = FindLastBig();
+            return true;
+          }
+
+          suffix += this->parts[static_cast<size_t>(h)];
+        }
+
+        this->valid = false;
+        return false;
+      }
+
+    private:
+      std::vector<uint32_t> parts; // Parts of the current partition, in decreasing order
+      size_t maxParts;             // Maximum number of parts
+      std::ptrdiff_t lastBig;      // Index of the last part greater than 1, -1 if none
+      bool valid;                  // Whether parts holds a partition
+
+      /// Append the greatest parts of at most partSize summing to amount, if slots are enough.
+      bool Fill(uint64_t amount, uint32_t partSize, size_t slots)
+      {
+        if ((amount + partSize - 1) / partSize > slots)
+          return false;
+
+        this->parts.insert(this->parts.end(), static_cast<size_t>(amount / partSize), partSize);
+        if (amount % partSize != 0)
+          this->parts.push_back(static_cast<uint32_t>(amount % partSize));
+        return true;
+      }
+
+      /// Parts are decreasing: the last big part is found from the end, within the tail just filled.
+      std::ptrdiff_t FindLastBig() const
+      {
+        std::ptrdiff_t index = static_cast<std::ptrdiff_t>(this->parts.size()) - 1;
+        while (index >= 0 && this->parts[static_cast<size_t>(index)] == 1)
+          --index;
+        return index;
+      }
+    };
+
+    /// @class CompositionGenerator
+    ///
+    /// Lazy generator of the compositions of n (sequences of positive parts summing to n), in decreasing
+    /// lexicographic order: {n}, {n-1, 1}, {n-2, 2}, {n-2, 1, 1}, ..., {1, ..., 1}.
+    ///
+    /// Without bounds this is a walk over the 2^(n-1) binary strings of the cuts between the n units,
+    /// counting downward from the last cut: each step splits the last part, or merges the trailing 1s into
+    /// the part before them. Only the tail of the composition is rewritten, in constant amortised time.
+    ///
+    /// Usage: for (CompositionGenerator composition(n); composition.IsValid(); composition.Next()) ...
+    class CompositionGenerator
+    {
+    public:
+      /// CompositionGenerator constructor - Set the first composition: parts of maximal size first.
+      ///
+      /// @param n the integer to be composed.
+      /// @param maxParts maximum number of parts, 0 for no bound.
+      /// @param maxPartSize maximum size of the parts, 0 for no bound.
+      CompositionGenerator(uint32_t n, uint32_t maxParts = 0, uint32_t maxPartSize = 0) :
+        maxParts((maxParts == 0) ? n : maxParts), maxPartSize((maxPartSize == 0) ? n : std::min(n, maxPartSize)),
+        valid(true)
+      {
+        this->parts.reserve(std::min<size_t>(n, this->maxParts));
+        if (n > 0)
+          this->valid = this->maxPartSize > 0 && Fill(n, this->maxParts);
+      }
+
+      /// Whether the generator holds a composition, false once all of them have been generated.
+      bool IsValid() const { return this->valid; }
+
+      /// Return the parts of the current composition.
+      const std::vector<uint32_t>& Parts() const { return this->parts; }
+
+      /// Next - Move to the next composition.
+      ///
+      /// @return true if there is a next composition, false otherwise.
+      bool Next()
+      {
+        if (!this->valid)
+          return false;
+
+        // Decrease the last part that can be, the greatest feasible suffix following it
+        uint64_t suffix = 0;
+        for (std::ptrdiff_t h = static_cast<std::ptrdiff_t>(this->parts.size()) - 1; h >= 0; --h)
+        {
+          const size_t kIndex = static_cast<size_t>(h);
+          const size_t kSlots = this->maxParts - (kIndex + 1);
+          if (this->parts[kIndex] > 1 && (suffix + this->maxPartSize) / this->maxPartSize <= kSlots)
+          {
+            --this->parts[kIndex];
+            this->parts.resize(kIndex + 1);
+            Fill(suffix + 1, kSlots);
+            return true;
+          }
+
+          suffix += this->parts[kIndex];
+        }
+
+        this->valid = false;
+        return false;
+      }
+
+    private:
+      std::vector<uint32_t> parts; // Parts of the current composition
+      size_t maxParts;             // Maximum number of parts
+      uint32_t maxPartSize;        // Maximum size of the parts
+      bool valid;                  // Whether parts holds a composition
+
+      /// Append the greatest parts summing to amount, if slots are enough.
+      bool Fill(uint64_t amount, size_t slots)
+      {
+        if ((amount + this->maxPartSize - 1) / this->maxPartSize > slots)
+          return false;
+
+        this->parts.insert(this->parts.end(), static_cast<size_t>(amount / this->maxPartSize), this->maxPartSize);
+        if (amount % this->maxPartSize != 0)
+          this->parts.push_back(static_cast<uint32_t>(amount % this->maxPartSize));
+        return true;
+      }
+    };
+
+    /// CountPartitions - Return the number of partitions of n, with optional bounds.
+    /// Table of the partitions of each j <= n into at most c parts, extended one part size at a time:
+    /// p(j, c) += p(j - s, c - 1) when parts of size s are allowed.
+    ///
+    /// @warning the count overflows 64 bits beyond n = 416 without bounds.
+    ///
+    /// @param n the integer to be partitioned.
+    /// @param maxParts maximum number of parts, 0 for no bound.
+    /// @param maxPartSize maximum size of the parts, 0 for no bound.
+    ///
+    /// @complexity O(n.k.m) time, O(n.k) memory.
+    ///
+    /// @return the number of partitions.
+    inline uint64_t CountPartitions(uint32_t n, uint32_t maxParts = 0, uint32_t maxPartSize = 0)
+    {
+      const size_t kParts = (maxParts == 0) ? n : std::min(n, maxParts);
+      const uint32_t kPartSize = (maxPartSize == 0) ? n : std::min(n, maxPartSize);
+
+      // table[j * (kParts + 1) + c]: partitions of j into at most c parts of size at most s
+      std::vector<uint64_t> table((n + 1) * (kParts + 1), 0);
+      for (size_t c = 0; c <= kParts; ++c)
+        table[c] = 1;
+      for (uint32_t s = 1; s <= kPartSize; ++s)
+        for (uint32_t j = s; j <= n; ++j)
+          for (size_t c = 1; c <= kParts; ++c)
+            table[j * (kParts + 1) + c] += table[(j - s) * (kParts + 1) + c - 1];
+
+      return table[n * (kParts + 1) + kParts];
+    }
+
+    /// CountCompositions - Return the number of compositions of n, with optional bounds.
+    /// Table of the compositions of each j <= n into exactly c parts: q(j, c) = sum of q(j - s, c - 1) over
+    /// the allowed part sizes s, each sum being read from prefix sums.
+    ///
+    /// @warning the count overflows 64 bits beyond n = 64 without bounds (2^(n-1)).
+    ///
+    /// @param n the integer to be composed.
+    /// @param maxParts maximum number of parts, 0 for no bound.
+    /// @param maxPartSize maximum size of the parts, 0 for no bound.
+    ///
+    /// @complexity O(n.k) time, O(n) memory.
+    ///
+    /// @return the number of compositions.
+    inline uint64_t CountCompositions(uint32_t n, uint32_t maxParts = 0, uint32_t maxPartSize = 0)
+    {
+      if (n == 0)
+        return 1;
+
+      const size_t kParts = (maxParts == 0) ? n : std::min(n, maxParts);
+      const uint32_t kPartSize = (maxPartSize == 0) ? n : std::min(n, maxPartSize);
+
+      // Compositions into exactly c parts, for the previous and the current c
+      std::vector<uint64_t> previous(n + 1, 0), current(n + 1, 0), prefix(n + 2, 0);
+      previous[0] = 1;
+      uint64_t count = 0;
+      for (size_t c = 1; c <= kParts; ++c)
+      {
+        for (uint32_t j = 0; j <= n; ++j)
+          prefix[j + 1] = prefix[j] + previous[j];
+        for (uint32_t j = 0; j <= n; ++j)
+          current[j] = prefix[j] - prefix[(j > kPartSize) ? j - kPartSize : 0];
+        count += current[n];
+        previous.swap(current);
+      }
+
+      return count;
+    }
+  }
+}
+
+#endif // MODULE_COMBINATORY_PARTITIONS_HXX
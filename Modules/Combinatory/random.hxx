@@ -0,0 +1,110 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#ifndef MODULE_COMBINATORY_RANDOM_HXX
+#define MODULE_COMBINATORY_RANDOM_HXX
+
+#include <Combinatory/intrinsics.hxx>
+
+// STD includes
+#include <cstdint>
+
+namespace huc
+{
+  namespace combinatory
+  {
+    /// @class RandomStream
+    ///
+    /// Counter-based pseudo random generator: the i-th value of a stream is Mix64(key + i * gamma), the key
+    /// being derived from a seed and a stream id (SplitMix64 generator). Any value can be computed from
+    /// its index, and streams sharing a seed but not their id are statistically independent: each thread
+    /// or each block of a parallel algorithm draws from its own stream, making the results reproducible
+    /// whatever the number of threads.
+    ///
+    /// Bounded values are drawn without bias nor implementation defined distributions (the std ones
+    /// differ between standard libraries), so a seed gives the same results on every platform.
+    ///
+    /// Satisfies the UniformRandomBitGenerator requirements.
+    class RandomStream
+    {
+    public:
+      typedef uint64_t result_type;
+
+      /// RandomStream constructor.
+      ///
+      /// @param seed the seed shared by all the streams of a computation.
+      /// @param streamId the id of the stream.
+      explicit RandomStream(uint64_t seed = 0, uint64_t streamId = 0) :
+        key(Mix64(seed ^ Mix64(streamId + kGamma))), counter(0) {}
+
+      static constexpr result_type min() { return 0; }
+      static constexpr result_type max() { return ~result_type(0); }
+
+      /// Return the next 64 random bits of the stream.
+      result_type operator()() { return At(this->counter++); }
+
+      /// At - Return the value of index within the stream, without moving the stream.
+      result_type At(uint64_t index) const { return Mix64(this->key + index * kGamma); }
+
+      /// Seek - Move the stream to index, the next call returning At(index).
+      void Seek(uint64_t index) { this->counter = index; }
+
+      /// Below - Return a uniform value within [0, bound).
+      /// Multiply-shift reduction with rejection (Lemire) for 32 bits bounds, modulo with rejection above.
+      ///
+      /// @warning bound must be positive.
+      ///
+      /// @param bound the exclusive upper bound.
+      ///
+      /// @return the drawn value.
+      uint64_t Below(uint64_t bound)
+      {
+        if (bound <= 0xFFFFFFFFull)
+        {
+          const uint32_t kBound = static_cast<uint32_t>(bound);
+          uint64_t product = ((*this)() >> 32) * kBound;
+          if (static_cast<uint32_t>(product) < kBound)
+          {
+            const uint32_t kThreshold = (0u - kBound) % kBound;
+            while (static_cast<uint32_t>(product) < kThreshold)
+              product = ((*this)() >> 32) * kBound;
+          }
+          return product >> 32;
+        }
+
+        const uint64_t kThreshold = (0 - bound) % bound;
+        uint64_t value = (*this)();
+        while (value < kThreshold)
+          value = (*this)();
+        return value % bound;
+      }
+
+      /// Uniform - Return a uniform double within [0, 1), with 53 random bits.
+      double Uniform() { return static_cast<double>((*this)() >> 11) * (1.0 / 9007199254740992.0); }
+
+    private:
+      enum : uint64_t { kGamma = 0x9E3779B97F4A7C15ull }; // Golden ratio increment of SplitMix64
+
+      uint64_t key;     // Start of the stream
+      uint64_t counter; // Index of the next value
+    };
+  }
+}
+
+#endif // MODULE_COMBINATORY_RANDOM_HXX
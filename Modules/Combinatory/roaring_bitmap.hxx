@@ -0,0 +1,738 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#ifndef MODULE_COMBINATORY_ROARING_BITMAP_HXX
+#define MODULE_COMBINATORY_ROARING_BITMAP_HXX
+
+#include <Combinatory/intrinsics.hxx>
+#include <Combinatory/set_operations.hxx>
+
+// STD includes
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace huc
+{
+  namespace combinatory
+  {
+    /// Operations combining two containers: Keep tells whether a value present or not in each operand
+    /// belongs to the result, Merge combines sorted arrays, Apply combines bitmap words (scalar and SIMD).
+    /// kSubsetOfFirst/Second tell whether the result is included in an operand, which can then be filtered.
+    struct RoaringAnd
+    {
+      enum : bool { kSubsetOfFirst = true, kSubsetOfSecond = true };
+      static bool Keep(bool first, bool second) { return first && second; }
+      template <typename IT, typename OutputIT>
+      static OutputIT Merge(IT beginA, IT endA, IT beginB, IT endB, OutputIT out)
+      { return std::set_intersection(beginA, endA, beginB, endB, out); }
+      static uint64_t Apply(uint64_t a, uint64_t b) { return a & b; }
+#if defined(HUC_USE_SSE2)
+      static __m128i Apply(__m128i a, __m128i b) { return _mm_and_si128(a, b); }
+#endif
+#if defined(HUC_USE_AVX2)
+      static __m256i Apply(__m256i a, __m256i b) { return _mm256_and_si256(a, b); }
+#endif
+    };
+
+    struct RoaringOr
+    {
+      enum : bool { kSubsetOfFirst = false, kSubsetOfSecond = false };
+      static bool Keep(bool first, bool second) { return first || second; }
+      template <typename IT, typename OutputIT>
+      static OutputIT Merge(IT beginA, IT endA, IT beginB, IT endB, OutputIT out)
+      { return std::set_union(beginA, endA, beginB, endB, out); }
+      static uint64_t Apply(uint64_t a, uint64_t b) { return a | b; }
+#if defined(HUC_USE_SSE2)
+      static __m128i Apply(__m128i a, __m128i b) { return _mm_or_si128(a, b); }
+#endif
+#if defined(HUC_USE_AVX2)
+      static __m256i Apply(__m256i a, __m256i b) { return _mm256_or_si256(a, b); }
+#endif
+    };
+
+    struct RoaringAndNot
+    {
+      enum : bool { kSubsetOfFirst = true, kSubsetOfSecond = false };
+      static bool Keep(bool first, bool second) { return first && !second; }
+      template <typename IT, typename OutputIT>
+      static OutputIT Merge(IT beginA, IT endA, IT beginB, IT endB, OutputIT out)
+      { return std::set_difference(beginA, endA, beginB, endB, out); }
+      static uint64_t Apply(uint64_t a, uint64_t b) { return a & ~b; }
+#if defined(HUC_USE_SSE2)
+      static __m128i Apply(__m128i a, __m128i b) { return _mm_andnot_si128(b, a); }
+#endif
+#if defined(HUC_USE_AVX2)
+      static __m256i Apply(__m256i a, __m256i b) { return _mm256_andnot_si256(b, a); }
+#endif
+    };
+
+    struct RoaringXor
+    {
+      enum : bool { kSubsetOfFirst = false, kSubsetOfSecond = false };
+      static bool Keep(bool first, bool second) { return first != second; }
+      template <typename IT, typename OutputIT>
+      static OutputIT Merge(IT beginA, IT endA, IT beginB, IT endB, OutputIT out)
+      { return std::set_symmetric_difference(beginA, endA, beginB, endB, out); }
+      static uint64_t Apply(uint64_t a, uint64_t b) { return a ^ b; }
+#if defined(HUC_USE_SSE2)
+      static __m128i Apply(__m128i a, __m128i b) { return _mm_xor_si128(a, b); }
+#endif
+#if defined(HUC_USE_AVX2)
+      static __m256i Apply(__m256i a, __m256i b) { return _mm256_xor_si256(a, b); }
+#endif
+    };
+
+    /// @class RoaringContainer
+    ///
+    /// Set of 16-bit values (the low bits of the ids of a 2^16 chunk) stored in the cheapest of:
+    /// - Array: sorted values, up to 4096 of them (2 bytes per value).
+    /// - Bitmap: 2^16 bits (8KB) beyond 4096 values.
+    /// - Run: sorted (start, length - 1) pairs, for ranges of consecutive values (cf. RunOptimize).
+    ///
+    /// Run containers are turned back into arrays or bitmaps when modified, and combined as bitmaps.
+    class RoaringContainer
+    {
+    public:
+      enum : uint32_t { kMaxArraySize = 4096, kBitmapWords = 1024 };
+      enum class Type : uint8_t { Array, Bitmap, Run };
+
+      RoaringContainer() : type(Type::Array), cardinality(0) {}
+
+      /// Contains - Whether value belongs to the container.
+      bool Contains(uint16_t value) const
+      {
+        switch (this->type)
+        {
+          case Type::Array:
+            return std::binary_search(this->values.begin(), this->values.end(), value);
+          case Type::Bitmap:
+            return (this->words[value >> 6] >> (value & 63)) & 1;
+          default:
+          {
+            // Last run starting at value or before
+            size_t low = 0, high = this->values.size() / 2;
+            while (low < high)
+            {
+              const size_t kMiddle = (low + high) / 2;
+              if (this->values[2 * kMiddle] <= value)
+                low = kMiddle + 1;
+              else
+                high = kMiddle;
+            }
+            return low > 0 && value - this->values[2 * (low - 1)] <= this->values[2 * (low - 1) + 1];
+          }
+        }
+      }
+
+      /// Add - Insert value into the container.
+      ///
+      /// @return true if the value has been inserted, false if already present.
+      bool Add(uint16_t value)
+      {
+        if (this->type == Type::Run)
+        {
+          if (Contains(value))
+            return false;
+          Decompress();
+        }
+
+        if (this->type == Type::Array)
+        {
+          auto it = std::lower_bound(this->values.begin(), this->values.end(), value);
+          if (it != this->values.end() && *it == value)
+            return false;
+          this->values.insert(it, value);
+          if (++this->cardinality > kMaxArraySize)
+            ToBitmap();
+          return true;
+        }
+
+        uint64_t& word = this->words[value >> 6];
+        const uint64_t kBit = uint64_t(1) << (value & 63);
+        if (word & kBit)
+          return false;
+        word |= kBit;
+        ++this->cardinality;
+        return true;
+      }
+
+      /// Remove - Erase value from the container.
+      ///
+      /// @return true if the value has been erased, false if absent.
+      bool Remove(uint16_t value)
+      {
+        if (!Contains(value))
+          return false;
+        if (this->type == Type::Run)
+          Decompress();
+
+        --this->cardinality;
+        if (this->type == Type::Array)
+          this->values.erase(std::lower_bound(this->values.begin(), this->values.end(), value));
+        else
+        {
+          this->words[value >> 6] &= ~(uint64_t(1) << (value & 63));
+          if (this->cardinality <= kMaxArraySize)
+            ToArray();
+        }
+        return true;
+      }
+
+      /// ForEach - Call functor(value) on each value of the container, in ascending order.
+      template <typename Functor>
+      void ForEach(Functor functor) const
+      {
+        switch (this->type)
+        {
+          case Type::Array:
+            for (auto it = this->values.begin(); it != this->values.end(); ++it)
+              functor(*it);
+            break;
+          case Type::Bitmap:
+            for (uint32_t i = 0; i < kBitmapWords; ++i)
+              for (uint64_t word = this->words[i]; word != 0; word &= word - 1)
+                functor(static_cast<uint16_t>(i * 64 + CountTrailingZeros(word)));
+            break;
+          default:
+            for (size_t i = 0; i < this->values.size(); i += 2)
+            {
+              const uint32_t kLast = uint32_t(this->values[i]) + this->values[i + 1];
+              for (uint32_t value = this->values[i]; value <= kLast; ++value)
+                functor(static_cast<uint16_t>(value));
+            }
+        }
+      }
+
+      /// FillWords - Set the bits of the values of the container within a 2^16 bits bitmap.
+      void FillWords(uint64_t* output) const
+      {
+        switch (this->type)
+        {
+          case Type::Array:
+            for (auto it = this->values.begin(); it != this->values.end(); ++it)
+              output[*it >> 6] |= uint64_t(1) << (*it & 63);
+            break;
+          case Type::Bitmap:
+            for (uint32_t i = 0; i < kBitmapWords; ++i)
+              output[i] |= this->words[i];
+            break;
+          default:
+            for (size_t i = 0; i < this->values.size(); i += 2)
+              SetBitRange(output, this->values[i], uint32_t(this->values[i]) + this->values[i + 1]);
+        }
+      }
+
+      /// SetBitRange - Set the bits of [first, last] within a 2^16 bits bitmap.
+      static void SetBitRange(uint64_t* words, uint32_t first, uint32_t last)
+      {
+        for (uint32_t word = first >> 6; word <= (last >> 6); ++word)
+        {
+          const uint32_t kLow = (word == (first >> 6)) ? (first & 63) : 0;
+          const uint32_t kHigh = (word == (last >> 6)) ? (last & 63) : 63;
+          words[word] |= (~uint64_t(0) >> (63 - kHigh)) & (~uint64_t(0) << kLow);
+        }
+      }
+
+      /// RunOptimize - Switch to runs if they are smaller than the current representation, and back.
+      void RunOptimize()
+      {
+        if (this->type == Type::Run)
+          Decompress();
+
+        // Count the runs: values not preceded by their predecessor
+        uint32_t runCount = 0;
+        if (this->type == Type::Array)
+        {
+          for (size_t i = 0; i < this->values.size(); ++i)
+            runCount += (i == 0 || this->values[i] != this->values[i - 1] + 1) ? 1 : 0;
+        }
+        else
+        {
+          uint64_t carry = 0;
+          for (uint32_t i = 0; i < kBitmapWords; ++i)
+          {
+            runCount += PopCount(this->words[i] & ~((this->words[i] << 1) | carry));
+            carry = this->words[i] >> 63;
+          }
+        }
+
+        if (4 * static_cast<size_t>(runCount) >= SizeInBytes())
+          return;
+
+        std::vector<uint16_t> runs;
+        runs.reserve(2 * runCount);
+        ForEach([&runs](uint16_t value)
+        {
+          if (!runs.empty() && uint32_t(runs[runs.size() - 2]) + runs.back() + 1 == value)
+            ++runs.back();
+          else
+          {
+            runs.push_back(value);
+            runs.push_back(0);
+          }
+        });
+
+        this->values.swap(runs);
+        std::vector<uint64_t>().swap(this->words);
+        this->type = Type::Run;
+      }
+
+      /// Return the number of bytes used by the values.
+      size_t SizeInBytes() const
+      {
+        return (this->type == Type::Bitmap) ? kBitmapWords * sizeof(uint64_t)
+                                            : this->values.size() * sizeof(uint16_t);
+      }
+
+      uint32_t Cardinality() const { return this->cardinality; }
+      Type GetType() const { return this->type; }
+
+      /// FromWords - Build the container of a 2^16 bits bitmap, as an array or as a bitmap.
+      static RoaringContainer FromWords(const uint64_t* words, uint32_t cardinality)
+      {
+        RoaringContainer container;
+        container.cardinality = cardinality;
+        if (cardinality > kMaxArraySize)
+        {
+          container.type = Type::Bitmap;
+          container.words.assign(words, words + kBitmapWords);
+          return container;
+        }
+
+        container.values.reserve(cardinality);
+        for (uint32_t i = 0; i < kBitmapWords; ++i)
+          for (uint64_t word = words[i]; word != 0; word &= word - 1)
+            container.values.push_back(static_cast<uint16_t>(i * 64 + CountTrailingZeros(word)));
+        return container;
+      }
+
+      /// Combine - Return the container resulting of an operation (RoaringAnd, Or, AndNot, Xor).
+      /// Arrays are merged, an array included in the result is filtered through the other operand and
+      /// other operands are combined as bitmaps, 128 or 256 bits at once.
+      template <typename Operation>
+      static RoaringContainer Combine(const RoaringContainer& a, const RoaringContainer& b)
+      {
+        RoaringContainer result;
+        if (a.type == Type::Array && b.type == Type::Array)
+        {
+          Operation::Merge(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(),
+                           std::back_inserter(result.values));
+          result.cardinality = static_cast<uint32_t>(result.values.size());
+          if (result.cardinality > kMaxArraySize)
+            result.ToBitmap();
+          return result;
+        }
+
+        const RoaringContainer* filtered = FilteredOperand<Operation>(a, b);
+        if (filtered)
+        {
+          const bool kIsFirst = (filtered == &a);
+          const RoaringContainer& kOther = kIsFirst ? b : a;
+          for (auto it = filtered->values.begin(); it != filtered->values.end(); ++it)
+            if (kIsFirst ? Operation::Keep(true, kOther.Contains(*it))
+                         : Operation::Keep(kOther.Contains(*it), true))
+              result.values.push_back(*it);
+          result.cardinality = static_cast<uint32_t>(result.values.size());
+          return result;
+        }
+
+        uint64_t bufferA[kBitmapWords], bufferB[kBitmapWords], output[kBitmapWords];
+        const uint32_t kCardinality = ApplyWords<Operation, true>(a.Words(bufferA), b.Words(bufferB), output);
+        return FromWords(output, kCardinality);
+      }
+
+      /// CombineCardinality - Return the cardinality of the result of an operation, without building it.
+      template <typename Operation>
+      static uint32_t CombineCardinality(const RoaringContainer& a, const RoaringContainer& b)
+      {
+        if (a.type == Type::Array && b.type == Type::Array)
+          return static_cast<uint32_t>(Operation::Merge(a.values.begin(), a.values.end(), b.values.begin(),
+                                                        b.values.end(), CountingIterator()).Count());
+
+        const RoaringContainer* filtered = FilteredOperand<Operation>(a, b);
+        if (filtered)
+        {
+          const bool kIsFirst = (filtered == &a);
+          const RoaringContainer& kOther = kIsFirst ? b : a;
+          uint32_t count = 0;
+          for (auto it = filtered->values.begin(); it != filtered->values.end(); ++it)
+            count += (kIsFirst ? Operation::Keep(true, kOther.Contains(*it))
+                               : Operation::Keep(kOther.Contains(*it), true)) ? 1 : 0;
+          return count;
+        }
+
+        uint64_t bufferA[kBitmapWords], bufferB[kBitmapWords];
+        return ApplyWords<Operation, false>(a.Words(bufferA), b.Words(bufferB), nullptr);
+      }
+
+    private:
+      Type type;                    // Representation of the values
+      uint32_t cardinality;         // Number of values
+      std::vector<uint16_t> values; // Array: sorted values - Run: (start, length - 1) pairs
+      std::vector<uint64_t> words;  // Bitmap: 2^16 bits
+
+      /// Return the array operand included in the result of the operation, null if none.
+      template <typename Operation>
+      static const RoaringContainer* FilteredOperand(const RoaringContainer& a, const RoaringContainer& b)
+      {
+        if (Operation::kSubsetOfFirst && a.type == Type::Array)
+          return &a;
+        if (Operation::kSubsetOfSecond && b.type == Type::Array)
+          return &b;
+        return nullptr;
+      }
+
+      /// Return the words of the bitmap, filling buffer for other representations.
+      const uint64_t* Words(uint64_t* buffer) const
+      {
+        if (this->type == Type::Bitmap)
+          return this->words.data();
+
+        std::fill(buffer, buffer + kBitmapWords, 0);
+        FillWords(buffer);
+        return buffer;
+      }
+
+      /// Combine two bitmaps word by word into output (if kStore) and return the result cardinality.
+      template <typename Operation, bool kStore>
+      static uint32_t ApplyWords(const uint64_t* a, const uint64_t* b, uint64_t* output)
+      {
+        uint32_t cardinality = 0;
+        uint32_t i = 0;
+#if defined(HUC_USE_AVX2)
+        for (; i + 4 <= kBitmapWords; i += 4)
+        {
+          alignas(32) uint64_t result[4];
+          _mm256_store_si256(reinterpret_cast<__m256i*>(result), Operation::Apply(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)),
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i))));
+          for (uint32_t k = 0; k < 4; ++k)
+          {
+            cardinality += PopCount(result[k]);
+            if (kStore)
+              output[i + k] = result[k];
+          }
+        }
+#elif defined(HUC_USE_SSE2)
+        for (; i + 2 <= kBitmapWords; i += 2)
+        {
+          alignas(16) uint64_t result[2];
+          _mm_store_si128(reinterpret_cast<__m128i*>(result), Operation::Apply(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)),
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i))));
+          cardinality += PopCount(result[0]) + PopCount(result[1]);
+          if (kStore)
+          {
+            output[i] = result[0];
+            output[i + 1] = result[1];
+          }
+        }
+#endif
+        for (; i < kBitmapWords; ++i)
+        {
+          const uint64_t kResult = Operation::Apply(a[i], b[i]);
+          cardinality += PopCount(kResult);
+          if (kStore)
+            output[i] = kResult;
+        }
+        return cardinality;
+      }
+
+      void ToBitmap()
+      {
+        std::vector<uint64_t> bitmap(kBitmapWords, 0);
+        FillWords(bitmap.data());
+        this->words.swap(bitmap);
+        std::vector<uint16_t>().swap(this->values);
+        this->type = Type::Bitmap;
+      }
+
+      void ToArray()
+      {
+        *this = FromWords(this->words.data(), this->cardinality);
+      }
+
+      /// Turn runs into an array or a bitmap.
+      void Decompress()
+      {
+        uint64_t buffer[kBitmapWords];
+        *this = FromWords(Words(buffer), this->cardinality);
+      }
+    };
+
+    /// @class RoaringBitmap
+    ///
+    /// Compressed set of 32-bit ids (Roaring bitmap): ids are split by their 16 high bits into chunks,
+    /// each one stored in a RoaringContainer (sorted array, bitmap or runs) according to its density.
+    ///
+    /// @advantages
+    /// - 2 bytes per id at worst for sparse chunks, 1 bit per id for dense ones, a few bytes per range.
+    /// - Set operations work chunk per chunk: merges of small arrays, SIMD operations over bitmaps.
+    /// - Cardinality-only operations never build the result.
+    ///
+    /// @drawbacks
+    /// - Random insertions into arrays move up to 4096 values.
+    /// - Runs are only produced by AddRange and RunOptimize.
+    class RoaringBitmap
+    {
+    public:
+      RoaringBitmap() {}
+
+      /// RoaringBitmap constructor - Insert each id of [begin, end[, sorted or not.
+      template <typename IT>
+      RoaringBitmap(const IT& begin, const IT& end)
+      {
+        for (auto it = begin; it != end; ++it)
+          Add(static_cast<uint32_t>(*it));
+      }
+
+      /// Add - Insert an id.
+      ///
+      /// @return true if the id has been inserted, false if already present.
+      bool Add(uint32_t id)
+      { return GetContainer(static_cast<uint16_t>(id >> 16)).Add(static_cast<uint16_t>(id)); }
+
+      /// AddRange - Insert each id of [first, last], full ranges being stored as runs.
+      void AddRange(uint32_t first, uint32_t last)
+      {
+        for (uint64_t chunkStart = first; chunkStart <= last; chunkStart = ((chunkStart >> 16) + 1) << 16)
+        {
+          const uint32_t kLow = static_cast<uint32_t>(chunkStart & 0xFFFF);
+          const uint32_t kHigh = (uint64_t(last) >> 16 == chunkStart >> 16) ? (last & 0xFFFF) : 0xFFFF;
+
+          uint64_t words[RoaringContainer::kBitmapWords] = {0};
+          RoaringContainer& container = GetContainer(static_cast<uint16_t>(chunkStart >> 16));
+          container.FillWords(words);
+          RoaringContainer::SetBitRange(words, kLow, kHigh);
+          uint32_t cardinality = 0;
+          for (uint32_t i = 0; i < RoaringContainer::kBitmapWords; ++i)
+            cardinality += PopCount(words[i]);
+
+          container = RoaringContainer::FromWords(words, cardinality);
+          container.RunOptimize();
+        }
+      }
+
+      /// Remove - Erase an id.
+      ///
+      /// @return true if the id has been erased, false if absent.
+      bool Remove(uint32_t id)
+      {
+        const size_t kIndex = FindChunk(static_cast<uint16_t>(id >> 16));
+        if (kIndex == this->keys.size() || !this->containers[kIndex].Remove(static_cast<uint16_t>(id)))
+          return false;
+
+        if (this->containers[kIndex].Cardinality() == 0)
+        {
+          this->keys.erase(this->keys.begin() + static_cast<std::ptrdiff_t>(kIndex));
+          this->containers.erase(this->containers.begin() + static_cast<std::ptrdiff_t>(kIndex));
+        }
+        return true;
+      }
+
+      /// Contains - Whether an id belongs to the set.
+      bool Contains(uint32_t id) const
+      {
+        const size_t kIndex = FindChunk(static_cast<uint16_t>(id >> 16));
+        return kIndex < this->keys.size() && this->containers[kIndex].Contains(static_cast<uint16_t>(id));
+      }
+
+      /// Cardinality - Return the number of ids.
+      uint64_t Cardinality() const
+      {
+        uint64_t cardinality = 0;
+        for (auto it = this->containers.begin(); it != this->containers.end(); ++it)
+          cardinality += it->Cardinality();
+        return cardinality;
+      }
+
+      bool IsEmpty() const { return this->keys.empty(); }
+
+      /// RunOptimize - Store as runs the chunks where it saves memory.
+      void RunOptimize()
+      {
+        for (auto it = this->containers.begin(); it != this->containers.end(); ++it)
+          it->RunOptimize();
+      }
+
+      /// Return the number of bytes used by the chunks.
+      size_t SizeInBytes() const
+      {
+        size_t size = this->keys.size() * (sizeof(uint16_t) + sizeof(RoaringContainer));
+        for (auto it = this->containers.begin(); it != this->containers.end(); ++it)
+          size += it->SizeInBytes();
+        return size;
+      }
+
+      /// ForEach - Call functor(id) on each id, in ascending order.
+      template <typename Functor>
+      void ForEach(Functor functor) const
+      {
+        for (size_t i = 0; i < this->keys.size(); ++i)
+        {
+          const uint32_t kHigh = uint32_t(this->keys[i]) << 16;
+          this->containers[i].ForEach([&functor, kHigh](uint16_t low) { functor(kHigh | low); });
+        }
+      }
+
+      /// ToVector - Return the sorted ids.
+      std::vector<uint32_t> ToVector() const
+      {
+        std::vector<uint32_t> ids;
+        ids.reserve(static_cast<size_t>(Cardinality()));
+        ForEach([&ids](uint32_t id) { ids.push_back(id); });
+        return ids;
+      }
+
+      size_t ChunkCount() const { return this->keys.size(); }
+      const RoaringContainer& Chunk(size_t index) const { return this->containers[index]; }
+
+      bool operator==(const RoaringBitmap& other) const
+      { return this->keys == other.keys && XorCardinality(*this, other) == 0; }
+      bool operator!=(const RoaringBitmap& other) const { return !(*this == other); }
+
+      /// And, Or, AndNot, Xor - Return the intersection, union, difference or symmetric difference of a and b.
+      static RoaringBitmap And(const RoaringBitmap& a, const RoaringBitmap& b)
+      { return Combine<RoaringAnd>(a, b); }
+      static RoaringBitmap Or(const RoaringBitmap& a, const RoaringBitmap& b)
+      { return Combine<RoaringOr>(a, b); }
+      static RoaringBitmap AndNot(const RoaringBitmap& a, const RoaringBitmap& b)
+      { return Combine<RoaringAndNot>(a, b); }
+      static RoaringBitmap Xor(const RoaringBitmap& a, const RoaringBitmap& b)
+      { return Combine<RoaringXor>(a, b); }
+
+      /// And, Or, AndNot, XorCardinality - Return the cardinality of an operation without building it.
+
+      static uint64_t AndCardinality(const RoaringBitmap& a, const RoaringBitmap& b)
+      { return CombineCardinality<RoaringAnd>(a, b); }
+      static uint64_t OrCardinality(const RoaringBitmap& a, const RoaringBitmap& b)
+      { return CombineCardinality<RoaringOr>(a, b); }
+      static uint64_t AndNotCardinality(const RoaringBitmap& a, const RoaringBitmap& b)
+      { return CombineCardinality<RoaringAndNot>(a, b); }
+      static uint64_t XorCardinality(const RoaringBitmap& a, const RoaringBitmap& b)
+      { return CombineCardinality<RoaringXor>(a, b); }
+
+    private:
+      std::vector<uint16_t> keys;                // Sorted 16 high bits of the chunks
+      std::vector<RoaringContainer> containers;  // Low bits of the ids of each chunk
+
+      size_t FindChunk(uint16_t key) const
+      {
+        auto it = std::lower_bound(this->keys.begin(), this->keys.end(), key);
+        return (it != this->keys.end() && *it == key) ? static_cast<size_t>(it - this->keys.begin())
+                                                      : this->keys.size();
+      }
+
+      /// Return the container of a chunk, created if missing.
+      RoaringContainer& GetContainer(uint16_t key)
+      {
+        // Ids are often inserted in order: check the last chunk first
+        if (!this->keys.empty() && this->keys.back() == key)
+          return this->containers.back();
+
+        auto it = std::lower_bound(this->keys.begin(), this->keys.end(), key);
+        const auto kIndex = it - this->keys.begin();
+        if (it == this->keys.end() || *it != key)
+        {
+          this->keys.insert(it, key);
+          this->containers.insert(this->containers.begin() + kIndex, RoaringContainer());
+        }
+        return this->containers[static_cast<size_t>(kIndex)];
+      }
+
+      /// Combine both bitmaps chunk by chunk, chunks of a single operand being kept as is if relevant.
+      template <typename Operation>
+      static RoaringBitmap Combine(const RoaringBitmap& a, const RoaringBitmap& b)
+      {
+        RoaringBitmap result;
+        size_t i = 0, j = 0;
+        while (i < a.keys.size() || j < b.keys.size())
+        {
+          if (j == b.keys.size() || (i < a.keys.size() && a.keys[i] < b.keys[j]))
+          {
+            if (Operation::Keep(true, false))
+              result.Append(a.keys[i], a.containers[i]);
+            ++i;
+          }
+          else if (i == a.keys.size() || b.keys[j] < a.keys[i])
+          {
+            if (Operation::Keep(false, true))
+              result.Append(b.keys[j], b.containers[j]);
+            ++j;
+          }
+          else
+          {
+            RoaringContainer container =
+              RoaringContainer::Combine<Operation>(a.containers[i], b.containers[j]);
+            if (container.Cardinality() > 0)
+              result.Append(a.keys[i], std::move(container));
+            ++i;
+            ++j;
+          }
+        }
+        return result;
+      }
+
+      template <typename Operation>
+      static uint64_t CombineCardinality(const RoaringBitmap& a, const RoaringBitmap& b)
+      {
+        uint64_t cardinality = 0;
+        size_t i = 0, j = 0;
+        while (i < a.keys.size() || j < b.keys.size())
+        {
+          if (j == b.keys.size() || (i < a.keys.size() && a.keys[i] < b.keys[j]))
+          {
+            if (Operation::Keep(true, false))
+              cardinality += a.containers[i].Cardinality();
+            ++i;
+          }
+          else if (i == a.keys.size() || b.keys[j] < a.keys[i])
+          {
+            if (Operation::Keep(false, true))
+              cardinality += b.containers[j].Cardinality();
+            ++j;
+          }
+          else
+            cardinality += RoaringContainer::CombineCardinality<Operation>(a.containers[i++], b.containers[j++]);
+        }
+        return cardinality;
+      }
+
+      void Append(uint16_t key, RoaringContainer container)
+      {
+        this->keys.push_back(key);
+        this->containers.push_back(std::move(container));
+      }
+    };
+
+    /// Intersection - Return the intersection of two id sets stored as Roaring bitmaps.
+    /// Unlike the sequence based Intersection, ids are unique and sorted within the result.
+    ///
+    /// @param first,second the id sets.
+    ///
+    /// @return the ids of both sets.
+    inline RoaringBitmap Intersection(const RoaringBitmap& first, const RoaringBitmap& second)
+    { return RoaringBitmap::And(first, second); }
+  }
+}
+
+#endif // MODULE_COMBINATORY_ROARING_BITMAP_HXX
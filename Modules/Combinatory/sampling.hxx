@@ -0,0 +1,373 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#ifndef MODULE_COMBINATORY_SAMPLING_HXX
+#define MODULE_COMBINATORY_SAMPLING_HXX
+
+#include <Combinatory/random.hxx>
+#include <DataStructures/flat_hash_counter.hxx>
+
+// STD includes
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace huc
+{
+  namespace combinatory
+  {
+    /// SampleIndices - Floyd's algorithm: draw k distinct indices uniformly among [0, n).
+    /// Each of the k steps draws a single value and checks it against a flat hash set.
+    ///
+    /// @warning the subset is uniform, not the order of the indices within the result.
+    ///
+    /// @param n the number of indices to choose from.
+    /// @param k the number of indices to be drawn, clamped to n.
+    /// @param random the random stream.
+    ///
+    /// @complexity O(k) expected time and memory.
+    ///
+    /// @return the k distinct indices.
+    inline std::vector<uint64_t> SampleIndices(uint64_t n, uint64_t k, RandomStream& random)
+    {
+      k = std::min(k, n);
+      std::vector<uint64_t> indices;
+      indices.reserve(static_cast<size_t>(k));
+      FlatHashCounter<uint64_t> drawn(static_cast<size_t>(k));
+      for (uint64_t j = n - k; j < n; ++j)
+      {
+        const uint64_t kIndex = random.Below(j + 1);
+        const uint64_t kChosen = (drawn.Count(kIndex) > 0) ? j : kIndex;
+        drawn.Add(kChosen);
+        indices.push_back(kChosen);
+      }
+
+      return indices;
+    }
+
+    /// @class ReservoirSampler
+    ///
+    /// Uniform sample of k elements out of a stream of unknown length (Algorithm L by Li).
+    /// Each element of the reservoir holds a uniform random key and the reservoir keeps the k smallest
+    /// keys seen. Once full, the number of elements to be rejected before the next entry follows a
+    /// geometric law of the largest key: it is drawn at once, so only O(k (1 + log(n / k))) random values
+    /// are drawn over n elements, and callers can fast-forward through the skipped elements (SkipCount).
+    ///
+    /// Keeping the keys makes the reservoirs mergeable: shards of a stream are sampled independently and
+    /// merging keeps the k smallest keys of both, which is a uniform sample of the whole stream.
+    ///
+    /// @tparam T type of the sampled values, only copied (never compared).
+    template <typename T>
+    class ReservoirSampler
+    {
+    public:
+      /// ReservoirSampler constructor.
+      ///
+      /// @param k the size of the sample.
+      /// @param random the random stream, use distinct streams for the shards of a same stream.
+      ReservoirSampler(size_t k, const RandomStream& random) : k(k), random(random), seen(0), skip(0)
+      { this->reservoir.reserve(k); }
+
+      /// Add - Offer the next element of the stream.
+      ///
+      /// @param value the element.
+      ///
+      /// @return void.
+      void Add(const T& value)
+      {
+        ++this->seen;
+        if (this->k == 0)
+          return;
+
+        if (this->reservoir.size() < this->k)
+        {
+          Insert(this->random.Uniform(), value);
+          return;
+        }
+
+        if (this->skip > 0)
+        {
+          --this->skip;
+          return;
+        }
+
+        // Enter with a key uniform below the largest key, which leaves the reservoir
+        const double kKey = this->random.Uniform() * this->reservoir.front().first;
+        std::pop_heap(this->reservoir.begin(), this->reservoir.end(), Less());
+        this->reservoir.pop_back();
+        Insert(kKey, value);
+      }
+
+      /// SkipCount - Return the number of coming elements that will be rejected: they can be accounted
+      /// for by Skip without being read.
+      uint64_t SkipCount() const { return (this->reservoir.size() < this->k) ? 0 : this->skip; }
+
+      /// Skip - Account for count rejected elements, count being at most SkipCount().
+      void Skip(uint64_t count)
+      {
+        this->seen += count;
+        this->skip -= count;
+      }
+
+      /// Merge - Merge the sample of another shard of the stream (same k): the result samples both.
+      ///
+      /// @param other the sampler of the other shard.
+      ///
+      /// @return void.
+      void Merge(const ReservoirSampler& other)
+      {
+        this->seen += other.seen;
+        for (auto it = other.reservoir.begin(); it != other.reservoir.end(); ++it)
+        {
+          if (this->reservoir.size() < this->k)
+            this->reservoir.push_back(*it);
+          else if (it->first < this->reservoir.front().first)
+          {
+            std::pop_heap(this->reservoir.begin(), this->reservoir.end(), Less());
+            this->reservoir.back() = *it;
+          }
+          else
+            continue;
+          std::push_heap(this->reservoir.begin(), this->reservoir.end(), Less());
+        }
+
+        if (this->reservoir.size() == this->k)
+          DrawSkip();
+      }
+
+      /// Sample - Return the values of the reservoir, min(k, seen) of them.
+      std::vector<T> Sample() const
+      {
+        std::vector<T> values;
+        values.reserve(this->reservoir.size());
+        for (auto it = this->reservoir.begin(); it != this->reservoir.end(); ++it)
+          values.push_back(it->second);
+        return values;
+      }
+
+      uint64_t Seen() const { return this->seen; }
+
+    private:
+      typedef std::pair<double, T> Item;
+
+      /// Order of the max heap on the keys only: the values need no ordering.
+      struct Less
+      {
+        bool operator()(const Item& lhs, const Item& rhs) const { return lhs.first < rhs.first; }
+      };
+
+      size_t k;                    // Size of the sample
+      RandomStream random;         // Random stream of the sampler
+      std::vector<Item> reservoir; // Max heap of the (key, value) kept
+      uint64_t seen;               // Number of elements seen
+      uint64_t skip;               // Number of elements to reject before the next entry
+
+      void Insert(double key, const T& value)
+      {
+        this->reservoir.push_back(std::make_pair(key, value));
+        std::push_heap(this->reservoir.begin(), this->reservoir.end(), Less());
+        if (this->reservoir.size() == this->k)
+          DrawSkip();
+      }
+
+      /// Each element enters with probability W (largest key): the number of rejections is geometric.
+      void DrawSkip()
+      {
+        const double kLargestKey = this->reservoir.front().first;
+        const double kSkip =
+          std::floor(std::log(1. - this->random.Uniform()) / std::log1p(-kLargestKey));
+        this->skip = (kLargestKey <= 0. || !(kSkip < 1.8e19)) ?
+          std::numeric_limits<uint64_t>::max() : static_cast<uint64_t>(kSkip);
+      }
+    };
+
+    /// AdvanceAtMost - Advance it by count positions without going past end.
+    ///
+    /// @return the number of positions advanced.
+    template <typename IT>
+    uint64_t AdvanceAtMost(IT& it, const IT& end, uint64_t count, std::random_access_iterator_tag)
+    {
+      const uint64_t kAdvance = std::min(count, static_cast<uint64_t>(std::distance(it, end)));
+      it += static_cast<typename std::iterator_traits<IT>::difference_type>(kAdvance);
+      return kAdvance;
+    }
+
+    template <typename IT>
+    uint64_t AdvanceAtMost(IT& it, const IT& end, uint64_t count, std::input_iterator_tag)
+    {
+      uint64_t advance = 0;
+      for (; advance < count && it != end; ++advance)
+        ++it;
+      return advance;
+    }
+
+    /// ReservoirSample - Draw a uniform sample of k elements from [begin, end[ in a single pass.
+    /// Rejected elements are skipped without being read, by a single jump for random access iterators.
+    ///
+    /// @tparam IT type using to go through the collection.
+    ///
+    /// @param begin,end iterators to the initial and final positions of the sequence.
+    /// @param k the size of the sample.
+    /// @param random the random stream.
+    ///
+    /// @return the sampled values, min(k, n) of them.
+    template <typename IT>
+    std::vector<typename std::iterator_traits<IT>::value_type>
+    ReservoirSample(IT begin, const IT& end, size_t k, const RandomStream& random)
+    {
+      ReservoirSampler<typename std::iterator_traits<IT>::value_type> sampler(k, random);
+      while (begin != end)
+      {
+        sampler.Add(*begin);
+        ++begin;
+
+        const uint64_t kSkipped = AdvanceAtMost(begin, end, sampler.SkipCount(),
+                                                typename std::iterator_traits<IT>::iterator_category());
+        sampler.Skip(kSkipped);
+      }
+
+      return sampler.Sample();
+    }
+
+    /// @class WeightedReservoirSampler
+    ///
+    /// Weighted sample without replacement of k elements out of a stream (A-ExpJ by Efraimidis and
+    /// Spirakis): each element holds the key u^(1/w) and the reservoir keeps the k largest keys. Once full,
+    /// the weight to be skipped before the next entry is drawn at once: only O(k log(n / k)) random values
+    /// are drawn. Keys are kept as log(u) / w to avoid underflows with large weights.
+    ///
+    /// As for ReservoirSampler, samplers of the shards of a stream can be merged.
+    ///
+    /// @tparam T type of the sampled values.
+    template <typename T>
+    class WeightedReservoirSampler
+    {
+    public:
+      /// WeightedReservoirSampler constructor.
+      ///
+      /// @param k the size of the sample.
+      /// @param random the random stream, use distinct streams for the shards of a same stream.
+      WeightedReservoirSampler(size_t k, const RandomStream& random) : k(k), random(random), skipWeight(0)
+      { this->reservoir.reserve(k); }
+
+      /// Add - Offer the next element of the stream.
+      ///
+      /// @param value the element.
+      /// @param weight the positive weight of the element, elements of null weight are never sampled.
+      ///
+      /// @return void.
+      void Add(const T& value, double weight)
+      {
+        if (this->k == 0 || !(weight > 0.))
+          return;
+
+        if (this->reservoir.size() < this->k)
+        {
+          Insert(std::log(RandomOpenUniform()) / weight, value);
+          return;
+        }
+
+        this->skipWeight -= weight;
+        if (this->skipWeight > 0.)
+          return;
+
+        // Enter with a key drawn within (smallest key, 1]: t = T^w, r = U(t, 1), key = r^(1/w)
+        const double kThreshold = std::exp(weight * this->reservoir.front().first);
+        const double kKey = kThreshold + (1. - kThreshold) * RandomOpenUniform();
+        std::pop_heap(this->reservoir.begin(), this->reservoir.end(), Greater());
+        this->reservoir.pop_back();
+        Insert(std::log(kKey) / weight, value);
+      }
+
+      /// Merge - Merge the sample of another shard of the stream (same k): the result samples both.
+      ///
+      /// @param other the sampler of the other shard.
+      ///
+      /// @return void.
+      void Merge(const WeightedReservoirSampler& other)
+      {
+        for (auto it = other.reservoir.begin(); it != other.reservoir.end(); ++it)
+        {
+          if (this->reservoir.size() < this->k)
+            this->reservoir.push_back(*it);
+          else if (it->first > this->reservoir.front().first)
+          {
+            std::pop_heap(this->reservoir.begin(), this->reservoir.end(), Greater());
+            this->reservoir.back() = *it;
+          }
+          else
+            continue;
+          std::push_heap(this->reservoir.begin(), this->reservoir.end(), Greater());
+        }
+
+        if (this->reservoir.size() == this->k)
+          DrawSkip();
+      }
+
+      /// Sample - Return the values of the reservoir.
+      std::vector<T> Sample() const
+      {
+        std::vector<T> values;
+        values.reserve(this->reservoir.size());
+        for (auto it = this->reservoir.begin(); it != this->reservoir.end(); ++it)
+          values.push_back(it->second);
+        return values;
+      }
+
+    private:
+      typedef std::pair<double, T> Item;
+
+      /// Order of the min heap on the keys.
+      struct Greater
+      {
+        bool operator()(const Item& lhs, const Item& rhs) const { return lhs.first > rhs.first; }
+      };
+
+      size_t k;                    // Size of the sample
+      RandomStream random;         // Random stream of the sampler
+      std::vector<Item> reservoir; // Min heap of the (log key, value) kept
+      double skipWeight;           // Weight to be skipped before the next entry
+
+      /// Uniform value within (0, 1], whose log is finite.
+      double RandomOpenUniform() { return 1. - this->random.Uniform(); }
+
+      void Insert(double logKey, const T& value)
+      {
+        this->reservoir.push_back(std::make_pair(logKey, value));
+        std::push_heap(this->reservoir.begin(), this->reservoir.end(), Greater());
+        if (this->reservoir.size() == this->k)
+          DrawSkip();
+      }
+
+      /// Skip an exponential jump of weight: X = log(U) / log(T), T being the smallest key.
+      void DrawSkip()
+      {
+        const double kLogSmallest = this->reservoir.front().first;
+        this->skipWeight = (kLogSmallest < 0.) ? std::log(RandomOpenUniform()) / kLogSmallest
+                                               : std::numeric_limits<double>::infinity();
+      }
+    };
+  }
+}
+
+#endif // MODULE_COMBINATORY_SAMPLING_HXX
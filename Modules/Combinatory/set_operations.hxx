@@ -0,0 +1,245 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#ifndef MODULE_COMBINATORY_SET_OPERATIONS_HXX
+#define MODULE_COMBINATORY_SET_OPERATIONS_HXX
+
+#include <Combinatory/intersection.hxx>
+
+// STD includes
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <queue>
+#include <utility>
+#include <vector>
+
+namespace huc
+{
+  namespace combinatory
+  {
+    /// CountingIterator - Output iterator only counting the number of elements written through it.
+    /// Used to retrieve the size of a result without materializing it.
+    class CountingIterator
+    {
+    public:
+      typedef std::output_iterator_tag iterator_category;
+      typedef void value_type;
+      typedef void difference_type;
+      typedef void pointer;
+      typedef void reference;
+
+      CountingIterator() : count(0) {}
+
+      template <typename T>
+      CountingIterator& operator=(const T&) { ++this->count; return *this; }
+      CountingIterator& operator*() { return *this; }
+      CountingIterator& operator++() { return *this; }
+      CountingIterator& operator++(int) { return *this; }
+
+      size_t Count() const { return this->count; }
+
+    private:
+      size_t count;
+    };
+
+    /// IntersectAll - Intersection of k sorted sequences (e.g. posting lists).
+    ///
+    /// Sequences are sorted by size: each element of the smallest one is searched by galloping through the
+    /// others, from the second smallest to the largest. On a mismatch, the smallest sequence gallops to
+    /// the value found, so that no intermediate intersection is ever materialized.
+    ///
+    /// @remark Retrieve the intersection keeping dupplicate keys distinct (as Intersection).
+    ///
+    /// @tparam IT type using to go through the collections.
+    /// @tparam OutputIT type of the iterator receiving the intersection.
+    ///
+    /// @param ranges [begin, end) iterators of each sorted sequence.
+    /// @param out output iterator to the initial position of the destination.
+    ///
+    /// @complexity O(k.m.log(n/m)), m being the size of the smallest sequence and n the largest one.
+    ///
+    /// @return output iterator to the element past the last written element.
+    template <typename IT, typename OutputIT>
+    OutputIT IntersectAll(const std::vector<std::pair<IT, IT>>& ranges, OutputIT out)
+    {
+      if (ranges.empty())
+        return out;
+
+      // Process the sequences from the smallest to the largest
+      std::vector<std::pair<IT, IT>> cursors(ranges);
+      std::sort(cursors.begin(), cursors.end(), [](const std::pair<IT, IT>& a, const std::pair<IT, IT>& b)
+        { return std::distance(a.first, a.second) < std::distance(b.first, b.second); });
+
+      auto& smallest = cursors.front();
+      while (smallest.first != smallest.second)
+      {
+        const auto value = *smallest.first;
+        bool isMatching = true;
+
+        for (auto it = cursors.begin() + 1; it != cursors.end(); ++it)
+        {
+          it->first = GallopLowerBound(it->first, it->second, value);
+          if (it->first == it->second)
+            return out;
+
+          // Mismatch - Skip all the smallest elements lower than the value found
+          if (value < *it->first)
+          {
+            smallest.first = GallopLowerBound(smallest.first, smallest.second, *it->first);
+            isMatching = false;
+            break;
+          }
+        }
+
+        if (isMatching)
+        {
+          *out++ = value;
+          for (auto it = cursors.begin(); it != cursors.end(); ++it)
+            ++it->first;
+        }
+      }
+
+      return out;
+    }
+
+    /// UnionAll - Union of k sorted sequences, merged through a binary heap of the sequence heads.
+    ///
+    /// @remark A key repeated within the sequences is written as many times as its highest count in a
+    /// single sequence, the output is sorted.
+    ///
+    /// @tparam IT type using to go through the collections.
+    /// @tparam OutputIT type of the iterator receiving the union.
+    ///
+    /// @param ranges [begin, end) iterators of each sorted sequence.
+    /// @param out output iterator to the initial position of the destination.
+    ///
+    /// @complexity O(n.log(k)), n being the total size of the sequences.
+    ///
+    /// @return output iterator to the element past the last written element.
+    template <typename IT, typename OutputIT>
+    OutputIT UnionAll(const std::vector<std::pair<IT, IT>>& ranges, OutputIT out)
+    {
+      typedef typename std::iterator_traits<IT>::value_type Value;
+      typedef std::pair<Value, size_t> Head; // Current value of a sequence and its index
+
+      std::vector<std::pair<IT, IT>> cursors(ranges);
+      auto lGreater = [](const Head& a, const Head& b) { return b.first < a.first; };
+      std::priority_queue<Head, std::vector<Head>, decltype(lGreater)> heads(lGreater);
+      for (size_t i = 0; i < cursors.size(); ++i)
+        if (cursors[i].first != cursors[i].second)
+          heads.push(Head(*cursors[i].first, i));
+
+      while (!heads.empty())
+      {
+        // Consume the run of the smallest value within each sequence where it is the head
+        const Value value = heads.top().first;
+        size_t maxRun = 0;
+        while (!heads.empty() && !(value < heads.top().first))
+        {
+          auto& cursor = cursors[heads.top().second];
+          const size_t kIdx = heads.top().second;
+          heads.pop();
+
+          size_t run = 0;
+          for (; cursor.first != cursor.second && !(value < *cursor.first); ++cursor.first)
+            ++run;
+          maxRun = std::max(maxRun, run);
+
+          if (cursor.first != cursor.second)
+            heads.push(Head(*cursor.first, kIdx));
+        }
+
+        for (size_t i = 0; i < maxRun; ++i)
+          *out++ = value;
+      }
+
+      return out;
+    }
+
+    /// Difference - Elements of a sorted sequence that are not within any of the other sorted sequences.
+    ///
+    /// @remark A key repeated within the first sequence is written as many times as its count minus its
+    /// highest count in a single excluded sequence, the output is sorted.
+    ///
+    /// @tparam IT type using to go through the collections.
+    /// @tparam OutputIT type of the iterator receiving the difference.
+    ///
+    /// @param begin,end - iterators to the initial and final positions of the sequence to be filtered.
+    /// @param excluded [begin, end) iterators of each sorted sequence to be removed.
+    /// @param out output iterator to the initial position of the destination.
+    ///
+    /// @complexity O(n.k.log(m/n)), n being the size of the first sequence and m the largest excluded one.
+    ///
+    /// @return output iterator to the element past the last written element.
+    template <typename IT, typename OutputIT>
+    OutputIT Difference(const IT& begin, const IT& end,
+                        const std::vector<std::pair<IT, IT>>& excluded, OutputIT out)
+    {
+      std::vector<std::pair<IT, IT>> cursors(excluded);
+      for (auto it = begin; it != end;)
+      {
+        // Count the run of the current value
+        const auto value = *it;
+        size_t run = 0;
+        for (; it != end && !(value < *it); ++it)
+          ++run;
+
+        // Remove the highest count found within the excluded sequences
+        size_t maxExcluded = 0;
+        for (auto cursorIt = cursors.begin(); cursorIt != cursors.end() && maxExcluded < run; ++cursorIt)
+        {
+          cursorIt->first = GallopLowerBound(cursorIt->first, cursorIt->second, value);
+          size_t excludedRun = 0;
+          for (; cursorIt->first != cursorIt->second && !(value < *cursorIt->first); ++cursorIt->first)
+            ++excludedRun;
+          maxExcluded = std::max(maxExcluded, excludedRun);
+        }
+
+        for (size_t i = maxExcluded; i < run; ++i)
+          *out++ = value;
+      }
+
+      return out;
+    }
+
+    /// IntersectAllCount - Size of the intersection of k sorted sequences (cf. IntersectAll).
+    ///
+    /// @return the number of elements within the intersection.
+    template <typename IT>
+    size_t IntersectAllCount(const std::vector<std::pair<IT, IT>>& ranges)
+    { return IntersectAll(ranges, CountingIterator()).Count(); }
+
+    /// UnionAllCount - Size of the union of k sorted sequences (cf. UnionAll).
+    ///
+    /// @return the number of elements within the union.
+    template <typename IT>
+    size_t UnionAllCount(const std::vector<std::pair<IT, IT>>& ranges)
+    { return UnionAll(ranges, CountingIterator()).Count(); }
+
+    /// DifferenceCount - Size of the difference of sorted sequences (cf. Difference).
+    ///
+    /// @return the number of elements within the difference.
+    template <typename IT>
+    size_t DifferenceCount(const IT& begin, const IT& end, const std::vector<std::pair<IT, IT>>& excluded)
+    { return Difference(begin, end, excluded, CountingIterator()).Count(); }
+  }
+}
+
+#endif // MODULE_COMBINATORY_SET_OPERATIONS_HXX
@@ -0,0 +1,208 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#ifndef MODULE_COMBINATORY_SHUFFLE_HXX
+#define MODULE_COMBINATORY_SHUFFLE_HXX
+
+#include <Combinatory/parallel.hxx>
+#include <Combinatory/random.hxx>
+
+// STD includes
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace huc
+{
+  namespace combinatory
+  {
+    // Elements per block of the scatter shuffle: below two blocks the shuffle runs sequentially.
+    const size_t kShuffleBlockSize = 1 << 14;
+    // Maximum number of buckets of the scatter shuffle, bounding the (chunk x bucket) histogram.
+    const size_t kMaxShuffleBuckets = 256;
+    // Size in bytes of the buckets shuffled in place by Fisher-Yates (about a L2 cache): larger buckets of
+    // the scatter shuffle are scattered again.
+    const size_t kShuffleBucketBytes = 1 << 20;
+
+    /// Shuffle - Fisher-Yates shuffle of [begin, end[ drawing from a random stream.
+    ///
+    /// @tparam IT type of random access iterator.
+    ///
+    /// @param begin,end iterators to the initial and final positions of the sequence to be shuffled.
+    /// @param random the random stream.
+    ///
+    /// @complexity O(n).
+    ///
+    /// @return void.
+    template <typename IT>
+    void Shuffle(const IT& begin, const IT& end, RandomStream& random)
+    {
+      typedef typename std::iterator_traits<IT>::difference_type Difference;
+
+      for (Difference i = std::distance(begin, end) - 1; i > 0; --i)
+        std::iter_swap(begin + i, begin + static_cast<Difference>(random.Below(static_cast<uint64_t>(i) + 1)));
+    }
+
+    /// ScatterShuffle - Shuffle [begin, end[ by scattering its elements into bucketCount buckets.
+    ///
+    /// Each element is sent to a uniformly drawn bucket, then each bucket is shuffled with Fisher-Yates and
+    /// the buckets are concatenated: the result is a uniform permutation (Sanders). Input chunks and output
+    /// buckets are processed as independent parallel tasks, each one drawing from its own random stream,
+    /// so the result only depends on the seed and bucketCount - never on the number of threads.
+    ///
+    /// The scatter writes sequentially within bucketCount output streams, whereas the random accesses of
+    /// Fisher-Yates are restricted to buckets of at most kShuffleBucketBytes (or kShuffleBlockSize elements)
+    /// that stay within the caches: larger buckets, whose count is bounded by kMaxShuffleBuckets, are
+    /// themselves scatter shuffled sequentially with a seed drawn from their stream, into enough buckets to
+    /// fit the caches (two levels up to 64 GB of data).
+    ///
+    /// @tparam IT type of random access iterator.
+    ///
+    /// @param begin,end iterators to the initial and final positions of the sequence to be shuffled.
+    /// @param seed the seed of the random streams.
+    /// @param bucketCount number of buckets (and input chunks), within [1, kMaxShuffleBuckets].
+    /// @param threadCount number of threads to be used, every hardware thread by default.
+    ///
+    /// @complexity O(n) time per scatter level (a level per factor kMaxShuffleBuckets of data above
+    /// kShuffleBucketBytes), O(n) extra memory.
+    ///
+    /// @return void.
+    template <typename IT>
+    void ScatterShuffle(const IT& begin, const IT& end, uint64_t seed, size_t bucketCount,
+                        uint32_t threadCount = 0)
+    {
+      typedef typename std::iterator_traits<IT>::value_type Value;
+      typedef typename std::iterator_traits<IT>::difference_type Difference;
+
+      const auto kDistance = std::distance(begin, end);
+      if (kDistance < 2)
+        return;
+
+      const size_t kSize = static_cast<size_t>(kDistance);
+      bucketCount = std::max<size_t>(1, std::min<size_t>(bucketCount, kMaxShuffleBuckets));
+      threadCount = GetThreadCount(threadCount);
+      const uint32_t kBuckets = static_cast<uint32_t>(bucketCount);
+
+      // Chunk c covers [chunkStart(c), chunkStart(c + 1)) and draws from the stream c
+      auto lChunkStart = [kSize, bucketCount](size_t chunk) { return chunk * kSize / bucketCount; };
+
+      // Count the elements sent by each chunk to each bucket
+      std::vector<size_t> offsets(bucketCount * bucketCount, 0);
+      ParallelTasks(bucketCount, threadCount, [&](size_t chunk, uint32_t)
+      {
+        RandomStream random(seed, chunk);
+        size_t* histogram = &offsets[chunk * bucketCount];
+        for (size_t i = lChunkStart(chunk); i < lChunkStart(chunk + 1); ++i)
+          ++histogram[random.Below(kBuckets)];
+      });
+
+      // Turn counts into write offsets: buckets one after the other, chunks in order within a bucket
+      std::vector<size_t> bucketStarts(bucketCount + 1, 0);
+      size_t offset = 0;
+      for (size_t bucket = 0; bucket < bucketCount; ++bucket)
+      {
+        bucketStarts[bucket] = offset;
+        for (size_t chunk = 0; chunk < bucketCount; ++chunk)
+        {
+          const size_t kCount = offsets[chunk * bucketCount + bucket];
+          offsets[chunk * bucketCount + bucket] = offset;
+          offset += kCount;
+        }
+      }
+      bucketStarts[bucketCount] = offset;
+
+      // Scatter: replay the same draws to send each element to its bucket
+      std::vector<Value> buffer(kSize);
+      ParallelTasks(bucketCount, threadCount, [&](size_t chunk, uint32_t)
+      {
+        RandomStream random(seed, chunk);
+        size_t* writeOffsets = &offsets[chunk * bucketCount];
+        for (size_t i = lChunkStart(chunk); i < lChunkStart(chunk + 1); ++i)
+          buffer[writeOffsets[random.Below(kBuckets)]++] = std::move(*(begin + static_cast<Difference>(i)));
+      });
+
+      // Shuffle each bucket with its own stream, scattering again the buckets exceeding the caches, and
+      // move it back
+      ParallelTasks(bucketCount, threadCount, [&](size_t bucket, uint32_t)
+      {
+        RandomStream random(seed, kMaxShuffleBuckets + bucket);
+        auto bucketBegin = buffer.begin() + static_cast<std::ptrdiff_t>(bucketStarts[bucket]);
+        auto bucketEnd = buffer.begin() + static_cast<std::ptrdiff_t>(bucketStarts[bucket + 1]);
+        const size_t kBucketSize = bucketStarts[bucket + 1] - bucketStarts[bucket];
+        const size_t kBucketBytes = kBucketSize * sizeof(Value);
+        if (kBucketSize > kShuffleBlockSize && kBucketBytes > kShuffleBucketBytes)
+          ScatterShuffle(bucketBegin, bucketEnd, random(), kBucketBytes / kShuffleBucketBytes + 1, 1);
+        else
+          Shuffle(bucketBegin, bucketEnd, random);
+        std::move(bucketBegin, bucketEnd, begin + static_cast<Difference>(bucketStarts[bucket]));
+      });
+    }
+
+    /// ParallelShuffle - Uniform shuffle of [begin, end[ using several threads, reproducible from the seed
+    /// whatever the number of threads (cf. ScatterShuffle).
+    /// Sequences of less than two blocks are shuffled sequentially by Fisher-Yates.
+    ///
+    /// @tparam IT type of random access iterator.
+    ///
+    /// @param begin,end iterators to the initial and final positions of the sequence to be shuffled.
+    /// @param seed the seed of the random streams.
+    /// @param threadCount number of threads to be used, every hardware thread by default.
+    ///
+    /// @complexity O(n) time, O(n) extra memory above two blocks.
+    ///
+    /// @return void.
+    template <typename IT>
+    void ParallelShuffle(const IT& begin, const IT& end, uint64_t seed, uint32_t threadCount = 0)
+    {
+      const size_t kSize = static_cast<size_t>(std::max<std::ptrdiff_t>(0, std::distance(begin, end)));
+      if (kSize < 2 * kShuffleBlockSize)
+      {
+        RandomStream random(seed);
+        Shuffle(begin, end, random);
+        return;
+      }
+
+      ScatterShuffle(begin, end, seed, std::min<size_t>(kSize / kShuffleBlockSize, kMaxShuffleBuckets),
+                     threadCount);
+    }
+
+    /// RandomPermutation - Generate a uniform random permutation of [0, n).
+    ///
+    /// @tparam Index integral type of the permutation values.
+    ///
+    /// @param n the size of the permutation.
+    /// @param seed the seed of the random streams.
+    /// @param threadCount number of threads to be used, every hardware thread by default.
+    ///
+    /// @return the permutation.
+    template <typename Index = uint32_t>
+    std::vector<Index> RandomPermutation(size_t n, uint64_t seed, uint32_t threadCount = 0)
+    {
+      std::vector<Index> permutation(n);
+      std::iota(permutation.begin(), permutation.end(), Index(0));
+      ParallelShuffle(permutation.begin(), permutation.end(), seed, threadCount);
+      return permutation;
+    }
+  }
+}
+
+#endif // MODULE_COMBINATORY_SHUFFLE_HXX
@@ -0,0 +1,383 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#ifndef MODULE_COMBINATORY_SKETCHES_HXX
+#define MODULE_COMBINATORY_SKETCHES_HXX
+
+#include <Combinatory/intrinsics.hxx>
+
+// STD includes
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace huc
+{
+  namespace combinatory
+  {
+    /// Append value to bytes in little endian order.
+    inline void WriteLittleEndian(std::vector<uint8_t>& bytes, uint64_t value, size_t size)
+    {
+      for (size_t i = 0; i < size; ++i)
+        bytes.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+
+    /// Read a little endian value of size bytes starting at bytes[offset].
+    inline uint64_t ReadLittleEndian(const std::vector<uint8_t>& bytes, size_t offset, size_t size)
+    {
+      uint64_t value = 0;
+      for (size_t i = 0; i < size; ++i)
+        value |= static_cast<uint64_t>(bytes[offset + i]) << (8 * i);
+      return value;
+    }
+
+    /// @class HyperLogLog
+    ///
+    /// HyperLogLog estimates the number of distinct elements of a multiset with a fixed amount of memory
+    /// (P. Flajolet, E. Fusy, O. Gandouet, F. Meunier - HyperLogLog: the analysis of a near-optimal
+    /// cardinality estimation algorithm).
+    ///
+    /// Each element is hashed: the first p bits select one of the 2^p registers, which keeps the highest
+    /// rank (position of the first bit set) seen among the remaining bits.
+    ///
+    /// @advantages
+    /// - 2^p bytes whatever the cardinality, with a standard error of 1.04 / sqrt(2^p) (0.8% for p = 14).
+    /// - Sketches built with the same precision and seed merge into the sketch of the union (SIMD max).
+    ///
+    /// @drawbacks
+    /// - Only an estimate: intersections derived by inclusion-exclusion lose precision on small overlaps.
+    class HyperLogLog
+    {
+    public:
+      enum : uint8_t { kMinPrecision = 4, kMaxPrecision = 18 };
+
+      /// HyperLogLog constructor.
+      ///
+      /// @param precision log2 of the number of registers, clamped within [kMinPrecision, kMaxPrecision].
+      /// @param seed seed of the hash function: only sketches sharing the seed can be merged.
+      explicit HyperLogLog(uint8_t precision = 14, uint64_t seed = 0) :
+        precision(std::min<uint8_t>(std::max<uint8_t>(precision, kMinPrecision), kMaxPrecision)), seed(seed),
+        registers(size_t(1) << this->precision, 0)
+      {}
+
+      /// Add - Insert value within the sketch.
+      template <typename T>
+      void Add(const T& value)
+      { AddHash(Mix64(static_cast<uint64_t>(std::hash<T>()(value)) ^ Mix64(this->seed))); }
+
+      /// AddHash - Insert an already hashed (uniformly distributed) value within the sketch.
+      void AddHash(uint64_t hash)
+      {
+        const size_t kIdx = static_cast<size_t>(hash >> (64 - this->precision));
+        const uint64_t kRemaining = (hash << this->precision) | (uint64_t(1) << (this->precision - 1));
+        const uint8_t kRank = static_cast<uint8_t>(CountLeadingZeros(kRemaining) + 1);
+        if (kRank > this->registers[kIdx])
+          this->registers[kIdx] = kRank;
+      }
+
+      /// Estimate - Return the estimated number of distinct elements inserted.
+      /// Small cardinalities, with empty registers left, are estimated by linear counting.
+      double Estimate() const
+      {
+        const double kM = static_cast<double>(this->registers.size());
+        double sum = 0;
+        size_t zeros = 0;
+        for (auto it = this->registers.begin(); it != this->registers.end(); ++it)
+        {
+          sum += std::ldexp(1.0, -static_cast<int>(*it));
+          zeros += (*it == 0) ? 1 : 0;
+        }
+
+        const double kAlpha = (this->precision == 4) ? 0.673 : (this->precision == 5) ? 0.697 :
+                              (this->precision == 6) ? 0.709 : 0.7213 / (1.0 + 1.079 / kM);
+        const double kEstimate = kAlpha * kM * kM / sum;
+        if (kEstimate <= 2.5 * kM && zeros > 0)
+          return kM * std::log(kM / static_cast<double>(zeros));
+
+        return kEstimate;
+      }
+
+      /// Merge - Turn the sketch into the sketch of the union with other.
+      ///
+      /// @return false if the sketches do not share the same precision and seed, true otherwise.
+      bool Merge(const HyperLogLog& other)
+      {
+        if (other.precision != this->precision || other.seed != this->seed)
+          return false;
+
+        size_t i = 0;
+        uint8_t* registers = this->registers.data();
+        const uint8_t* otherRegisters = other.registers.data();
+#ifdef HUC_USE_SSE2
+        for (; i + 16 <= this->registers.size(); i += 16)
+        {
+          const __m128i kMax = _mm_max_epu8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(registers + i)),
+                                            _mm_loadu_si128(reinterpret_cast<const __m128i*>(otherRegisters + i)));
+          _mm_storeu_si128(reinterpret_cast<__m128i*>(registers + i), kMax);
+        }
+#endif
+        for (; i < this->registers.size(); ++i)
+          registers[i] = std::max(registers[i], otherRegisters[i]);
+
+        return true;
+      }
+
+      /// EstimateUnion - Return the estimated number of distinct elements of the union of both sketches.
+      /// @return the estimate, -1 if the sketches cannot be merged.
+      static double EstimateUnion(const HyperLogLog& first, const HyperLogLog& second)
+      {
+        HyperLogLog merged(first);
+        return (merged.Merge(second)) ? merged.Estimate() : -1;
+      }
+
+      /// EstimateIntersection - Return the estimated number of distinct elements found within both sketches
+      /// (inclusion-exclusion principle).
+      /// @return the estimate, -1 if the sketches cannot be merged.
+      static double EstimateIntersection(const HyperLogLog& first, const HyperLogLog& second)
+      {
+        const double kUnion = EstimateUnion(first, second);
+        return (kUnion < 0) ? -1 : std::max(0.0, first.Estimate() + second.Estimate() - kUnion);
+      }
+
+      /// Serialize - Return the sketch as bytes: "HLL", version, precision, seed and registers.
+      std::vector<uint8_t> Serialize() const
+      {
+        std::vector<uint8_t> bytes = {'H', 'L', 'L', kVersion, this->precision};
+        bytes.reserve(kHeaderSize + this->registers.size());
+        WriteLittleEndian(bytes, this->seed, 8);
+        bytes.insert(bytes.end(), this->registers.begin(), this->registers.end());
+        return bytes;
+      }
+
+      /// Deserialize - Build a sketch from the bytes produced by Serialize.
+      /// @return HyperLogLog pointer to be owned, nullptr if the bytes are not a valid sketch.
+      static std::unique_ptr<HyperLogLog> Deserialize(const std::vector<uint8_t>& bytes)
+      {
+        if (bytes.size() < kHeaderSize || bytes[0] != 'H' || bytes[1] != 'L' || bytes[2] != 'L' ||
+            bytes[3] != kVersion || bytes[4] < kMinPrecision || bytes[4] > kMaxPrecision ||
+            bytes.size() != kHeaderSize + (size_t(1) << bytes[4]))
+          return nullptr;
+
+        std::unique_ptr<HyperLogLog> sketch(new HyperLogLog(bytes[4], ReadLittleEndian(bytes, 5, 8)));
+        std::copy(bytes.begin() + kHeaderSize, bytes.end(), sketch->registers.begin());
+        return sketch;
+      }
+
+      uint8_t Precision() const { return this->precision; }
+      const std::vector<uint8_t>& Registers() const { return this->registers; }
+
+    private:
+      static const uint8_t kVersion = 1;
+      static const size_t kHeaderSize = 13;
+
+      uint8_t precision;              // log2 of the number of registers
+      uint64_t seed;                  // Seed of the hash function
+      std::vector<uint8_t> registers; // Highest rank seen per register
+    };
+
+    /// @class MinHash
+    ///
+    /// One Permutation MinHash estimates the Jaccard similarity |A n B| / |A u B| of two sets from small
+    /// signatures (P. Li, A. Owen, C. Zhang - One Permutation Hashing).
+    ///
+    /// A single hash is computed per element: its high bits select one of the k bins and the bin keeps the
+    /// minimum of the low bits. Bins left empty (sets smaller than k) are filled at estimation time by
+    /// optimal densification (A. Shrivastava - Optimal Densification for Fast and Accurate Minwise Hashing):
+    /// each empty bin copies the first non empty bin of its own pseudo-random probing sequence.
+    ///
+    /// @advantages
+    /// - O(1) per inserted element, k 32-bit words per signature: standard error of sqrt(J(1 - J) / k).
+    /// - Signatures built with the same size and seed merge into the signature of the union (SIMD min).
+    /// - Comparison of the signatures is done 4 bins at a time.
+    ///
+    /// @drawbacks
+    /// - Only an estimate, intersection sizes also require the cardinalities (cf. HyperLogLog).
+    class MinHash
+    {
+    public:
+      enum : uint32_t { kEmptyBin = 0xFFFFFFFF };
+
+      /// MinHash constructor.
+      ///
+      /// @param binCount number of bins k of the signature (at least 1).
+      /// @param seed seed of the hash function: only signatures sharing the seed can be compared.
+      explicit MinHash(uint32_t binCount = 256, uint64_t seed = 0) :
+        seed(seed), bins((binCount > 0) ? binCount : 1, static_cast<uint32_t>(kEmptyBin))
+      {}
+
+      /// Add - Insert value within the signature.
+      template <typename T>
+      void Add(const T& value)
+      { AddHash(Mix64(static_cast<uint64_t>(std::hash<T>()(value)) ^ Mix64(this->seed))); }
+
+      /// AddHash - Insert an already hashed (uniformly distributed) value within the signature.
+      void AddHash(uint64_t hash)
+      {
+        const size_t kBin = static_cast<size_t>(((hash >> 32) * this->bins.size()) >> 32);
+        const uint32_t kValue = std::min(static_cast<uint32_t>(hash), kEmptyBin - 1);
+        if (kValue < this->bins[kBin])
+          this->bins[kBin] = kValue;
+      }
+
+      /// Merge - Turn the signature into the signature of the union with other.
+      ///
+      /// @return false if the signatures do not share the same size and seed, true otherwise.
+      bool Merge(const MinHash& other)
+      {
+        if (other.bins.size() != this->bins.size() || other.seed != this->seed)
+          return false;
+
+        size_t i = 0;
+        uint32_t* bins = this->bins.data();
+        const uint32_t* otherBins = other.bins.data();
+#ifdef HUC_USE_SSE2
+        for (; i + 4 <= this->bins.size(); i += 4)
+        {
+          const __m128i kA = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bins + i));
+          const __m128i kB = _mm_loadu_si128(reinterpret_cast<const __m128i*>(otherBins + i));
+#ifdef HUC_USE_SSE41
+          const __m128i kMin = _mm_min_epu32(kA, kB);
+#else
+          // Unsigned comparison through signed comparison of the values with their sign bit flipped
+          const __m128i kSign = _mm_set1_epi32(static_cast<int>(0x80000000));
+          const __m128i kLess = _mm_cmplt_epi32(_mm_xor_si128(kA, kSign), _mm_xor_si128(kB, kSign));
+          const __m128i kMin = _mm_or_si128(_mm_and_si128(kLess, kA), _mm_andnot_si128(kLess, kB));
+#endif
+          _mm_storeu_si128(reinterpret_cast<__m128i*>(bins + i), kMin);
+        }
+#endif
+        for (; i < this->bins.size(); ++i)
+          bins[i] = std::min(bins[i], otherBins[i]);
+
+        return true;
+      }
+
+      /// Densified - Return the signature whose empty bins are filled by optimal densification.
+      /// All the bins stay empty if no element has been inserted.
+      std::vector<uint32_t> Densified() const
+      {
+        std::vector<uint32_t> densified(this->bins);
+        if (IsEmpty())
+          return densified;
+
+        const uint64_t kBinCount = this->bins.size();
+        for (uint64_t bin = 0; bin < kBinCount; ++bin)
+          for (uint64_t attempt = 1; densified[bin] == kEmptyBin; ++attempt)
+          {
+            const uint64_t kProbe = Mix64(Mix64(this->seed ^ (bin << 32)) + attempt);
+            densified[bin] = this->bins[static_cast<size_t>(((kProbe >> 32) * kBinCount) >> 32)];
+          }
+
+        return densified;
+      }
+
+      /// IsEmpty - Whether or not no element has been inserted.
+      bool IsEmpty() const
+      {
+        for (auto it = this->bins.begin(); it != this->bins.end(); ++it)
+          if (*it != kEmptyBin)
+            return false;
+        return true;
+      }
+
+      /// EstimateJaccard - Return the estimated Jaccard similarity of the sets of both signatures.
+      ///
+      /// @return the similarity within [0, 1], 0 if a set is empty, -1 if the signatures are not comparable.
+      static double EstimateJaccard(const MinHash& first, const MinHash& second)
+      {
+        if (first.bins.size() != second.bins.size() || first.seed != second.seed)
+          return -1;
+        if (first.IsEmpty() || second.IsEmpty())
+          return 0;
+
+        const auto kFirst = first.Densified();
+        const auto kSecond = second.Densified();
+        size_t equalCount = 0;
+        size_t i = 0;
+#ifdef HUC_USE_SSE2
+        for (; i + 4 <= kFirst.size(); i += 4)
+        {
+          const __m128i kEqual = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&kFirst[i])),
+                                                 _mm_loadu_si128(reinterpret_cast<const __m128i*>(&kSecond[i])));
+          equalCount += PopCount(static_cast<uint64_t>(_mm_movemask_ps(_mm_castsi128_ps(kEqual))));
+        }
+#endif
+        for (; i < kFirst.size(); ++i)
+          equalCount += (kFirst[i] == kSecond[i]) ? 1 : 0;
+
+        return static_cast<double>(equalCount) / static_cast<double>(kFirst.size());
+      }
+
+      /// EstimateIntersectionSize - Return the estimated size of the intersection of both sets given their
+      /// cardinalities (exact or estimated by HyperLogLog): |A n B| = J.(|A| + |B|) / (1 + J).
+      ///
+      /// @return the estimated size, -1 if the signatures are not comparable.
+      static double EstimateIntersectionSize(const MinHash& first, const MinHash& second,
+                                             double firstSize, double secondSize)
+      {
+        const double kJaccard = EstimateJaccard(first, second);
+        return (kJaccard < 0) ? -1 : kJaccard * (firstSize + secondSize) / (1.0 + kJaccard);
+      }
+
+      /// Serialize - Return the signature as bytes: "OPH", version, bin count, seed and bins.
+      std::vector<uint8_t> Serialize() const
+      {
+        std::vector<uint8_t> bytes = {'O', 'P', 'H', kVersion};
+        bytes.reserve(kHeaderSize + 4 * this->bins.size());
+        WriteLittleEndian(bytes, this->bins.size(), 4);
+        WriteLittleEndian(bytes, this->seed, 8);
+        for (auto it = this->bins.begin(); it != this->bins.end(); ++it)
+          WriteLittleEndian(bytes, *it, 4);
+        return bytes;
+      }
+
+      /// Deserialize - Build a signature from the bytes produced by Serialize.
+      /// @return MinHash pointer to be owned, nullptr if the bytes are not a valid signature.
+      static std::unique_ptr<MinHash> Deserialize(const std::vector<uint8_t>& bytes)
+      {
+        if (bytes.size() < kHeaderSize || bytes[0] != 'O' || bytes[1] != 'P' || bytes[2] != 'H' ||
+            bytes[3] != kVersion)
+          return nullptr;
+
+        const auto kBinCount = static_cast<uint32_t>(ReadLittleEndian(bytes, 4, 4));
+        if (kBinCount == 0 || bytes.size() != kHeaderSize + 4 * static_cast<size_t>(kBinCount))
+          return nullptr;
+
+        std::unique_ptr<MinHash> signature(new MinHash(kBinCount, ReadLittleEndian(bytes, 8, 8)));
+        for (size_t i = 0; i < kBinCount; ++i)
+          signature->bins[i] = static_cast<uint32_t>(ReadLittleEndian(bytes, kHeaderSize + 4 * i, 4));
+        return signature;
+      }
+
+      const std::vector<uint32_t>& Bins() const { return this->bins; }
+
+    private:
+      static const uint8_t kVersion = 1;
+      static const size_t kHeaderSize = 16;
+
+      uint64_t seed;               // Seed of the hash function
+      std::vector<uint32_t> bins;  // Minimum hash value per bin
+    };
+  }
+}
+
+#endif // MODULE_COMBINATORY_SKETCHES_HXX
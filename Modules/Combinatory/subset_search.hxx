@@ -0,0 +1,167 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#ifndef MODULE_COMBINATORY_SUBSET_SEARCH_HXX
+#define MODULE_COMBINATORY_SUBSET_SEARCH_HXX
+
+#include <Combinatory/parallel.hxx>
+
+// STD includes
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace huc
+{
+  namespace combinatory
+  {
+    /// SearchAction - Decision returned by the search callbacks.
+    enum class SearchAction
+    {
+      Continue, // Explore the subtree
+      Prune     // Skip the subtree
+    };
+
+    /// SubsetVisitorBase - Default callbacks of a subset search, visiting the 2^n subsets.
+    ///
+    /// Visitors derive from it and hide the callbacks they need (static dispatch, no virtual call):
+    /// - Include(idx) / Exclude(idx): push the decision for element idx into the visitor state,
+    ///   return SearchAction::Prune to skip the subtree below this decision.
+    /// - UndoInclude(idx) / UndoExclude(idx): pop the decision, always called after Include / Exclude
+    ///   whatever their result.
+    /// - Bound(depth): called on each node before its children, return false to cut the subtree (e.g. when
+    ///   an optimistic bound cannot beat the best solution found so far).
+    /// - Leaf(): called on each complete subset (every element decided).
+    struct SubsetVisitorBase
+    {
+      SearchAction Include(size_t) { return SearchAction::Continue; }
+      SearchAction Exclude(size_t) { return SearchAction::Continue; }
+      void UndoInclude(size_t) {}
+      void UndoExclude(size_t) {}
+      bool Bound(size_t) { return true; }
+      void Leaf() {}
+    };
+
+    /// SubsetSearchFrom - Depth first search of the subsets of elements [depth, n), the elements below
+    /// depth being already decided within the visitor state.
+    ///
+    /// @return void.
+    template <typename Visitor>
+    void SubsetSearchFrom(size_t depth, size_t n, Visitor& visitor)
+    {
+      if (!visitor.Bound(depth))
+        return;
+
+      if (depth == n)
+      {
+        visitor.Leaf();
+        return;
+      }
+
+      if (visitor.Include(depth) == SearchAction::Continue)
+        SubsetSearchFrom(depth + 1, n, visitor);
+      visitor.UndoInclude(depth);
+
+      if (visitor.Exclude(depth) == SearchAction::Continue)
+        SubsetSearchFrom(depth + 1, n, visitor);
+      visitor.UndoExclude(depth);
+    }
+
+    /// SubsetSearch - Branch and bound enumeration of the subsets of n elements.
+    ///
+    /// Each element is either included or excluded (in this order) through the visitor callbacks
+    /// (cf. SubsetVisitorBase), which maintain the state of the search incrementally and prune the subtrees
+    /// that cannot lead to a solution: unlike Combinations, the cost only depends on the explored nodes.
+    ///
+    /// @tparam Visitor type of the visitor, deriving from SubsetVisitorBase.
+    ///
+    /// @param n number of elements.
+    /// @param visitor the visitor receiving the callbacks.
+    ///
+    /// @complexity O(2^n) nodes in the worst case, O(nodes explored) with pruning.
+    ///
+    /// @return void.
+    template <typename Visitor>
+    void SubsetSearch(size_t n, Visitor& visitor)
+    { SubsetSearchFrom(0, n, visitor); }
+
+    /// ParallelSubsetSearch - Parallel branch and bound enumeration of the subsets of n elements.
+    ///
+    /// The decisions on the first splitDepth elements are enumerated into 2^splitDepth independent tasks.
+    /// Each thread owns a copy of the visitor: for each task it replays the decisions of the prefix, searches
+    /// the remaining elements (cf. SubsetSearch) and undoes the prefix, so that the visitor is back to its
+    /// initial state before the next task.
+    ///
+    /// @remark Visitors do not share any state: pruning on a best solution only uses the solutions found by
+    /// the same thread, unless the visitor shares it (e.g. through an atomic).
+    ///
+    /// @tparam Visitor type of the visitor, deriving from SubsetVisitorBase and copyable.
+    ///
+    /// @param n number of elements.
+    /// @param visitor the initial visitor, copied for each thread.
+    /// @param splitDepth number of top decision levels split into tasks (clamped to n, 20 at most).
+    /// @param threadCount number of threads to be used, every hardware thread by default.
+    ///
+    /// @return the visitor of each thread, to be reduced by the caller.
+    template <typename Visitor>
+    std::vector<Visitor> ParallelSubsetSearch(size_t n, const Visitor& visitor, size_t splitDepth = 8,
+                                              uint32_t threadCount = 0)
+    {
+      threadCount = GetThreadCount(threadCount);
+      splitDepth = std::min<size_t>(std::min<size_t>(splitDepth, n), 20);
+
+      std::vector<Visitor> visitors(threadCount, visitor);
+      ParallelTasks(size_t(1) << splitDepth, threadCount, [&](size_t task, uint32_t threadIdx)
+      {
+        auto& threadVisitor = visitors[threadIdx];
+
+        // Replay the prefix: bit (splitDepth - 1 - k) of the task set means element k is included
+        size_t decided = 0;
+        bool isAlive = true;
+        for (size_t depth = 0; depth < splitDepth && isAlive; ++depth)
+        {
+          isAlive = threadVisitor.Bound(depth);
+          if (!isAlive)
+            break;
+
+          const bool kIsIncluded = (task >> (splitDepth - 1 - depth)) & 1;
+          ++decided;
+          isAlive = ((kIsIncluded) ? threadVisitor.Include(depth) : threadVisitor.Exclude(depth)) ==
+                    SearchAction::Continue;
+        }
+
+        if (isAlive)
+          SubsetSearchFrom(splitDepth, n, threadVisitor);
+
+        // Undo the decisions made, in reverse order
+        while (decided-- > 0)
+        {
+          if ((task >> (splitDepth - 1 - decided)) & 1)
+            threadVisitor.UndoInclude(decided);
+          else
+            threadVisitor.UndoExclude(decided);
+        }
+      });
+
+      return visitors;
+    }
+  }
+}
+
+#endif // MODULE_COMBINATORY_SUBSET_SEARCH_HXX
@@ -0,0 +1,249 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#ifndef MODULE_COMBINATORY_SUBSET_SUM_HXX
+#define MODULE_COMBINATORY_SUBSET_SUM_HXX
+
+#include <Combinatory/intrinsics.hxx>
+#include <Sort/raddix.hxx>
+
+// STD includes
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+namespace huc
+{
+  namespace combinatory
+  {
+    /// SubsetSums - Enumerate the sums of every subset of [begin, end[ following a binary reflected Gray
+    /// code: two consecutive subsets differ by a single element, so each sum costs a single addition.
+    ///
+    /// @warning the number of elements must remain small (2^n sums are generated) and the sums must fit
+    /// within 64 bits.
+    ///
+    /// @tparam IT type using to go through the collection of integral values.
+    ///
+    /// @param begin,end iterators to the initial and final positions of the sequence.
+    ///
+    /// @return the 2^n subset sums, the i-th one being the sum of the subset encoded by the i-th Gray code.
+    template <typename IT>
+    std::vector<int64_t> SubsetSums(const IT& begin, const IT& end)
+    {
+      const std::vector<int64_t> values(begin, end);
+      std::vector<int64_t> sums(size_t(1) << values.size());
+
+      uint64_t subset = 0;
+      int64_t sum = 0;
+      sums[0] = 0;
+      for (size_t i = 1; i < sums.size(); ++i)
+      {
+        // The i-th Gray code flips the element of index ctz(i)
+        const uint32_t kFlipped = CountTrailingZeros(i);
+        subset ^= uint64_t(1) << kFlipped;
+        sum += (subset & (uint64_t(1) << kFlipped)) ? values[kFlipped] : -values[kFlipped];
+        sums[i] = sum;
+      }
+
+      return sums;
+    }
+
+    /// SortSums - Sort 64 bits sums with the library's LSD Raddix Sort, the values being shifted by the
+    /// minimum first so that the sorted keys are non-negative and only span the digits of the range.
+    ///
+    /// @param sums the sums to be sorted.
+    ///
+    /// @return void.
+    inline void SortSums(std::vector<int64_t>& sums)
+    {
+      if (sums.size() < 2)
+        return;
+
+      const int64_t kMin = *std::min_element(sums.begin(), sums.end());
+      std::vector<uint64_t> keys(sums.size());
+      for (size_t i = 0; i < sums.size(); ++i)
+        keys[i] = static_cast<uint64_t>(sums[i]) - static_cast<uint64_t>(kMin);
+
+      huc::sort::RaddixSort(keys.begin(), keys.end(), 256);
+
+      for (size_t i = 0; i < sums.size(); ++i)
+        sums[i] = static_cast<int64_t>(keys[i] + static_cast<uint64_t>(kMin));
+    }
+
+    /// PairSumExists - Whether a + b == target for some a in lower and b in upper.
+    /// Two pointers join: lower is walked upward while upper is walked downward.
+    ///
+    /// @param lower,upper the collections, both sorted in ascending order.
+    /// @param target the searched sum.
+    ///
+    /// @complexity O(|lower| + |upper|).
+    ///
+    /// @return true if such a pair exists, false otherwise.
+    inline bool PairSumExists(const std::vector<int64_t>& lower, const std::vector<int64_t>& upper,
+                              int64_t target)
+    {
+      auto itLow = lower.begin();
+      auto itUp = upper.rbegin();
+      while (itLow != lower.end() && itUp != upper.rend())
+      {
+        const int64_t kSum = *itLow + *itUp;
+        if (kSum == target)
+          return true;
+        if (kSum < target)
+          ++itLow;
+        else
+          ++itUp;
+      }
+
+      return false;
+    }
+
+    /// PairSumCount - Return the number of pairs (a, b), a in lower and b in upper, such as a + b == target.
+    /// Two pointers join, runs of equal values being counted as a whole.
+    ///
+    /// @param lower,upper the collections, both sorted in ascending order.
+    /// @param target the searched sum.
+    ///
+    /// @complexity O(|lower| + |upper|).
+    ///
+    /// @return the number of pairs.
+    inline uint64_t PairSumCount(const std::vector<int64_t>& lower, const std::vector<int64_t>& upper,
+                                 int64_t target)
+    {
+      uint64_t count = 0;
+      auto itLow = lower.begin();
+      auto itUp = upper.rbegin();
+      while (itLow != lower.end() && itUp != upper.rend())
+      {
+        const int64_t kSum = *itLow + *itUp;
+        if (kSum < target)
+          ++itLow;
+        else if (kSum > target)
+          ++itUp;
+        else
+        {
+          // Count both runs of equal values
+          const int64_t kLowValue = *itLow, kUpValue = *itUp;
+          uint64_t lowRun = 0, upRun = 0;
+          for (; itLow != lower.end() && *itLow == kLowValue; ++itLow)
+            ++lowRun;
+          for (; itUp != upper.rend() && *itUp == kUpValue; ++itUp)
+            ++upRun;
+          count += lowRun * upRun;
+        }
+      }
+
+      return count;
+    }
+
+    /// PairSumClosest - Return the sum a + b, a in lower and b in upper, the closest to target.
+    /// On ties, the smallest sum is returned.
+    ///
+    /// @warning both collections must contain at least one value.
+    ///
+    /// @param lower,upper the collections, both sorted in ascending order.
+    /// @param target the targeted sum.
+    ///
+    /// @complexity O(|lower| + |upper|).
+    ///
+    /// @return the closest sum.
+    inline int64_t PairSumClosest(const std::vector<int64_t>& lower, const std::vector<int64_t>& upper,
+                                  int64_t target)
+    {
+      int64_t closest = lower.front() + upper.back();
+      auto itLow = lower.begin();
+      auto itUp = upper.rbegin();
+      while (itLow != lower.end() && itUp != upper.rend())
+      {
+        const int64_t kSum = *itLow + *itUp;
+        const uint64_t kDistance = (kSum < target) ? static_cast<uint64_t>(target - kSum)
+                                                   : static_cast<uint64_t>(kSum - target);
+        const uint64_t kBestDistance = (closest < target) ? static_cast<uint64_t>(target - closest)
+                                                          : static_cast<uint64_t>(closest - target);
+        if (kDistance < kBestDistance || (kDistance == kBestDistance && kSum < closest))
+          closest = kSum;
+
+        if (kSum == target)
+          break;
+        if (kSum < target)
+          ++itLow;
+        else
+          ++itUp;
+      }
+
+      return closest;
+    }
+
+    /// @class MeetInTheMiddle
+    ///
+    /// Meet in the middle subset-sum solver: the elements are split into two halves whose 2^(n/2) subset
+    /// sums are enumerated (Gray code walk) then sorted (Raddix Sort). A query over the 2^n subsets becomes
+    /// a linear join of the two sorted halves.
+    ///
+    /// @advantages
+    /// - Handles up to ~50 elements where the 2^n enumeration of Combinations is out of reach.
+    /// - Once built, each query runs in O(2^(n/2)) without any allocation.
+    ///
+    /// @drawbacks
+    /// - Memory is O(2^(n/2)): 2^25 sums (256MB) per half for 50 elements.
+    /// - Sums must fit within 64 bits.
+    class MeetInTheMiddle
+    {
+    public:
+      /// MeetInTheMiddle constructor - Enumerate and sort the subset sums of each half.
+      ///
+      /// @tparam IT type using to go through the collection of integral values.
+      ///
+      /// @param begin,end iterators to the initial and final positions of the elements.
+      ///
+      /// @complexity O(2^(n/2) * n).
+      template <typename IT>
+      MeetInTheMiddle(const IT& begin, const IT& end)
+      {
+        auto middle = begin;
+        std::advance(middle, std::distance(begin, end) / 2);
+
+        this->lowerSums = SubsetSums(begin, middle);
+        this->upperSums = SubsetSums(middle, end);
+        SortSums(this->lowerSums);
+        SortSums(this->upperSums);
+      }
+
+      /// Exists - Whether a subset sums to target (the empty subset sums to 0).
+      bool Exists(int64_t target) const { return PairSumExists(this->lowerSums, this->upperSums, target); }
+
+      /// Count - Return the number of subsets summing to target (the empty subset sums to 0).
+      uint64_t Count(int64_t target) const { return PairSumCount(this->lowerSums, this->upperSums, target); }
+
+      /// Closest - Return the subset sum the closest to target, the smallest one on ties.
+      int64_t Closest(int64_t target) const
+      { return PairSumClosest(this->lowerSums, this->upperSums, target); }
+
+      const std::vector<int64_t>& LowerSums() const { return this->lowerSums; }
+      const std::vector<int64_t>& UpperSums() const { return this->upperSums; }
+
+    private:
+      std::vector<int64_t> lowerSums; // Sorted subset sums of the first half
+      std::vector<int64_t> upperSums; // Sorted subset sums of the second half
+    };
+  }
+}
+
+#endif // MODULE_COMBINATORY_SUBSET_SUM_HXX
@@ -0,0 +1,165 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#include <gtest/gtest.h>
+#include <csr_graph.hxx>
+#include "graph_fixtures.hxx"
+
+// STD includes
+#include <random>
+#include <vector>
+
+using namespace huc;
+
+#ifndef DOXYGEN_SKIP
+namespace {
+  typedef CSRGraph::Edge Edge;
+
+  // Whether the graph has the adjacency of the edge list, the arcs of each vertex in edge order
+  bool HasAdjacency(const CSRGraph& graph, const std::vector<Edge>& edges)
+  {
+    std::vector<std::vector<std::pair<CSRGraph::Vertex, CSRGraph::EdgeId>>> adjacency(graph.VertexCount());
+    for (CSRGraph::EdgeId edge = 0; edge < edges.size(); ++edge)
+    {
+      adjacency[edges[edge].first].push_back(std::make_pair(edges[edge].second, edge));
+      adjacency[edges[edge].second].push_back(std::make_pair(edges[edge].first, edge));
+    }
+
+    for (CSRGraph::Vertex vertex = 0; vertex < graph.VertexCount(); ++vertex)
+    {
+      std::vector<std::pair<CSRGraph::Vertex, CSRGraph::EdgeId>> arcs;
+      graph.ForEachNeighbour(vertex, [&](CSRGraph::Vertex neighbour, CSRGraph::EdgeId edge)
+      { arcs.push_back(std::make_pair(neighbour, edge)); });
+      if (arcs != adjacency[vertex] || graph.Degree(vertex) != arcs.size())
+        return false;
+    }
+    return true;
+  }
+}
+#endif /* DOXYGEN_SKIP */
+
+// Test CSRGraph Construction
+TEST(TestCSRGraph, build)
+{
+  // Unknown vertex - No Graph
+  {
+    EXPECT_EQ(nullptr, CSRGraph::Build(3, std::vector<Edge>(1, Edge(1, 3))));
+  }
+
+  // Empty graphs
+  {
+    auto graph = CSRGraph::Build(0, std::vector<Edge>());
+    ASSERT_NE(nullptr, graph);
+    EXPECT_EQ(0u, graph->VertexCount());
+    EXPECT_EQ(0u, graph->EdgeCount());
+    graph = CSRGraph::Build(5, std::vector<Edge>());
+    ASSERT_NE(nullptr, graph);
+    EXPECT_EQ(0u, graph->Degree(4));
+  }
+
+  // Small graph with isolated vertices, parallel edges and a self loop
+  {
+    std::vector<Edge> edges;
+    edges.push_back(Edge(4, 1));
+    edges.push_back(Edge(1, 4));
+    edges.push_back(Edge(2, 2));
+    edges.push_back(Edge(0, 4));
+    auto graph = CSRGraph::Build(6, edges, 1);
+    ASSERT_NE(nullptr, graph);
+    EXPECT_EQ(4u, graph->EdgeCount());
+    EXPECT_EQ(3u, graph->Degree(4));
+    EXPECT_EQ(2u, graph->Degree(2));
+    EXPECT_EQ(0u, graph->Degree(3));
+    EXPECT_EQ(0u, graph->Degree(5));
+    EXPECT_EQ(4u, graph->Other(0, 1));
+    EXPECT_TRUE(HasAdjacency(*graph, edges));
+  }
+
+  // Vertex ids spanning several radix digits, shuffled edge list
+  {
+    const uint32_t kVertexCount = 70000;
+    std::mt19937 mt(7);
+    std::vector<Edge> edges;
+    for (int i = 0; i < 50000; ++i)
+      edges.push_back(Edge(mt() % kVertexCount, mt() % kVertexCount));
+    auto graph = CSRGraph::Build(kVertexCount, edges, 1);
+    ASSERT_NE(nullptr, graph);
+    EXPECT_TRUE(HasAdjacency(*graph, edges));
+  }
+}
+
+// Test CSRGraph parallel construction
+TEST(TestCSRGraph, parallelBuild)
+{
+  // Same arrays whatever the number of threads
+  std::vector<Edge> edges;
+  AddHexEdges(edges, 150, 140);
+  auto sequential = CSRGraph::Build(150 * 140, edges, 1);
+  auto parallel = CSRGraph::Build(150 * 140, edges, 4);
+  ASSERT_NE(nullptr, sequential);
+  ASSERT_NE(nullptr, parallel);
+  EXPECT_TRUE(HasAdjacency(*parallel, edges));
+
+  const uint64_t kArcCount = 2 * static_cast<uint64_t>(edges.size());
+  EXPECT_EQ(kArcCount, parallel->OffsetsData()[parallel->VertexCount()]);
+  EXPECT_TRUE(std::equal(sequential->OffsetsData(), sequential->OffsetsData() + sequential->VertexCount() + 1,
+                         parallel->OffsetsData()));
+  EXPECT_TRUE(std::equal(sequential->TargetsData(), sequential->TargetsData() + kArcCount,
+                         parallel->TargetsData()));
+  EXPECT_TRUE(std::equal(sequential->ArcEdgesData(), sequential->ArcEdgesData() + kArcCount,
+                         parallel->ArcEdgesData()));
+
+  // Inner hexagonal cells have 6 neighbours
+  EXPECT_EQ(6u, parallel->Degree(70 + 70 * 150));
+}
+
+// Test CSRGraph active edges
+TEST(TestCSRGraph, activeEdges)
+{
+  std::vector<Edge> edges;
+  AddHexEdges(edges, 10, 7);
+  auto graph = CSRGraph::Build(70, edges);
+  ASSERT_NE(nullptr, graph);
+  EXPECT_EQ(0u, graph->ActiveCount());
+
+  const CSRGraph::Vertex kVertex = 3 + 3 * 10;
+  graph->ForEachNeighbour(kVertex, [&](CSRGraph::Vertex neighbour, CSRGraph::EdgeId edge)
+  {
+    if (neighbour > kVertex)
+      graph->SetActive(edge, true);
+  });
+  EXPECT_EQ(3u, graph->ActiveCount());
+
+  uint32_t count = 0;
+  graph->ForEachConnected(kVertex, [&](CSRGraph::Vertex neighbour, CSRGraph::EdgeId edge)
+  {
+    ++count;
+    EXPECT_GT(neighbour, kVertex);
+    EXPECT_TRUE(graph->IsActive(edge));
+  });
+  EXPECT_EQ(3u, count);
+
+  graph->SetActive(edges.size() - 1, true);
+  graph->SetActive(edges.size() - 1, false);
+  EXPECT_EQ(3u, graph->ActiveCount());
+  graph->SetAllActive(true);
+  EXPECT_EQ(edges.size(), graph->ActiveCount());
+  graph->SetAllActive(false);
+  EXPECT_EQ(0u, graph->ActiveCount());
+}
@@ -0,0 +1,228 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#include <gtest/gtest.h>
+#include <chunked_grid.hxx>
+#include <flat_grid.hxx>
+
+// STD includes
+#include <random>
+
+#if !defined(_WIN32)
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+using namespace huc;
+
+#ifndef DOXYGEN_SKIP
+namespace {
+  struct CellInfoValue
+  {
+    CellInfoValue() : value(0) {}
+    uint32_t value;
+  };
+
+  typedef ChunkedGrid<CellInfoValue> Chunked;
+  typedef Chunked::Point Point;
+
+  const uint32_t kSide = Chunked::kChunkSide;
+
+  // Whether the generator opens the border passage leaving (x, y) in the direction (East or South)
+  bool IsBorderOpen(uint32_t x, uint32_t y, GridDirection direction)
+  { return ((x * 2654435761u) ^ (y * 40503u) ^ direction) % 3 == 0; }
+
+  // Expected links of the generated cell (x, y): connected within its chunk, hashed passages on borders
+  uint8_t GeneratedLinks(uint32_t width, uint32_t height, uint32_t x, uint32_t y)
+  {
+    uint8_t links = 0;
+    if (x + 1 < width && ((x + 1) % kSide != 0 || IsBorderOpen(x, y, kEast))) links |= 1 << kEast;
+    if (y + 1 < height && ((y + 1) % kSide != 0 || IsBorderOpen(x, y, kSouth))) links |= 1 << kSouth;
+    if (x > 0 && (x % kSide != 0 || IsBorderOpen(x - 1, y, kEast))) links |= 1 << kWest;
+    if (y > 0 && (y % kSide != 0 || IsBorderOpen(x, y - 1, kSouth))) links |= 1 << kNorth;
+    return links;
+  }
+
+  // Generator of the chunks, writing the chunk coordinates within each cell info
+  Chunked::Generator MakeGenerator(uint32_t width, uint32_t height, uint32_t* generatedCount)
+  {
+    return [=](uint32_t chunkX, uint32_t chunkY, Chunked::Chunk& chunk)
+    {
+      ++*generatedCount;
+      for (uint32_t y = 0; y < kSide; ++y)
+        for (uint32_t x = 0; x < kSide; ++x)
+        {
+          const uint32_t kX = chunkX * kSide + x, kY = chunkY * kSide + y;
+          if (kX >= width || kY >= height)
+            continue;
+          chunk.links[y * kSide + x] = GeneratedLinks(width, height, kX, kY);
+          chunk.infos[y * kSide + x].value = chunkX ^ chunkY;
+        }
+    };
+  }
+}
+#endif /* DOXYGEN_SKIP */
+
+// Test ChunkedGrid lazy materialization
+TEST(TestChunkedGrid, materialization)
+{
+  // Unwritable spill file
+  {
+    EXPECT_EQ(nullptr, Chunked::Create(10, 10, nullptr, 4, "/nonexistent_dir/spill.bin"));
+  }
+
+#if !defined(_WIN32)
+  // Existing path which cannot be opened as spill file: left untouched
+  {
+    const std::string kDirPath = "TestChunkedGrid_dir";
+    struct stat status;
+    ASSERT_EQ(0, mkdir(kDirPath.c_str(), 0755));
+    EXPECT_EQ(nullptr, Chunked::Create(128, 128, nullptr, 4, kDirPath));
+    EXPECT_EQ(0, stat(kDirPath.c_str(), &status));
+    rmdir(kDirPath.c_str());
+  }
+#endif
+
+  // Only touched chunks are generated, whatever the size of the world
+  const uint32_t kWidth = 1u << 30, kHeight = (1u << 30) + 17;
+  uint32_t generatedCount = 0;
+  auto grid = Chunked::Create(kWidth, kHeight, MakeGenerator(kWidth, kHeight, &generatedCount), 8);
+  ASSERT_NE(nullptr, grid);
+  EXPECT_EQ(kWidth, grid->Width());
+  EXPECT_EQ(kHeight, grid->Height());
+  EXPECT_FALSE(grid->IsMaterialized(0, 0));
+  EXPECT_EQ(0u, grid->ResidentChunkCount());
+
+  const uint32_t kX = 1000 * kSide - 1, kY = 70000 * kSide - 1;
+  EXPECT_EQ(GeneratedLinks(kWidth, kHeight, kX, kY), grid->Links(kX, kY));
+  EXPECT_EQ(1u, generatedCount);
+  EXPECT_TRUE(grid->IsMaterialized(kX, kY));
+  EXPECT_FALSE(grid->IsMaterialized(kX + 1, kY));
+
+  // Border passages seen from both sides, and the last (partial) chunk
+  EXPECT_EQ(grid->IsConnected(kX, kY, kEast), grid->IsConnected(kX + 1, kY, kWest));
+  EXPECT_EQ(grid->IsConnected(kX, kY, kSouth), grid->IsConnected(kX, kY + 1, kNorth));
+  EXPECT_EQ(3u, generatedCount);
+  EXPECT_EQ(GeneratedLinks(kWidth, kHeight, kWidth - 1, kHeight - 1), grid->Links(kWidth - 1, kHeight - 1));
+  EXPECT_EQ(0u, grid->Links(kWidth - 1, kHeight - 1) & ((1 << kEast) | (1 << kSouth)));
+
+  // Connections follow the generated links
+  uint32_t count = 0;
+  grid->ForEachConnected(Point(kX, kY), [&](const Point& neighbour, GridDirection direction)
+  {
+    ++count;
+    EXPECT_TRUE(grid->IsConnected(neighbour.x, neighbour.y, OppositeDirection(direction)));
+  });
+  uint8_t links = grid->Links(kX, kY);
+  EXPECT_EQ(static_cast<uint32_t>((links & 1) + ((links >> 1) & 1) + ((links >> 2) & 1) + (links >> 3)), count);
+}
+
+// Test ChunkedGrid eviction and reload through the spill file
+TEST(TestChunkedGrid, spill)
+{
+  const uint32_t kWidth = 40 * kSide, kHeight = 40 * kSide;
+  const size_t kMaxResident = 3;
+  uint32_t generatedCount = 0;
+  auto grid = Chunked::Create(kWidth, kHeight, MakeGenerator(kWidth, kHeight, &generatedCount), kMaxResident);
+  ASSERT_NE(nullptr, grid);
+
+  // Modify cells on chunk borders all over the grid: infos and links on both sides of borders
+  std::mt19937 mt(42);
+  std::vector<Point> points;
+  for (int i = 0; i < 200; ++i)
+  {
+    const Point kPoint((mt() % 39 + 1) * kSide - 1, (mt() % 39 + 1) * kSide - 1 - (mt() % 2));
+    points.push_back(kPoint);
+    grid->Info(kPoint.x, kPoint.y).value = i + 1000;
+    grid->Connect(kPoint, Point(kPoint.x + 1, kPoint.y));
+    grid->Disconnect(kPoint, Point(kPoint.x, kPoint.y + 1));
+    EXPECT_LE(grid->ResidentChunkCount(), kMaxResident);
+  }
+  EXPECT_GT(grid->SpilledChunkCount(), 0u);
+  const uint32_t kGeneratedCount = generatedCount;
+
+  // Touch the points in another order: spilled chunks are reloaded, not generated again
+  for (int i = 199; i >= 0; --i)
+  {
+    const Point& kPoint = points[i];
+    bool isLastWrite = true;
+    for (int j = i + 1; j < 200; ++j)
+      isLastWrite = isLastWrite && !(points[j].x == kPoint.x && points[j].y == kPoint.y);
+    if (isLastWrite)
+    {
+      EXPECT_EQ(static_cast<uint32_t>(i + 1000), grid->Info(kPoint.x, kPoint.y).value);
+    }
+    EXPECT_TRUE(grid->IsConnected(kPoint.x, kPoint.y, kEast));
+    EXPECT_TRUE(grid->IsConnected(kPoint.x + 1, kPoint.y, kWest));
+    EXPECT_FALSE(grid->IsConnected(kPoint.x, kPoint.y, kSouth));
+    EXPECT_FALSE(grid->IsConnected(kPoint.x, kPoint.y + 1, kNorth));
+  }
+  EXPECT_EQ(kGeneratedCount, generatedCount);
+  EXPECT_EQ(0u, grid->SpillErrorCount());
+
+  // Untouched cells of reloaded chunks keep their generated state
+  const Point kPoint = points.front();
+  EXPECT_EQ(GeneratedLinks(kWidth, kHeight, kPoint.x - 5, kPoint.y - 5), grid->Links(kPoint.x - 5, kPoint.y - 5));
+}
+
+// Test ChunkedGrid walls: same semantics as FlatGrid across chunks
+TEST(TestChunkedGrid, walls)
+{
+  const uint32_t kWidth = 3 * kSide + 5, kHeight = 2 * kSide + 9;
+  const std::string kSpillPath = "TestChunkedGrid_spill.bin";
+  auto grid = Chunked::Create(kWidth, kHeight, [=](uint32_t chunkX, uint32_t chunkY, Chunked::Chunk& chunk)
+  {
+    for (uint32_t y = 0; y < kSide; ++y)
+      for (uint32_t x = 0; x < kSide; ++x)
+        chunk.links[y * kSide + x] = GeneratedLinks(kWidth, kHeight, chunkX * kSide + x, chunkY * kSide + y);
+  }, 2, kSpillPath);
+  ASSERT_NE(nullptr, grid);
+
+  // Fully connected reference with the same border passages
+  FlatGrid<CellInfoValue> flatGrid(kWidth, kHeight);
+  for (uint32_t y = 0; y < kHeight; ++y)
+    for (uint32_t x = 0; x < kWidth; ++x)
+    {
+      if (GeneratedLinks(kWidth, kHeight, x, y) & (1 << kEast)) flatGrid.Connect(Point(x, y), Point(x + 1, y));
+      if (GeneratedLinks(kWidth, kHeight, x, y) & (1 << kSouth)) flatGrid.Connect(Point(x, y), Point(x, y + 1));
+    }
+
+  // Walls crossing chunk borders, cut at the grid border, with and without doors
+  const Point kOrigin(kSide - 10, kSide / 2);
+  grid->DisconnectRow(kOrigin, kSide / 2, 2 * kSide + 40, 20);
+  grid->DisconnectCol(kOrigin, 9, kHeight, kHeight);
+  grid->DisconnectCol(Point(kWidth - 1, 0), 0, kHeight, 0);
+  grid->Connect(Point(0, 0), std::vector<Point>(1, Point(0, 1)));
+  flatGrid.DisconnectRow(kOrigin, kSide / 2, 2 * kSide + 40, 20);
+  flatGrid.DisconnectCol(kOrigin, 9, kHeight, kHeight);
+  flatGrid.DisconnectCol(Point(kWidth - 1, 0), 0, kHeight, 0);
+  flatGrid.Connect(Point(0, 0), std::vector<Point>(1, Point(0, 1)));
+
+  bool isSame = true;
+  for (uint32_t y = 0; y < kHeight; ++y)
+    for (uint32_t x = 0; x < kWidth; ++x)
+      isSame = isSame && grid->Links(x, y) == flatGrid.Links(flatGrid.IndexOf(x, y));
+  EXPECT_TRUE(isSame);
+  EXPECT_LE(grid->ResidentChunkCount(), 2u);
+  EXPECT_EQ(0u, grid->SpillErrorCount());
+
+  // The spill file is removed with the grid
+  grid.reset();
+  EXPECT_EQ(nullptr, std::fopen(kSpillPath.c_str(), "rb"));
+}
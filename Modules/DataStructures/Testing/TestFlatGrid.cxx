@@ -0,0 +1,147 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#include <gtest/gtest.h>
+#include <flat_grid.hxx>
+
+// STD includes
+#include <random>
+
+using namespace huc;
+
+#ifndef DOXYGEN_SKIP
+namespace {
+  // Number of connections within a mask
+  uint32_t PopCount(uint8_t mask) { return (mask & 1) + ((mask >> 1) & 1) + ((mask >> 2) & 1) + (mask >> 3); }
+
+  // Whether the flat grid has the same connections as the grid
+  template <typename CellInfo>
+  bool HasSameConnections(const Grid<CellInfo>& grid, const FlatGrid<CellInfo>& flatGrid)
+  {
+    typedef typename FlatGrid<CellInfo>::Point Point;
+    for (uint32_t x = 0; x < grid.Width(); ++x)
+      for (uint32_t y = 0; y < grid.Height(); ++y)
+      {
+        const auto& kConnected = grid[x][y]->connectedCells;
+        uint32_t count = 0;
+        for (auto it = kConnected.begin(); it != kConnected.end(); ++it, ++count)
+          if (!flatGrid.IsConnected(Point(x, y), Point(it->lock()->x, it->lock()->y)))
+            return false;
+        if (count != PopCount(flatGrid.Links(flatGrid.IndexOf(x, y))))
+          return false;
+      }
+    return true;
+  }
+}
+#endif /* DOXYGEN_SKIP */
+
+// Test FlatGrid Construction
+TEST(TestFlatGrid, build)
+{
+  // Empty Grid
+  {
+    FlatGrid<> grid(0, 0, true);
+    EXPECT_EQ(0u, grid.Width());
+    EXPECT_EQ(0u, grid.Height());
+    EXPECT_EQ(0u, grid.Size());
+  }
+
+  // Disconnected and connected grids match the Grid ones
+  for (int isConnected = 0; isConnected < 2; ++isConnected)
+  {
+    Grid<> grid(7, 5, isConnected != 0);
+    FlatGrid<> flatGrid(7, 5, isConnected != 0);
+    EXPECT_EQ(35u, flatGrid.Size());
+    EXPECT_TRUE(HasSameConnections(grid, flatGrid));
+  }
+
+  // Index and point mapping
+  FlatGrid<> grid(7, 5);
+  for (FlatGrid<>::Index index = 0; index < grid.Size(); ++index)
+  {
+    const auto kPoint = grid.PointOf(index);
+    EXPECT_EQ(index, grid.IndexOf(kPoint));
+  }
+}
+
+// Test connections against Grid
+TEST(TestFlatGrid, connections)
+{
+  typedef FlatGrid<>::Point Point;
+  Grid<> grid(9, 6);
+  FlatGrid<> flatGrid(9, 6);
+
+  // Connect a row, a column and a star
+  std::vector<std::shared_ptr<Grid<>::Cell>> neighbours = {grid[3][2], grid[5][2], grid[4][1], grid[4][3]};
+  grid.Connect(grid[4][2], neighbours);
+  flatGrid.Connect(Point(4, 2), {Point(3, 2), Point(5, 2), Point(4, 1), Point(4, 3)});
+  for (uint32_t x = 0; x + 1 < 9; ++x)
+  {
+    grid.Connect(grid[x][0], grid[x + 1][0]);
+    flatGrid.Connect(Point(x, 0), Point(x + 1, 0));
+  }
+  EXPECT_TRUE(HasSameConnections(grid, flatGrid));
+  EXPECT_EQ(0x0F, flatGrid.Links(flatGrid.IndexOf(4, 2)));
+  EXPECT_TRUE(flatGrid.IsConnected(flatGrid.IndexOf(4, 2), kNorth));
+
+  // Non neighbours are ignored
+  flatGrid.Connect(Point(0, 0), Point(2, 2));
+  flatGrid.Connect(Point(8, 5), Point(9, 5));
+  EXPECT_TRUE(HasSameConnections(grid, flatGrid));
+
+  grid.Disconnect(grid[4][2], grid[4][1]);
+  flatGrid.Disconnect(Point(4, 1), Point(4, 2));
+  EXPECT_TRUE(HasSameConnections(grid, flatGrid));
+
+  // Connected neighbours enumeration
+  std::vector<FlatGrid<>::Index> connected;
+  flatGrid.ForEachConnected(flatGrid.IndexOf(4, 2),
+                            [&](FlatGrid<>::Index index, GridDirection) { connected.push_back(index); });
+  const std::vector<FlatGrid<>::Index> kExpected =
+    {flatGrid.IndexOf(5, 2), flatGrid.IndexOf(4, 3), flatGrid.IndexOf(3, 2)};
+  EXPECT_EQ(kExpected, connected);
+}
+
+// Test walls building against Grid
+TEST(TestFlatGrid, walls)
+{
+  std::mt19937 mt(92);
+  for (int iteration = 0; iteration < 50; ++iteration)
+  {
+    const uint32_t kWidth = 1 + mt() % 12, kHeight = 1 + mt() % 12;
+    Grid<> grid(kWidth, kHeight, true);
+    FlatGrid<> flatGrid(kWidth, kHeight, true);
+    for (int wall = 0; wall < 10; ++wall)
+    {
+      const Grid<>::Point kOrigin(mt() % (kWidth + 1), mt() % (kHeight + 1));
+      const uint32_t kIdx = mt() % 12, kSize = mt() % 14, kPathIdx = mt() % 14;
+      if (mt() % 2)
+      {
+        grid.DisconnectRow(kOrigin, kIdx, kSize, kPathIdx);
+        flatGrid.DisconnectRow(kOrigin, kIdx, kSize, kPathIdx);
+      }
+      else
+      {
+        grid.DisconnectCol(kOrigin, kIdx, kSize, kPathIdx);
+        flatGrid.DisconnectCol(kOrigin, kIdx, kSize, kPathIdx);
+      }
+    }
+    EXPECT_TRUE(HasSameConnections(grid, flatGrid));
+  }
+}
@@ -0,0 +1,141 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#include <gtest/gtest.h>
+#include <flat_hash_counter.hxx>
+
+// STD includes
+#include <string>
+
+using namespace huc;
+
+#ifndef DOXYGEN_SKIP
+namespace {
+  // Simple random array of integers with negative values
+  const int RandomArrayInt[] = {4, 3, 5, 2, -18, 3, 2, 3, 4, 5, -5};
+
+  typedef FlatHashCounter<int> Counter;
+
+  // Key comparisons performed by the counter, i.e. the length of the probing sequences
+  uint64_t comparisonCount = 0;
+  struct CountingEqual
+  {
+    bool operator()(uint64_t a, uint64_t b) const { ++comparisonCount; return a == b; }
+  };
+}
+#endif /* DOXYGEN_SKIP */
+
+// Test counting
+TEST(TestFlatHashCounter, Count)
+{
+  // Empty counter
+  {
+    Counter counter;
+    EXPECT_EQ(0, counter.Size());
+    EXPECT_EQ(0, counter.Count(4));
+    EXPECT_FALSE(counter.Consume(4));
+  }
+
+  // Normal run with duplicates
+  {
+    Counter counter;
+    for (auto it = std::begin(RandomArrayInt); it != std::end(RandomArrayInt); ++it)
+      counter.Add(*it);
+
+    EXPECT_EQ(6, counter.Size());
+    EXPECT_EQ(3, counter.Count(3));
+    EXPECT_EQ(2, counter.Count(4));
+    EXPECT_EQ(1, counter.Count(-18));
+    EXPECT_EQ(0, counter.Count(0));
+  }
+
+  // Consume occurrences until none is left - key keeps existing with a null count
+  {
+    Counter counter;
+    EXPECT_EQ(2, counter.Add(7, 2));
+    EXPECT_TRUE(counter.Consume(7));
+    EXPECT_TRUE(counter.Consume(7));
+    EXPECT_FALSE(counter.Consume(7));
+    EXPECT_EQ(0, counter.Count(7));
+    EXPECT_EQ(1, counter.Size());
+  }
+
+  // Strings
+  {
+    FlatHashCounter<std::string> counter;
+    counter.Add("maze");
+    counter.Add("grid");
+    counter.Add("maze");
+    EXPECT_EQ(2, counter.Count("maze"));
+    EXPECT_EQ(1, counter.Count("grid"));
+    EXPECT_EQ(0, counter.Count("tree"));
+  }
+}
+
+// Test growing and clearing
+TEST(TestFlatHashCounter, Capacity)
+{
+  // Growing far above the initial capacity keeps every count
+  {
+    Counter counter;
+    for (int i = 0; i < 10000; ++i)
+      counter.Add(i * 16, (i % 3) + 1);
+
+    EXPECT_EQ(10000, counter.Size());
+    EXPECT_GE(counter.Capacity(), 2 * counter.Size());
+    for (int i = 0; i < 10000; ++i)
+      EXPECT_EQ((i % 3) + 1, counter.Count(i * 16));
+  }
+
+  // ForEach visits each key once and Clear removes them all
+  {
+    Counter counter(100);
+    const auto kCapacity = counter.Capacity();
+    for (int i = 0; i < 100; ++i)
+      counter.Add(i, 2);
+
+    size_t total = 0;
+    counter.ForEach([&total](const int, size_t count) { total += count; });
+    EXPECT_EQ(200, total);
+    EXPECT_EQ(kCapacity, counter.Capacity());
+
+    counter.Clear();
+    EXPECT_EQ(0, counter.Size());
+    EXPECT_EQ(0, counter.Count(42));
+  }
+}
+
+// Test keys differing only by their high bits (std::hash is the identity on integers)
+TEST(TestFlatHashCounter, HighBitKeys)
+{
+  const uint64_t kCount = 32768;
+  for (uint32_t shift = 32; shift <= 48; shift += 8)
+  {
+    FlatHashCounter<uint64_t, std::hash<uint64_t>, CountingEqual> counter;
+    comparisonCount = 0;
+    for (uint64_t i = 0; i < kCount; ++i)
+      counter.Add(i << shift);
+
+    // Short probing sequences: a handful of comparisons per key, not one per key already inserted
+    EXPECT_EQ(kCount, counter.Size());
+    EXPECT_LT(comparisonCount, 8 * kCount);
+    for (uint64_t i = 0; i < kCount; i += 97)
+      EXPECT_EQ(1u, counter.Count(i << shift));
+  }
+}
@@ -19,6 +19,7 @@
  *=========================================================================================================*/
 #include <gtest/gtest.h>
 #include <grid.hxx>
+#include <node_pool.hxx>
 
 #include <functional>
 #include <list>
@@ -63,4 +64,53 @@ TEST(TestGrid, build)
   }
 }
 
+// Test Grid with pooled cells and connections
+TEST(TestGrid, poolAllocator)
+{
+  typedef Grid<CellInfoBase, PoolAllocator> PooledGrid;
+
+  // Same connections as the default grid
+  PooledGrid grid(50, 40, true);
+  Grid<CellInfoBase> reference(50, 40, true);
+  EXPECT_EQ(grid.Width(), 50);
+  EXPECT_EQ(grid.Height(), 40);
+  bool isSame = true;
+  for (uint32_t x = 0; x < grid.Width(); ++x)
+    for (uint32_t y = 0; y < grid.Height(); ++y)
+      isSame = isSame && grid[x][y]->x == x && grid[x][y]->y == y &&
+               grid[x][y]->connectedCells.size() == reference[x][y]->connectedCells.size();
+  EXPECT_TRUE(isSame);
+
+  // Cells, control blocks and connections fill a few blocks of the grid pool
+  const auto& kPool = grid.GetAllocator().Pool();
+  EXPECT_LT(kPool->BlockCount(), 100u);
+  EXPECT_TRUE(grid[0][0]->connectedCells.get_allocator() == grid.GetAllocator());
+
+  // Disconnecting and reconnecting reuse the released nodes
+  const size_t kBlockCount = kPool->BlockCount();
+  grid.DisconnectRow(PooledGrid::Point(0, 0), 10, 50, 50);
+  grid.DisconnectCol(PooledGrid::Point(0, 0), 20, 40, 40);
+  EXPECT_EQ(2u, grid[20][10]->connectedCells.size());
+  for (uint32_t x = 0; x < 50; ++x)
+    grid.Connect(grid[x][10], grid[x][11]);
+  for (uint32_t y = 0; y < 40; ++y)
+    grid.Connect(grid[20][y], grid[21][y]);
+  EXPECT_EQ(4u, grid[20][10]->connectedCells.size());
+  EXPECT_EQ(kBlockCount, kPool->BlockCount());
+}
+
+// Test Grid cells outliving a pooled grid
+TEST(TestGrid, poolLifetime)
+{
+  std::shared_ptr<Grid<CellInfoBase, PoolAllocator>::Cell> cell;
+  {
+    Grid<CellInfoBase, PoolAllocator> grid(10, 10, true);
+    cell = grid[5][5];
+  }
+  EXPECT_EQ(5u, cell->x);
+  EXPECT_EQ(4u, cell->connectedCells.size());
+  for (auto it = cell->connectedCells.begin(); it != cell->connectedCells.end(); ++it)
+    EXPECT_TRUE(it->expired());
+}
+
 // TODO Complete UTs for all API!
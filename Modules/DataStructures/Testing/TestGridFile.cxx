@@ -0,0 +1,170 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#include <gtest/gtest.h>
+#include <grid_file.hxx>
+
+// STD includes
+#include <cstddef>
+#include <random>
+
+using namespace huc;
+
+#ifndef DOXYGEN_SKIP
+namespace {
+  struct CellInfoValue : CellInfoBase
+  { uint32_t value; };
+
+  typedef FlatGrid<CellInfoValue> ValueGrid;
+
+  const std::string kPath = "TestGridFile.grid";
+
+  // Grid randomly connected, with a distinct value per cell
+  std::unique_ptr<ValueGrid> RandomGrid(uint32_t width, uint32_t height, uint32_t seed)
+  {
+    std::unique_ptr<ValueGrid> grid(new ValueGrid(width, height));
+    std::mt19937 mt(seed);
+    for (ValueGrid::Index index = 0; index < grid->Size(); ++index)
+    {
+      grid->Info(index).value = static_cast<uint32_t>(index * 7 + 1);
+      if (grid->HasNeighbour(index, kEast) && mt() % 2)
+        grid->Connect(index, kEast);
+      if (grid->HasNeighbour(index, kSouth) && mt() % 2)
+        grid->Connect(index, kSouth);
+    }
+    return grid;
+  }
+
+  // Overwrite a field of the header of the file at kPath
+  template <typename T>
+  void PatchHeader(size_t offset, T value)
+  {
+    std::FILE* file = std::fopen(kPath.c_str(), "r+b");
+    ASSERT_TRUE(file != nullptr);
+    std::fseek(file, static_cast<long>(offset), SEEK_SET);
+    std::fwrite(&value, sizeof(value), 1, file);
+    std::fclose(file);
+  }
+}
+#endif /* DOXYGEN_SKIP */
+
+// Test saving and mapping grids
+TEST(TestGridFile, saveAndMap)
+{
+  const uint32_t kDimensions[][2] = {{0, 0}, {1, 1}, {3, 5}, {4, 4}, {17, 9}, {64, 3}};
+  for (auto dimensions : kDimensions)
+    for (int withInfos = 0; withInfos < 2; ++withInfos)
+    {
+      const auto kGrid = RandomGrid(dimensions[0], dimensions[1], dimensions[0] + dimensions[1]);
+      ASSERT_TRUE(SaveGrid(*kGrid, kPath, 6, 1234567890123ull, withInfos != 0, 42));
+
+      auto mapped = MappedGrid<CellInfoValue>::Open(kPath, 42);
+      ASSERT_TRUE(mapped != nullptr);
+      EXPECT_EQ(kGrid->Width(), mapped->Width());
+      EXPECT_EQ(kGrid->Height(), mapped->Height());
+      EXPECT_EQ(6u, mapped->GeneratorId());
+      EXPECT_EQ(1234567890123ull, mapped->Seed());
+      EXPECT_EQ(withInfos != 0, mapped->HasInfos());
+
+      for (uint32_t y = 0; y < kGrid->Height(); ++y)
+        for (uint32_t x = 0; x < kGrid->Width(); ++x)
+        {
+          EXPECT_EQ(kGrid->Links(kGrid->IndexOf(x, y)), mapped->Links(x, y));
+          if (withInfos)
+          {
+            EXPECT_EQ(kGrid->Info(kGrid->IndexOf(x, y)).value, mapped->Info(kGrid->IndexOf(x, y)).value);
+          }
+        }
+
+      const auto kLoaded = mapped->ToFlatGrid();
+      if (kGrid->Size() > 0)
+      {
+        EXPECT_EQ(0, std::memcmp(kGrid->LinksData(), kLoaded->LinksData(), static_cast<size_t>(kGrid->Size())));
+      }
+
+      // Loading within another layout keeps the cells
+      const auto kMorton = mapped->ToFlatGrid<MortonLayout>();
+      for (uint32_t y = 0; y < kGrid->Height(); ++y)
+        for (uint32_t x = 0; x < kGrid->Width(); ++x)
+        {
+          EXPECT_EQ(kGrid->Links(kGrid->IndexOf(x, y)), kMorton->Links(kMorton->IndexOf(x, y)));
+        }
+      mapped.reset();
+      std::remove(kPath.c_str());
+    }
+}
+
+// Test streaming writes and invalid files
+TEST(TestGridFile, invalid)
+{
+  // Missing file
+  EXPECT_TRUE(MappedGrid<>::Open("TestGridFile.missing") == nullptr);
+
+  // Rows missing or in excess, infos expected or not
+  {
+    const std::vector<uint8_t> kRow(5, 0x0F);
+    const std::vector<CellInfoValue> kInfos(5);
+    auto writer = GridFileWriter<CellInfoValue>::Open(kPath, 5, 2, 0, 0, true);
+    ASSERT_TRUE(writer != nullptr);
+    EXPECT_FALSE(writer->WriteRow(kRow.data()));
+    EXPECT_TRUE(writer->WriteRow(kRow.data(), kInfos.data()));
+    EXPECT_FALSE(writer->Close());
+    EXPECT_TRUE(MappedGrid<CellInfoValue>::Open(kPath) == nullptr);
+
+    writer = GridFileWriter<CellInfoValue>::Open(kPath, 5, 2, 0, 0, false);
+    EXPECT_FALSE(writer->WriteRow(kRow.data(), kInfos.data()));
+    EXPECT_TRUE(writer->WriteRow(kRow.data()));
+    EXPECT_TRUE(writer->WriteRow(kRow.data()));
+    EXPECT_FALSE(writer->WriteRow(kRow.data()));
+    EXPECT_TRUE(writer->Close());
+    EXPECT_TRUE(MappedGrid<CellInfoValue>::Open(kPath) != nullptr);
+  }
+
+  // CellInfo layout mismatch
+  const auto kGrid = RandomGrid(8, 8, 93);
+  ASSERT_TRUE(SaveGrid(*kGrid, kPath, 0, 0, true, 1));
+  EXPECT_TRUE(MappedGrid<CellInfoValue>::Open(kPath, 2) == nullptr);
+  EXPECT_TRUE(MappedGrid<CellInfoBase>::Open(kPath, 1) == nullptr);
+  EXPECT_TRUE(MappedGrid<CellInfoValue>::Open(kPath, 1) != nullptr);
+
+  // Corrupted offsets and dimensions, whose sections would wrap around past the end of the file
+  const uint64_t kWrappedOffset = ~uint64_t(63);
+  PatchHeader(offsetof(GridFileHeader, infosOffset), kWrappedOffset);
+  EXPECT_TRUE(MappedGrid<CellInfoValue>::Open(kPath, 1) == nullptr);
+  ASSERT_TRUE(SaveGrid(*kGrid, kPath, 0, 0, true, 1));
+  PatchHeader(offsetof(GridFileHeader, width), uint32_t(1) << 31);
+  PatchHeader(offsetof(GridFileHeader, height), uint32_t(1) << 31);
+  EXPECT_TRUE(MappedGrid<CellInfoValue>::Open(kPath, 1) == nullptr);
+  ASSERT_TRUE(SaveGrid(*kGrid, kPath, 0, 0, false));
+  PatchHeader(offsetof(GridFileHeader, linksOffset), kWrappedOffset);
+  EXPECT_TRUE(MappedGrid<CellInfoValue>::Open(kPath) == nullptr);
+  PatchHeader(offsetof(GridFileHeader, linksOffset), uint64_t(sizeof(GridFileHeader) + 8));
+  EXPECT_TRUE(MappedGrid<CellInfoValue>::Open(kPath) == nullptr);
+  PatchHeader(offsetof(GridFileHeader, linksOffset), uint64_t(sizeof(GridFileHeader)));
+  EXPECT_TRUE(MappedGrid<CellInfoValue>::Open(kPath) != nullptr);
+  ASSERT_TRUE(SaveGrid(*kGrid, kPath, 0, 0, true, 1));
+
+  // Corrupted magic
+  std::FILE* file = std::fopen(kPath.c_str(), "r+b");
+  ASSERT_TRUE(file != nullptr);
+  std::fputc('X', file);
+  std::fclose(file);
+  EXPECT_TRUE(MappedGrid<CellInfoValue>::Open(kPath, 1) == nullptr);
+  std::remove(kPath.c_str());
+}
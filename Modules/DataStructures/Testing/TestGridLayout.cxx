@@ -0,0 +1,132 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#include <gtest/gtest.h>
+#include <flat_grid.hxx>
+
+// STD includes
+#include <random>
+#include <vector>
+
+using namespace huc;
+
+#ifndef DOXYGEN_SKIP
+namespace {
+  const uint32_t kDimensions[][2] =
+    {{0, 0}, {1, 1}, {1, 9}, {9, 1}, {7, 5}, {8, 8}, {13, 40}, {65, 17}, {100, 3}, {2, 100}};
+
+  // Check the mapping of the layout is a bijection and its neighbours are the ones of the coordinates
+  template <typename Layout>
+  void CheckLayout(uint32_t width, uint32_t height)
+  {
+    const Layout kLayout(width, height);
+    EXPECT_GE(kLayout.Capacity(), static_cast<uint64_t>(width) * height);
+    EXPECT_LE(kLayout.Capacity(), 4 * static_cast<uint64_t>(width) * height + 256);
+
+    std::vector<uint8_t> used(static_cast<size_t>(kLayout.Capacity()), 0);
+    for (uint32_t y = 0; y < height; ++y)
+      for (uint32_t x = 0; x < width; ++x)
+      {
+        const uint64_t kIndex = kLayout.IndexOf(x, y);
+        ASSERT_LT(kIndex, kLayout.Capacity());
+        EXPECT_EQ(0, used[kIndex]);
+        used[kIndex] = 1;
+
+        uint32_t px, py;
+        kLayout.PointOf(kIndex, px, py);
+        EXPECT_EQ(x, px);
+        EXPECT_EQ(y, py);
+
+        if (y > 0) { EXPECT_EQ(kLayout.IndexOf(x, y - 1), kLayout.Neighbour(kIndex, kNorth)); }
+        if (x + 1 < width) { EXPECT_EQ(kLayout.IndexOf(x + 1, y), kLayout.Neighbour(kIndex, kEast)); }
+        if (y + 1 < height) { EXPECT_EQ(kLayout.IndexOf(x, y + 1), kLayout.Neighbour(kIndex, kSouth)); }
+        if (x > 0) { EXPECT_EQ(kLayout.IndexOf(x - 1, y), kLayout.Neighbour(kIndex, kWest)); }
+      }
+  }
+
+  // Carve the same random walls within a grid, return the connections of each (x, y) in row-major order
+  template <typename Layout>
+  std::vector<uint8_t> RandomConnections(uint32_t width, uint32_t height, uint32_t seed)
+  {
+    typedef FlatGrid<CellInfoBase, Layout> LayoutGrid;
+    LayoutGrid grid(width, height, true);
+    std::mt19937 mt(seed);
+    for (int wall = 0; wall < 20; ++wall)
+    {
+      const typename LayoutGrid::Point kOrigin(mt() % (width + 1), mt() % (height + 1));
+      if (mt() % 2)
+        grid.DisconnectRow(kOrigin, mt() % 10, mt() % 20, mt() % 20);
+      else
+        grid.DisconnectCol(kOrigin, mt() % 10, mt() % 20, mt() % 20);
+    }
+
+    std::vector<uint8_t> connections;
+    for (uint32_t y = 0; y < height; ++y)
+      for (uint32_t x = 0; x < width; ++x)
+      {
+        // Neighbours enumerated through the layout agree with the connection mask
+        uint8_t links = 0;
+        grid.ForEachConnected(grid.IndexOf(x, y), [&](uint64_t neighbour, GridDirection direction)
+        {
+          links |= static_cast<uint8_t>(1 << direction);
+          EXPECT_EQ(grid.IndexOf(x, y), grid.Neighbour(neighbour, OppositeDirection(direction)));
+        });
+        EXPECT_EQ(grid.Links(grid.IndexOf(x, y)), links);
+        connections.push_back(links);
+      }
+    return connections;
+  }
+}
+#endif /* DOXYGEN_SKIP */
+
+// Test the index mappings of the layouts
+TEST(TestGridLayout, mapping)
+{
+  for (auto dimensions : kDimensions)
+  {
+    CheckLayout<RowMajorLayout>(dimensions[0], dimensions[1]);
+    CheckLayout<ColumnMajorLayout>(dimensions[0], dimensions[1]);
+    CheckLayout<TiledLayout<>>(dimensions[0], dimensions[1]);
+    CheckLayout<TiledLayout<2>>(dimensions[0], dimensions[1]);
+    CheckLayout<MortonLayout>(dimensions[0], dimensions[1]);
+  }
+
+  // Tiles of 8 x 8 cells are contiguous
+  const TiledLayout<> kTiled(20, 20);
+  EXPECT_EQ(63u, kTiled.IndexOf(7, 7));
+  EXPECT_EQ(64u, kTiled.IndexOf(8, 0));
+
+  // Morton order on a square
+  const MortonLayout kMorton(4, 4);
+  EXPECT_EQ(3u, kMorton.IndexOf(1, 1));
+  EXPECT_EQ(4u, kMorton.IndexOf(2, 0));
+  EXPECT_EQ(15u, kMorton.IndexOf(3, 3));
+}
+
+// Test grids behave the same whatever their layout
+TEST(TestGridLayout, flatGrid)
+{
+  for (auto dimensions : kDimensions)
+  {
+    const auto kExpected = RandomConnections<RowMajorLayout>(dimensions[0], dimensions[1], 94);
+    EXPECT_EQ(kExpected, RandomConnections<ColumnMajorLayout>(dimensions[0], dimensions[1], 94));
+    EXPECT_EQ(kExpected, RandomConnections<TiledLayout<>>(dimensions[0], dimensions[1], 94));
+    EXPECT_EQ(kExpected, RandomConnections<MortonLayout>(dimensions[0], dimensions[1], 94));
+  }
+}
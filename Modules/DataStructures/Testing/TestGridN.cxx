@@ -0,0 +1,159 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#include <gtest/gtest.h>
+#include <flat_grid.hxx>
+#include <grid_n.hxx>
+
+using namespace huc;
+
+#ifndef DOXYGEN_SKIP
+namespace {
+  typedef GridN<2> Grid2;
+  typedef GridN<3> Grid3;
+
+  // The direction table is resolved at compile time
+  static_assert(Grid3::Axis(5) == 2 && Grid3::IsForward(5) && Grid3::Opposite(5) == 4, "Direction table");
+  static_assert(Grid3::Unit(2, 1) == -1 && Grid3::Unit(3, 1) == 1 && Grid3::Unit(3, 0) == 0, "Unit vectors");
+  static_assert(Grid3::AllLinks() == 0x3F && sizeof(Grid3::Mask) == 1, "3D masks");
+  static_assert(GridN<6>::AllLinks() == 0x0FFF && sizeof(GridN<6>::Mask) == 2, "6D masks");
+
+  // FlatGrid direction of each 2D direction
+  const GridDirection kFlatDirections[4] = { kWest, kEast, kNorth, kSouth };
+
+  // Whether the 2D grid has the connections of the flat grid
+  bool IsSameGrid(const Grid2& grid, const FlatGrid<>& flatGrid)
+  {
+    for (uint32_t y = 0; y < flatGrid.Height(); ++y)
+      for (uint32_t x = 0; x < flatGrid.Width(); ++x)
+        for (Grid2::Direction direction = 0; direction < 4; ++direction)
+        {
+          const Grid2::Coordinates kPoint = {{ x, y }};
+          if (grid.IsConnected(grid.IndexOf(kPoint), direction) !=
+              flatGrid.IsConnected(flatGrid.IndexOf(x, y), kFlatDirections[direction]))
+            return false;
+        }
+    return true;
+  }
+}
+#endif /* DOXYGEN_SKIP */
+
+// Test GridN Construction
+TEST(TestGridN, build)
+{
+  // Empty Grid
+  {
+    const Grid3::Coordinates kExtents = {{ 4, 0, 3 }};
+    Grid3 grid(kExtents, true);
+    EXPECT_EQ(0u, grid.Size());
+  }
+
+  // Index and coordinates mapping, axis 0 varying first
+  const Grid3::Coordinates kExtents = {{ 4, 3, 5 }};
+  Grid3 grid(kExtents);
+  EXPECT_EQ(60u, grid.Size());
+  EXPECT_EQ(12u, grid.Stride(2));
+  for (Grid3::Index index = 0; index < grid.Size(); ++index)
+  {
+    const auto kCoordinates = grid.CoordinatesOf(index);
+    EXPECT_EQ(index, grid.IndexOf(kCoordinates));
+    EXPECT_TRUE(grid.Contains(kCoordinates));
+    EXPECT_EQ(0u, grid.Links(index));
+  }
+  const Grid3::Coordinates kOutside = {{ 4, 0, 0 }};
+  EXPECT_FALSE(grid.Contains(kOutside));
+
+  // Connected grids match the FlatGrid ones, 3D cells have up to 6 neighbours
+  EXPECT_TRUE(IsSameGrid(Grid2(Grid2::Coordinates{{ 7, 5 }}, true), FlatGrid<>(7, 5, true)));
+  Grid3 connected(kExtents, true);
+  const Grid3::Coordinates kInner = {{ 1, 1, 1 }}, kCorner = {{ 3, 2, 4 }};
+  EXPECT_EQ(Grid3::AllLinks(), connected.Links(connected.IndexOf(kInner)));
+  EXPECT_EQ(0x15u, connected.Links(connected.IndexOf(kCorner)));
+}
+
+// Test GridN connections
+TEST(TestGridN, connect)
+{
+  const Grid3::Coordinates kExtents = {{ 4, 3, 5 }};
+  Grid3 grid(kExtents);
+  const Grid3::Coordinates kFirst = {{ 1, 2, 3 }}, kUp = {{ 1, 2, 4 }}, kFar = {{ 1, 2, 1 }};
+
+  // Neighbours through the offset table
+  const auto kIndex = grid.IndexOf(kFirst);
+  EXPECT_EQ(grid.IndexOf(kUp), grid.Neighbour(kIndex, 5));
+  EXPECT_FALSE(grid.HasNeighbour(kIndex, 3));
+  uint32_t count = 0;
+  grid.ForEachNeighbour(kIndex, [&](Grid3::Index neighbour, Grid3::Direction direction)
+  {
+    ++count;
+    EXPECT_EQ(kIndex, grid.Neighbour(neighbour, Grid3::Opposite(direction)));
+  });
+  EXPECT_EQ(5u, count);
+
+  // Bidirectionnal links, only between orthogonal neighbours
+  grid.Connect(kFirst, kUp);
+  grid.Connect(kFirst, kFar);
+  EXPECT_TRUE(grid.IsConnected(kFirst, kUp));
+  EXPECT_TRUE(grid.IsConnected(kUp, kFirst));
+  EXPECT_TRUE(grid.IsConnected(grid.IndexOf(kUp), 4));
+  EXPECT_FALSE(grid.IsConnected(kFirst, kFar));
+  grid.ForEachConnected(kIndex, [&](Grid3::Index neighbour, Grid3::Direction direction)
+  {
+    EXPECT_EQ(grid.IndexOf(kUp), neighbour);
+    EXPECT_EQ(5u, direction);
+  });
+
+  grid.Disconnect(kUp, kFirst);
+  EXPECT_EQ(0u, grid.Links(kIndex));
+  EXPECT_EQ(0u, grid.Links(grid.IndexOf(kUp)));
+}
+
+// Test GridN hyperplane walls
+TEST(TestGridN, disconnectHyperplane)
+{
+  // 2D walls are the FlatGrid columns and rows
+  {
+    Grid2 grid(Grid2::Coordinates{{ 9, 7 }}, true);
+    FlatGrid<> flatGrid(9, 7, true);
+    grid.DisconnectHyperplane(Grid2::Coordinates{{ 1, 2 }}, 0, 3, Grid2::Coordinates{{ 0, 10 }},
+                              Grid2::Coordinates{{ 0, 2 }});
+    flatGrid.DisconnectCol(FlatGrid<>::Point(1, 2), 3, 10, 2);
+    grid.DisconnectHyperplane(Grid2::Coordinates{{ 2, 0 }}, 1, 4, Grid2::Coordinates{{ 5, 0 }},
+                              Grid2::Coordinates{{ 9, 0 }});
+    flatGrid.DisconnectRow(FlatGrid<>::Point(2, 0), 4, 5, 9);
+    grid.DisconnectHyperplane(Grid2::Coordinates{{ 0, 0 }}, 0, 8, Grid2::Coordinates{{ 0, 7 }},
+                              Grid2::Coordinates{{ 0, 0 }});
+    flatGrid.DisconnectCol(FlatGrid<>::Point(0, 0), 8, 7, 0);
+    EXPECT_TRUE(IsSameGrid(grid, flatGrid));
+  }
+
+  // 3D wall orthogonal to the z axis, cut at the border, with a door
+  const Grid3::Coordinates kExtents = {{ 4, 3, 5 }};
+  Grid3 grid(kExtents, true);
+  const Grid3::Coordinates kOrigin = {{ 1, 0, 0 }}, kSizes = {{ 10, 2, 0 }}, kDoor = {{ 1, 1, 0 }};
+  grid.DisconnectHyperplane(kOrigin, 2, 2, kSizes, kDoor);
+  for (uint32_t x = 0; x < 4; ++x)
+    for (uint32_t y = 0; y < 3; ++y)
+    {
+      const Grid3::Coordinates kCell = {{ x, y, 2 }};
+      const bool kIsWall = x >= 1 && y < 2 && !(x == 2 && y == 1);
+      EXPECT_EQ(!kIsWall, grid.IsConnected(grid.IndexOf(kCell), 5));
+      EXPECT_TRUE(grid.IsConnected(grid.IndexOf(kCell), 4));
+    }
+}
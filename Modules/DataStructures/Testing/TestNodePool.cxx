@@ -0,0 +1,95 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#include <gtest/gtest.h>
+#include <node_pool.hxx>
+
+// STD includes
+#include <list>
+#include <set>
+
+using namespace huc;
+
+// Test NodePool allocations
+TEST(TestNodePool, allocate)
+{
+  NodePool pool(1024);
+  EXPECT_EQ(0u, pool.BlockCount());
+  EXPECT_EQ(1024u, pool.BlockSize());
+
+  // Nodes are aligned, distinct and carved out of the same block
+  std::set<void*> nodes;
+  for (int i = 0; i < 8; ++i)
+  {
+    void* node = pool.Allocate(24);
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(node) % NodePool::kAlignment);
+    nodes.insert(node);
+  }
+  EXPECT_EQ(8u, nodes.size());
+  EXPECT_EQ(1u, pool.BlockCount());
+
+  // Released nodes are reused by the same size class only
+  void* node = *nodes.begin();
+  pool.Deallocate(node, 24);
+  EXPECT_NE(node, pool.Allocate(100));
+  EXPECT_EQ(node, pool.Allocate(20));
+
+  // New blocks once the current one is exhausted, large allocations bypass the pool
+  for (int i = 0; i < 64; ++i)
+    pool.Allocate(32);
+  EXPECT_EQ(3u, pool.BlockCount());
+  void* large = pool.Allocate(NodePool::kMaxNodeSize + 1);
+  pool.Deallocate(large, NodePool::kMaxNodeSize + 1);
+  EXPECT_EQ(3u, pool.BlockCount());
+}
+
+// Test PoolAllocator with standard containers
+TEST(TestNodePool, allocator)
+{
+  PoolAllocator<int> allocator;
+  {
+    std::list<int, PoolAllocator<int>> list(allocator);
+    for (int i = 0; i < 10000; ++i)
+      list.push_back(i);
+    for (int i = 0; i < 10000; ++i)
+      list.pop_front();
+
+    // Released nodes are reused: no new block
+    const size_t kBlockCount = allocator.Pool()->BlockCount();
+    for (int i = 0; i < 10000; ++i)
+      list.push_back(i);
+    EXPECT_EQ(kBlockCount, allocator.Pool()->BlockCount());
+    EXPECT_LT(kBlockCount, 10u);
+  }
+
+  // Rebound copies share the pool, default constructed allocators own a new one
+  PoolAllocator<double> copy(allocator);
+  EXPECT_TRUE(copy == allocator);
+  EXPECT_TRUE(PoolAllocator<int>() != allocator);
+
+  // The pool lives as long as the objects allocated from it
+  std::shared_ptr<std::set<int, std::less<int>, PoolAllocator<int>>> set;
+  {
+    PoolAllocator<int> local;
+    set = std::allocate_shared<std::set<int, std::less<int>, PoolAllocator<int>>>(local, std::less<int>(), local);
+  }
+  for (int i = 0; i < 1000; ++i)
+    set->insert(i);
+  EXPECT_EQ(1000u, set->size());
+}
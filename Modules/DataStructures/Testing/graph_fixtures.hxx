@@ -0,0 +1,49 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#ifndef MODULE_DS_GRAPH_FIXTURES_HXX
+#define MODULE_DS_GRAPH_FIXTURES_HXX
+
+#include <DataStructures/csr_graph.hxx>
+
+// STD includes
+#include <vector>
+
+// Graph fixtures shared by the CSRGraph and maze generator tests.
+#ifndef DOXYGEN_SKIP
+namespace {
+  // Append the edges of an hexagonal grid (odd rows shifted right), vertex first + x + y * width
+  inline void AddHexEdges(std::vector<huc::CSRGraph::Edge>& edges, uint32_t width, uint32_t height,
+                          huc::CSRGraph::Vertex first = 0)
+  {
+    for (uint32_t y = 0; y < height; ++y)
+      for (uint32_t x = 0; x < width; ++x)
+      {
+        const huc::CSRGraph::Vertex kVertex = first + x + y * width;
+        if (x + 1 < width) edges.push_back(huc::CSRGraph::Edge(kVertex, kVertex + 1));
+        if (y + 1 == height) continue;
+        if (y % 2 == 0 && x > 0) edges.push_back(huc::CSRGraph::Edge(kVertex, kVertex + width - 1));
+        if (y % 2 == 1 && x + 1 < width) edges.push_back(huc::CSRGraph::Edge(kVertex, kVertex + width + 1));
+        edges.push_back(huc::CSRGraph::Edge(kVertex, kVertex + width));
+      }
+  }
+}
+#endif /* DOXYGEN_SKIP */
+
+#endif // MODULE_DS_GRAPH_FIXTURES_HXX
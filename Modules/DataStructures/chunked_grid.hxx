@@ -0,0 +1,376 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#ifndef MODULE_DS_CHUNKED_GRID_HXX
+#define MODULE_DS_CHUNKED_GRID_HXX
+
+#include <DataStructures/grid.hxx>
+#include <DataStructures/grid_layout.hxx>
+
+// STD includes
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <list>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace huc
+{
+  /// @class ChunkedGrid
+  ///
+  /// A Chunked Grid covers a huge width x height grid with chunks of 64 x 64 cells materialized on first
+  /// touch: a generator callback fills the connection masks (cf. FlatGrid) and CellInfo of each new chunk.
+  /// At most maxResidentChunks chunks stay in memory, within a hash map keyed by chunk coordinates: the
+  /// least recently used ones are written to a spill file and read back when touched again.
+  ///
+  /// Connect, Disconnect, DisconnectRow and DisconnectCol follow the FlatGrid semantics, updating both
+  /// cells of a connection even across chunk borders.
+  ///
+  /// @advantages
+  /// - Memory proportional to the number of resident chunks, whatever the size of the world.
+  /// - Untouched areas cost nothing, neither in memory nor in the spill file.
+  ///
+  /// @drawbacks
+  /// - Each access goes through the hash map (the chunk of the last access is cached).
+  /// - The generator has to agree with itself on the connections across chunk borders (e.g. by deciding
+  ///   each border passage from its world coordinates), as neighbour chunks are generated independently.
+  ///
+  /// @tparam CellInfo a trivially copyable struct used to store extra information associated with each cell.
+  template <typename CellInfo = CellInfoBase>
+  class ChunkedGrid
+  {
+  public:
+    static_assert(std::is_trivially_copyable<CellInfo>::value, "CellInfo must be trivially copyable");
+
+    enum : uint32_t { kChunkBits = 6, kChunkSide = 1 << kChunkBits, kChunkCells = kChunkSide * kChunkSide };
+
+    typedef typename Grid<CellInfo>::Point Point;
+
+    /// Chunk - Cells of a chunk, the local cell (x, y) being at y * kChunkSide + x.
+    struct Chunk
+    {
+      uint8_t links[kChunkCells];   // Connection mask of each cell (bit set per GridDirection)
+      CellInfo infos[kChunkCells];  // Extra information of each cell
+    };
+
+    /// Generator - Fill a new chunk given its chunk coordinates (the cell (x, y) is within the chunk
+    /// (x >> kChunkBits, y >> kChunkBits)). Chunks are zero connected with default CellInfo beforehand.
+    typedef std::function<void(uint32_t chunkX, uint32_t chunkY, Chunk& chunk)> Generator;
+
+    /// Create - Build an empty chunked grid.
+    ///
+    /// @param width the desired width for the grid.
+    /// @param height the desired height for the grid.
+    /// @param generator the callback filling each new chunk, nullptr for disconnected cells.
+    /// @param maxResidentChunks maximum number of chunks kept in memory (at least 2).
+    /// @param spillPath path of the spill file, removed with the grid once opened; anonymous temporary file
+    /// if empty.
+    ///
+    /// @return the chunked grid, nullptr if the spill file cannot be created.
+    static std::unique_ptr<ChunkedGrid> Create(uint32_t width, uint32_t height, const Generator& generator,
+                                               size_t maxResidentChunks, const std::string& spillPath = "")
+    {
+      std::unique_ptr<ChunkedGrid> grid(new ChunkedGrid(width, height, generator, maxResidentChunks, spillPath));
+      grid->spill = spillPath.empty() ? std::tmpfile() : std::fopen(spillPath.c_str(), "w+b");
+      return grid->spill ? std::move(grid) : nullptr;
+    }
+
+    ~ChunkedGrid()
+    {
+      if (!this->spill)
+        return;
+      std::fclose(this->spill);
+      if (!this->spillPath.empty())
+        std::remove(this->spillPath.c_str());
+    }
+
+    uint32_t Width() const { return this->width; }
+    uint32_t Height() const { return this->height; }
+    size_t ResidentChunkCount() const { return this->chunks.size(); }
+    size_t SpilledChunkCount() const { return this->slots.size(); }
+    uint64_t SpillErrorCount() const { return this->spillErrorCount; }
+
+    /// IsMaterialized - Whether the chunk containing (x, y) has already been generated.
+    bool IsMaterialized(uint32_t x, uint32_t y) const
+    { return this->chunks.count(Key(x, y)) > 0 || this->slots.count(Key(x, y)) > 0; }
+
+    /// Links - Return the 4 bits mask of the directions the cell at (x, y) is connected to.
+    uint8_t Links(uint32_t x, uint32_t y) { return GetChunk(x, y, false).links[Local(x, y)]; }
+
+    /// IsConnected - Whether the cell at (x, y) is connected to its neighbour in the direction.
+    bool IsConnected(uint32_t x, uint32_t y, GridDirection direction)
+    { return (Links(x, y) >> direction) & 1; }
+
+    /// Info - Extra information of the cell at (x, y).
+    ///
+    /// @warning the reference is invalidated by any access to another chunk (which may evict this one).
+    CellInfo& Info(uint32_t x, uint32_t y) { return GetChunk(x, y, true).infos[Local(x, y)]; }
+
+    /// Connect with a bidirectionnal link first and second.
+    /// Nothing is done if the cells are not orthogonal neighbours.
+    ///
+    /// @param first the cell to be connected to the second cell.
+    /// @param second the cell to be connected to the first cell.
+    ///
+    /// @return void.
+    void Connect(const Point& first, const Point& second) { Link(first, second, true); }
+
+    /// Connect with bidirectionnal links the root with the neighbours.
+    ///
+    /// @param root the root to be connected to the neighbours.
+    /// @param neighbours list of cells to be connected to the root.
+    ///
+    /// @return void.
+    void Connect(const Point& root, const std::vector<Point>& neighbours)
+    {
+      for (auto it = neighbours.begin(); it != neighbours.end(); ++it)
+        Link(root, *it, true);
+    }
+
+    /// Disconnect the bidirectionnal link between first and second.
+    /// Nothing is done if the cells are not orthogonal neighbours.
+    ///
+    /// @param first the cell to be disconnected to the second cell.
+    /// @param second the cell to be disconnected to the first cell.
+    ///
+    /// @return void.
+    void Disconnect(const Point& first, const Point& second) { Link(first, second, false); }
+
+    /// Disconnect a column of cells - Build a wall between connected cells (cf. FlatGrid::DisconnectCol).
+    ///
+    /// @param origin the origin point on the grid setting the current relative position.
+    /// @param idx the relative index of the column of cells to be disconnected.
+    /// @param height the size of wall constructed, cut at the border of the grid.
+    /// @param pathIdx the relative index of the path (door) within the wall, none if pathIdx >= height.
+    ///
+    /// @return void.
+    void DisconnectCol(const Point& origin, const uint32_t idx, const uint32_t height, const uint32_t pathIdx)
+    {
+      if (static_cast<uint64_t>(origin.x) + idx + 1 >= this->width || origin.y >= this->height)
+        return;
+
+      for (uint32_t y = 0; y < std::min(height, this->height - origin.y); ++y)
+        if (y != pathIdx)
+          Link(Point(origin.x + idx, origin.y + y), Point(origin.x + idx + 1, origin.y + y), false);
+    }
+
+    /// Disconnect a row of cells - Build a wall between connected cells (cf. FlatGrid::DisconnectRow).
+    ///
+    /// @param origin the origin point on the grid setting the current relative position.
+    /// @param idx the relative index of the row of cells to be disconnected.
+    /// @param width the size of wall constructed, cut at the border of the grid.
+    /// @param pathIdx the relative index of the path (door) within the wall, none if pathIdx >= width.
+    ///
+    /// @return void.
+    void DisconnectRow(const Point& origin, const uint32_t idx, const uint32_t width, const uint32_t pathIdx)
+    {
+      if (static_cast<uint64_t>(origin.y) + idx + 1 >= this->height || origin.x >= this->width)
+        return;
+
+      for (uint32_t x = 0; x < std::min(width, this->width - origin.x); ++x)
+        if (x != pathIdx)
+          Link(Point(origin.x + x, origin.y + idx), Point(origin.x + x, origin.y + idx + 1), false);
+    }
+
+    /// ForEachConnected - Call functor(neighbour, direction) on each neighbour connected to the cell.
+    ///
+    /// @param point the cell.
+    /// @param functor the functor to be called on each connected neighbour point.
+    ///
+    /// @return void.
+    template <typename Functor>
+    void ForEachConnected(const Point& point, Functor functor)
+    {
+      const uint8_t kLinks = Links(point.x, point.y);
+      if ((kLinks >> kNorth) & 1) functor(Point(point.x, point.y - 1), kNorth);
+      if ((kLinks >> kEast) & 1) functor(Point(point.x + 1, point.y), kEast);
+      if ((kLinks >> kSouth) & 1) functor(Point(point.x, point.y + 1), kSouth);
+      if ((kLinks >> kWest) & 1) functor(Point(point.x - 1, point.y), kWest);
+    }
+
+  private:
+    ChunkedGrid(const ChunkedGrid&);            // Not Implemented
+    ChunkedGrid operator=(const ChunkedGrid&);  // Not Implemented
+
+    /// Resident chunk with its position within the LRU list.
+    struct Entry
+    {
+      std::unique_ptr<Chunk> chunk;
+      std::list<uint64_t>::iterator lruIt;
+      bool isDirty;   // Modified since it was last written to the spill file
+    };
+
+    ChunkedGrid(uint32_t width, uint32_t height, const Generator& generator, size_t maxResidentChunks,
+                const std::string& spillPath) :
+      width(width), height(height), generator(generator),
+      maxResidentChunks(std::max<size_t>(2, maxResidentChunks)), spillPath(spillPath), spill(nullptr),
+      spillSize(0), spillErrorCount(0), lastKey(0), lastEntry(nullptr) {}
+
+    uint32_t width;                                    // Number of columns
+    uint32_t height;                                   // Number of rows
+    Generator generator;                               // Fills the new chunks
+    size_t maxResidentChunks;                          // Maximum number of chunks in memory
+    std::string spillPath;                             // Path of the spill file, empty if anonymous
+    std::FILE* spill;                                  // Spill file
+    uint64_t spillSize;                                // Number of bytes of the spill file
+    uint64_t spillErrorCount;                          // Number of failed spill writes or reads
+    std::unordered_map<uint64_t, Entry> chunks;        // Resident chunks
+    std::unordered_map<uint64_t, uint64_t> slots;      // Offset of the spilled chunks within the spill file
+    std::list<uint64_t> lru;                           // Resident chunks, most recently used first
+    std::vector<std::unique_ptr<Chunk>> spares;        // Evicted chunk buffers kept for reuse
+    uint64_t lastKey;                                  // Key of the last accessed chunk
+    Entry* lastEntry;                                  // Last accessed chunk, nullptr if none
+
+    static uint64_t Key(uint32_t x, uint32_t y)
+    { return (static_cast<uint64_t>(x >> kChunkBits) << 32) | (y >> kChunkBits); }
+    static uint32_t Local(uint32_t x, uint32_t y)
+    { return ((y & (kChunkSide - 1)) << kChunkBits) | (x & (kChunkSide - 1)); }
+
+    /// Set or clear the link between two orthogonal neighbours, possibly within two chunks.
+    void Link(const Point& first, const Point& second, bool isConnected)
+    {
+      if (first.x >= this->width || first.y >= this->height || second.x >= this->width || second.y >= this->height)
+        return;
+
+      GridDirection direction;
+      if (first.y == second.y && first.x + 1 == second.x) direction = kEast;
+      else if (first.y == second.y && second.x + 1 == first.x) direction = kWest;
+      else if (first.x == second.x && first.y + 1 == second.y) direction = kSouth;
+      else if (first.x == second.x && second.y + 1 == first.y) direction = kNorth;
+      else return;
+
+      // The first chunk stays resident while the second one is touched (at least 2 resident chunks)
+      Chunk& firstChunk = GetChunk(first.x, first.y, true);
+      Chunk& secondChunk = GetChunk(second.x, second.y, true);
+      uint8_t& firstLinks = firstChunk.links[Local(first.x, first.y)];
+      uint8_t& secondLinks = secondChunk.links[Local(second.x, second.y)];
+      if (isConnected)
+      {
+        firstLinks |= static_cast<uint8_t>(1 << direction);
+        secondLinks |= static_cast<uint8_t>(1 << OppositeDirection(direction));
+      }
+      else
+      {
+        firstLinks &= static_cast<uint8_t>(~(1 << direction));
+        secondLinks &= static_cast<uint8_t>(~(1 << OppositeDirection(direction)));
+      }
+    }
+
+    /// Return the chunk containing (x, y): resident, reloaded from the spill file or generated.
+    Chunk& GetChunk(uint32_t x, uint32_t y, bool isModified)
+    {
+      const uint64_t kKey = Key(x, y);
+      if (!this->lastEntry || this->lastKey != kKey)
+      {
+        auto it = this->chunks.find(kKey);
+        if (it != this->chunks.end())
+          this->lru.splice(this->lru.begin(), this->lru, it->second.lruIt);
+        else
+          it = Materialize(kKey);
+        this->lastKey = kKey;
+        this->lastEntry = &it->second;
+      }
+
+      this->lastEntry->isDirty = this->lastEntry->isDirty || isModified;
+      return *this->lastEntry->chunk;
+    }
+
+    typename std::unordered_map<uint64_t, Entry>::iterator Materialize(uint64_t key)
+    {
+      std::unique_ptr<Chunk> chunk;
+      if (this->spares.empty())
+        chunk.reset(new Chunk());
+      else
+      {
+        chunk = std::move(this->spares.back());
+        this->spares.pop_back();
+      }
+
+      // Reload the spilled chunk, or generate a new one
+      bool isDirty = false;
+      const auto kSlot = this->slots.find(key);
+      if (kSlot == this->slots.end() || !Seek(kSlot->second) ||
+          std::fread(chunk.get(), sizeof(Chunk), 1, this->spill) != 1)
+      {
+        this->spillErrorCount += (kSlot != this->slots.end()) ? 1 : 0;
+        std::fill(chunk->links, chunk->links + kChunkCells, 0);
+        std::fill(chunk->infos, chunk->infos + kChunkCells, CellInfo());
+        if (this->generator)
+          this->generator(static_cast<uint32_t>(key >> 32), static_cast<uint32_t>(key), *chunk);
+        isDirty = true;
+      }
+
+      this->lru.push_front(key);
+      Entry entry;
+      entry.chunk = std::move(chunk);
+      entry.lruIt = this->lru.begin();
+      entry.isDirty = isDirty;
+      auto it = this->chunks.insert(std::make_pair(key, std::move(entry))).first;
+
+      while (this->chunks.size() > this->maxResidentChunks && Evict()) {}
+      return it;
+    }
+
+    /// Write the least recently used chunk to the spill file and release it, false if it could not be written.
+    bool Evict()
+    {
+      const uint64_t kKey = this->lru.back();
+      auto it = this->chunks.find(kKey);
+      if (it->second.isDirty)
+      {
+        auto slot = this->slots.find(kKey);
+        const uint64_t kOffset = (slot != this->slots.end()) ? slot->second : this->spillSize;
+        if (!Seek(kOffset) || std::fwrite(it->second.chunk.get(), sizeof(Chunk), 1, this->spill) != 1)
+        {
+          // Keep the chunk resident rather than losing it
+          ++this->spillErrorCount;
+          return false;
+        }
+        if (slot == this->slots.end())
+        {
+          this->slots[kKey] = kOffset;
+          this->spillSize += sizeof(Chunk);
+        }
+      }
+
+      this->lru.pop_back();
+      this->spares.push_back(std::move(it->second.chunk));
+      this->chunks.erase(it);
+      if (this->lastKey == kKey)
+        this->lastEntry = nullptr;
+      return true;
+    }
+
+    bool Seek(uint64_t offset)
+    {
+#if defined(_WIN32)
+      return _fseeki64(this->spill, static_cast<__int64>(offset), SEEK_SET) == 0;
+#else
+      return fseeko(this->spill, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+    }
+  };
+}
+
+#endif // MODULE_DS_CHUNKED_GRID_HXX
@@ -0,0 +1,270 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#ifndef MODULE_DS_CSR_GRAPH_HXX
+#define MODULE_DS_CSR_GRAPH_HXX
+
+#include <Combinatory/parallel.hxx>
+
+// STD includes
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace huc
+{
+  /// @class CSRGraph
+  ///
+  /// A Compressed Sparse Row Graph stores an undirected graph of arbitrary topology (hex grids, meshes, road
+  /// graphs...) as the sorted adjacency of its vertices: the arcs of vertex v are the range
+  /// [offsets[v], offsets[v + 1]) of two flat arrays, the neighbours and the ids of the edges they go through.
+  /// Vertices are 32 bits ids, each edge of the input list is reached from both of its ends.
+  ///
+  /// The structure of the graph is immutable once built: maze generators carve passages by activating edges
+  /// within a bitset (cf. SetActive), searches then follow the active edges only (cf. ForEachConnected).
+  ///
+  /// Build sorts the arcs by source vertex with a parallel LSD radix sort (8 bits digits, stable), which keeps
+  /// the arcs of each vertex in the order of the edge list whatever the number of threads.
+  ///
+  /// @advantages
+  /// - Three contiguous arrays for the whole graph, neighbours of a vertex are contiguous.
+  /// - Edges are activated and tested with one bit each.
+  ///
+  /// @drawbacks
+  /// - Edges cannot be added or removed once built (only activated and deactivated).
+  /// - At most 2^32 - 1 vertices and 2^32 - 1 edges.
+  class CSRGraph
+  {
+  public:
+    typedef uint32_t Vertex;
+    typedef uint32_t EdgeId;
+
+    /// Edge of the input list, connecting first and second.
+    struct Edge
+    {
+      Edge(Vertex first = 0, Vertex second = 0) : first(first), second(second) {}
+      Vertex first;
+      Vertex second;
+    };
+
+    /// Build - Construct the graph of the edge list, all edges being inactive.
+    ///
+    /// @param vertexCount the number of vertices, ids ranging in [0, vertexCount).
+    /// @param edges the edge list, the id of each edge being its position within the list.
+    /// @param threadCount number of threads to be used, 0 to use every hardware thread.
+    ///
+    /// @return CSR Graph pointer to be owned, nullptr if an edge has an unknown vertex or if there are too many
+    /// edges.
+    static std::unique_ptr<CSRGraph> Build(Vertex vertexCount, const std::vector<Edge>& edges,
+                                           uint32_t threadCount = 0)
+    {
+      if (edges.size() >= 0xFFFFFFFFull || vertexCount == 0xFFFFFFFFu)
+        return nullptr;
+      for (auto it = edges.begin(); it != edges.end(); ++it)
+        if (it->first >= vertexCount || it->second >= vertexCount)
+          return nullptr;
+
+      std::unique_ptr<CSRGraph> graph(new CSRGraph(vertexCount, edges));
+      graph->Init(combinatory::GetThreadCount(threadCount));
+      return graph;
+    }
+
+    Vertex VertexCount() const { return this->vertexCount; }
+    EdgeId EdgeCount() const { return static_cast<EdgeId>(this->edges.size()); }
+    const Edge& GetEdge(EdgeId edge) const { return this->edges[edge]; }
+    uint32_t Degree(Vertex vertex) const
+    { return static_cast<uint32_t>(this->offsets[vertex + 1] - this->offsets[vertex]); }
+
+    /// Other - Return the end of the edge which is not vertex.
+    Vertex Other(EdgeId edge, Vertex vertex) const
+    { return (this->edges[edge].first == vertex) ? this->edges[edge].second : this->edges[edge].first; }
+
+    /// IsActive - Whether the edge is active (e.g. a carved passage).
+    bool IsActive(EdgeId edge) const { return (this->active[edge >> 6] >> (edge & 63)) & 1; }
+
+    /// SetActive - Activate or deactivate the edge.
+    ///
+    /// @param edge the id of the edge.
+    /// @param isActive whether the edge has to be active.
+    ///
+    /// @return void.
+    void SetActive(EdgeId edge, bool isActive)
+    {
+      if (isActive) this->active[edge >> 6] |= uint64_t(1) << (edge & 63);
+      else this->active[edge >> 6] &= ~(uint64_t(1) << (edge & 63));
+    }
+
+    /// SetAllActive - Activate or deactivate every edge.
+    ///
+    /// @param isActive whether the edges have to be active.
+    ///
+    /// @return void.
+    void SetAllActive(bool isActive)
+    {
+      std::fill(this->active.begin(), this->active.end(), isActive ? ~uint64_t(0) : 0);
+      if (isActive && (this->edges.size() & 63))
+        this->active.back() = (uint64_t(1) << (this->edges.size() & 63)) - 1;
+    }
+
+    /// ActiveCount - Number of active edges.
+    EdgeId ActiveCount() const
+    {
+      EdgeId count = 0;
+      for (auto it = this->active.begin(); it != this->active.end(); ++it)
+        for (uint64_t word = *it; word; word &= word - 1)
+          ++count;
+      return count;
+    }
+
+    /// ForEachNeighbour - Call functor(neighbour, edge) on each arc of the vertex, active or not.
+    ///
+    /// @param vertex the vertex.
+    /// @param functor the functor to be called on each neighbour.
+    ///
+    /// @return void.
+    template <typename Functor>
+    void ForEachNeighbour(Vertex vertex, Functor functor) const
+    {
+      for (uint64_t arc = this->offsets[vertex]; arc < this->offsets[vertex + 1]; ++arc)
+        functor(this->targets[arc], this->arcEdges[arc]);
+    }
+
+    /// ForEachConnected - Call functor(neighbour, edge) on each arc of the vertex through an active edge.
+    ///
+    /// @param vertex the vertex.
+    /// @param functor the functor to be called on each connected neighbour.
+    ///
+    /// @return void.
+    template <typename Functor>
+    void ForEachConnected(Vertex vertex, Functor functor) const
+    {
+      for (uint64_t arc = this->offsets[vertex]; arc < this->offsets[vertex + 1]; ++arc)
+        if (IsActive(this->arcEdges[arc]))
+          functor(this->targets[arc], this->arcEdges[arc]);
+    }
+
+    // Accessors
+    const uint64_t* OffsetsData() const { return this->offsets.data(); }
+    const Vertex* TargetsData() const { return this->targets.data(); }
+    const EdgeId* ArcEdgesData() const { return this->arcEdges.data(); }
+
+  private:
+    CSRGraph(const CSRGraph&);            // Not Implemented
+    CSRGraph operator=(const CSRGraph&);  // Not Implemented
+
+    enum : uint32_t { kDigitBits = 8, kBucketCount = 1 << kDigitBits, kMinArcsPerThread = 1 << 14 };
+
+    CSRGraph(Vertex vertexCount, const std::vector<Edge>& edges) :
+      vertexCount(vertexCount), edges(edges), offsets(static_cast<size_t>(vertexCount) + 1, 0),
+      active((edges.size() + 63) / 64, 0) {}
+
+    Vertex vertexCount;              // Number of vertices
+    std::vector<Edge> edges;         // Edge list
+    std::vector<uint64_t> offsets;   // First arc of each vertex, followed by the number of arcs
+    std::vector<Vertex> targets;     // Neighbour reached by each arc
+    std::vector<EdgeId> arcEdges;    // Edge of each arc
+    std::vector<uint64_t> active;    // Active edges bitset
+
+    /// Source vertex of the arc: arc 2e goes from the first end of the edge e, arc 2e + 1 from its second end.
+    Vertex Source(uint64_t arc) const
+    { return (arc & 1) ? this->edges[arc >> 1].second : this->edges[arc >> 1].first; }
+
+    void Init(uint32_t threadCount)
+    {
+      const uint64_t kArcCount = 2 * static_cast<uint64_t>(this->edges.size());
+      threadCount = static_cast<uint32_t>(std::max<uint64_t>(1,
+                      std::min<uint64_t>(threadCount, kArcCount / kMinArcsPerThread)));
+
+      // Sort the arcs by source vertex, one stable counting pass per digit of the largest vertex id
+      std::vector<uint64_t> arcs(static_cast<size_t>(kArcCount)), buffer(static_cast<size_t>(kArcCount));
+      ForEachBlock(kArcCount, threadCount, [&](uint64_t begin, uint64_t end, uint32_t)
+      {
+        for (uint64_t arc = begin; arc < end; ++arc)
+          arcs[arc] = arc;
+      });
+
+      std::vector<uint64_t> counts(static_cast<size_t>(threadCount) * kBucketCount);
+      const Vertex kMaxVertex = std::max<Vertex>(this->vertexCount, 1) - 1;
+      for (uint32_t shift = 0; shift < 32 && (kMaxVertex >> shift) > 0; shift += kDigitBits)
+      {
+        // Histogram of the digit within each block of arcs
+        std::fill(counts.begin(), counts.end(), 0);
+        ForEachBlock(kArcCount, threadCount, [&](uint64_t begin, uint64_t end, uint32_t threadIdx)
+        {
+          uint64_t* count = &counts[static_cast<size_t>(threadIdx) * kBucketCount];
+          for (uint64_t i = begin; i < end; ++i)
+            ++count[(Source(arcs[i]) >> shift) & (kBucketCount - 1)];
+        });
+
+        // Starting position of each (digit, block): digits first, then blocks, for a stable scatter
+        uint64_t position = 0;
+        for (uint32_t digit = 0; digit < kBucketCount; ++digit)
+          for (uint32_t threadIdx = 0; threadIdx < threadCount; ++threadIdx)
+          {
+            const uint64_t kCount = counts[static_cast<size_t>(threadIdx) * kBucketCount + digit];
+            counts[static_cast<size_t>(threadIdx) * kBucketCount + digit] = position;
+            position += kCount;
+          }
+
+        ForEachBlock(kArcCount, threadCount, [&](uint64_t begin, uint64_t end, uint32_t threadIdx)
+        {
+          uint64_t* next = &counts[static_cast<size_t>(threadIdx) * kBucketCount];
+          for (uint64_t i = begin; i < end; ++i)
+            buffer[next[(Source(arcs[i]) >> shift) & (kBucketCount - 1)]++] = arcs[i];
+        });
+        arcs.swap(buffer);
+      }
+
+      // Fill the arrays, each arc position setting the offsets of the vertices starting there
+      this->targets.resize(static_cast<size_t>(kArcCount));
+      this->arcEdges.resize(static_cast<size_t>(kArcCount));
+      ForEachBlock(kArcCount, threadCount, [&](uint64_t begin, uint64_t end, uint32_t)
+      {
+        for (uint64_t i = begin; i < end; ++i)
+        {
+          const uint64_t kArc = arcs[i];
+          this->arcEdges[i] = static_cast<EdgeId>(kArc >> 1);
+          this->targets[i] = Source(kArc ^ 1);
+
+          const Vertex kSource = Source(kArc);
+          const uint64_t kFirst = (i > 0) ? static_cast<uint64_t>(Source(arcs[i - 1])) + 1 : 0;
+          for (uint64_t vertex = kFirst; vertex <= kSource; ++vertex)
+            this->offsets[vertex] = i;
+        }
+      });
+      const uint64_t kFirst = (kArcCount > 0) ? static_cast<uint64_t>(Source(arcs.back())) + 1 : 0;
+      for (uint64_t vertex = kFirst; vertex <= this->vertexCount; ++vertex)
+        this->offsets[vertex] = kArcCount;
+    }
+
+    /// Run functor(begin, end, threadIdx) on threadCount contiguous blocks of [0, count).
+    template <typename Functor>
+    static void ForEachBlock(uint64_t count, uint32_t threadCount, Functor functor)
+    {
+      if (threadCount == 1)
+        return functor(0, count, 0);
+
+      combinatory::ParallelRun(threadCount, [&](uint32_t threadIdx)
+      { functor(count * threadIdx / threadCount, count * (threadIdx + 1) / threadCount, threadIdx); });
+    }
+  };
+}
+
+#endif // MODULE_DS_CSR_GRAPH_HXX
@@ -0,0 +1,335 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#ifndef MODULE_DS_FLAT_GRID_HXX
+#define MODULE_DS_FLAT_GRID_HXX
+
+#include <DataStructures/grid.hxx>
+#include <DataStructures/grid_layout.hxx>
+
+// STD includes
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace huc
+{
+  /// @class FlatGrid
+  ///
+  /// A Flat Grid stores the cells of a Grid within one contiguous array addressed by a 64 bits index, the
+  /// Layout policy mapping coordinates to indexes (cf. grid_layout.hxx). The connections of each cell are a
+  /// 4 bits mask (one bit per GridDirection, a cleared bit being a wall) and the CellInfo of all cells are
+  /// kept in a parallel array.
+  ///
+  /// Algorithms walking the grid through indexes and the neighbour API (HasNeighbour, Neighbour,
+  /// ForEachNeighbour, ForEachConnected) run unchanged over any layout.
+  ///
+  /// It follows the Grid semantics (Connect, Disconnect, DisconnectRow, DisconnectCol) restricted to
+  /// orthogonal neighbours, which are the only connections built by the maze generators.
+  ///
+  /// @advantages
+  /// - One byte per cell plus its CellInfo, two allocations for the whole grid instead of a cell, a
+  ///   control block and a set of connections per cell.
+  /// - Connections are tested with a bit mask and neighbours are found by index arithmetic.
+  ///
+  /// @drawbacks
+  /// - Only orthogonal neighbours can be connected.
+  ///
+  /// @tparam CellInfo a struct used to store extra information associated with each cell.
+  /// @tparam Layout the policy mapping the coordinates of the cells to their index.
+  template <typename CellInfo = CellInfoBase, typename Layout = RowMajorLayout>
+  class FlatGrid
+  {
+  public:
+    typedef uint64_t Index;
+    typedef typename Grid<CellInfo>::Point Point;
+
+    enum : uint8_t { kAllLinks = 0x0F };
+
+    /// FlatGrid constructor.
+    ///
+    /// @param width the desired width for the Grid.
+    /// @param height the desired height for the Grid.
+    /// @param isConnected whether or not the cells of the grid are connected at the initialization.
+    explicit FlatGrid(uint32_t width, uint32_t height, bool isConnected = false) :
+      layout(width, height),
+      links(static_cast<size_t>(layout.Capacity()), 0),
+      infos(static_cast<size_t>(layout.Capacity()))
+    {
+      if (!isConnected)
+        return;
+
+      for (uint32_t y = 0; y < height; ++y)
+        for (uint32_t x = 0; x < width; ++x)
+          this->links[IndexOf(x, y)] = static_cast<uint8_t>(((y > 0) ? 1 << kNorth : 0) |
+                                                            ((x + 1 < width) ? 1 << kEast : 0) |
+                                                            ((y + 1 < height) ? 1 << kSouth : 0) |
+                                                            ((x > 0) ? 1 << kWest : 0));
+    }
+
+    uint32_t Width() const { return this->layout.Width(); }
+    uint32_t Height() const { return this->layout.Height(); }
+    Index Size() const { return static_cast<Index>(Width()) * Height(); }
+    Index Capacity() const { return this->layout.Capacity(); }
+    const Layout& GetLayout() const { return this->layout; }
+
+    Index IndexOf(uint32_t x, uint32_t y) const { return this->layout.IndexOf(x, y); }
+    Index IndexOf(const Point& point) const { return this->layout.IndexOf(point.x, point.y); }
+    Point PointOf(Index index) const
+    {
+      Point point;
+      this->layout.PointOf(index, point.x, point.y);
+      return point;
+    }
+
+    /// HasNeighbour - Whether the cell at index has a neighbour within the grid in the direction.
+    bool HasNeighbour(Index index, GridDirection direction) const
+    {
+      const Point kPoint = PointOf(index);
+      switch (direction)
+      {
+        case kNorth: return kPoint.y > 0;
+        case kEast: return kPoint.x + 1 < Width();
+        case kSouth: return kPoint.y + 1 < Height();
+        default: return kPoint.x > 0;
+      }
+    }
+
+    /// Neighbour - Index of the neighbour in the direction.
+    ///
+    /// @warning the neighbour must exist (cf. HasNeighbour).
+    Index Neighbour(Index index, GridDirection direction) const
+    { return this->layout.Neighbour(index, direction); }
+
+    /// Links - Return the 4 bits mask of the directions the cell at index is connected to.
+    uint8_t Links(Index index) const { return this->links[index]; }
+
+    /// IsConnected - Whether the cell at index is connected to its neighbour in the direction.
+    bool IsConnected(Index index, GridDirection direction) const
+    { return (this->links[index] >> direction) & 1; }
+
+    /// IsConnected - Whether first and second are orthogonal neighbours connected together.
+    bool IsConnected(const Point& first, const Point& second) const
+    {
+      GridDirection direction;
+      return DirectionTo(first, second, direction) && IsConnected(IndexOf(first), direction);
+    }
+
+    /// Connect with a bidirectionnal link the cell at index and its neighbour in the direction.
+    ///
+    /// @warning the neighbour must exist (cf. HasNeighbour).
+    ///
+    /// @param index the index of the cell to be connected.
+    /// @param direction the direction of the neighbour to be connected.
+    ///
+    /// @return void.
+    void Connect(Index index, GridDirection direction)
+    {
+      this->links[index] |= static_cast<uint8_t>(1 << direction);
+      this->links[Neighbour(index, direction)] |= static_cast<uint8_t>(1 << OppositeDirection(direction));
+    }
+
+    /// Connect with a bidirectionnal link first and second.
+    /// Nothing is done if the cells are not orthogonal neighbours.
+    ///
+    /// @param first the cell to be connected to the second cell.
+    /// @param second the cell to be connected to the first cell.
+    ///
+    /// @return void.
+    void Connect(const Point& first, const Point& second)
+    {
+      GridDirection direction;
+      if (DirectionTo(first, second, direction))
+        Connect(IndexOf(first), direction);
+    }
+
+    /// Connect with bidirectionnal links the root with the neighbours.
+    ///
+    /// @param root the root to be connected to the neighbours.
+    /// @param neighbours list of cells to be connected to the root.
+    ///
+    /// @return void.
+    void Connect(const Point& root, const std::vector<Point>& neighbours)
+    {
+      for (auto it = neighbours.begin(); it != neighbours.end(); ++it)
+        Connect(root, *it);
+    }
+
+    /// Disconnect the bidirectionnal link between the cell at index and its neighbour in the direction.
+    ///
+    /// @warning the neighbour must exist (cf. HasNeighbour).
+    ///
+    /// @param index the index of the cell to be disconnected.
+    /// @param direction the direction of the neighbour to be disconnected.
+    ///
+    /// @return void.
+    void Disconnect(Index index, GridDirection direction)
+    {
+      this->links[index] &= static_cast<uint8_t>(~(1 << direction));
+      this->links[Neighbour(index, direction)] &= static_cast<uint8_t>(~(1 << OppositeDirection(direction)));
+    }
+
+    /// Disconnect the bidirectionnal link between first and second.
+    /// Nothing is done if the cells are not orthogonal neighbours.
+    ///
+    /// @param first the cell to be disconnected to the second cell.
+    /// @param second the cell to be disconnected to the first cell.
+    ///
+    /// @return void.
+    void Disconnect(const Point& first, const Point& second)
+    {
+      GridDirection direction;
+      if (DirectionTo(first, second, direction))
+        Disconnect(IndexOf(first), direction);
+    }
+
+    /// Disconnect a column of cells - Build a wall between connected cells.
+    /// Each cell of this column is disconnected to its right (East) neighboor except the one at the pathIdx.
+    ///
+    /// @param origin the origin point on the grid setting the current relative position.
+    /// @param idx the relative index of the column of cells to be disconnected.
+    /// @param height the size of wall constructed. If it exceeds the size of the Grid: wall will be
+    /// construted until the border.
+    /// @param pathIdx the relative index of the path (door) within the wall.
+    /// No path is created if pathIdx >= height.
+    ///
+    /// @return void.
+    void DisconnectCol(const Point& origin, const uint32_t idx, const uint32_t height, const uint32_t pathIdx)
+    {
+      if (origin.x + idx + 1 >= Width() || origin.y >= Height())
+        return;
+
+      for (uint32_t y = 0; y < std::min(height, Height() - origin.y); ++y)
+        if (y != pathIdx)
+          Disconnect(IndexOf(origin.x + idx, origin.y + y), kEast);
+    }
+
+    /// Disconnect a row of cells - Build a wall between connected cells.
+    /// Each cell of this row is disconnected to its bottom (South) neighboor except the one at the pathIdx.
+    ///
+    /// @param origin the origin point on the grid setting the current relative position.
+    /// @param idx the relative index of the row of cells to be disconnected.
+    /// @param width the size of wall constructed. If it exceeds the size of the Grid: wall will be
+    /// construted until the border.
+    /// @param pathIdx the relative index of the path (door) within the wall.
+    /// No path is created if pathIdx >= width.
+    ///
+    /// @return void.
+    void DisconnectRow(const Point& origin, const uint32_t idx, const uint32_t width, const uint32_t pathIdx)
+    {
+      if (origin.y + idx + 1 >= Height() || origin.x >= Width())
+        return;
+
+      for (uint32_t x = 0; x < std::min(width, Width() - origin.x); ++x)
+        if (x != pathIdx)
+          Disconnect(IndexOf(origin.x + x, origin.y + idx), kSouth);
+    }
+
+    /// ForEachNeighbour - Call functor(neighbourIndex, direction) on each neighbour of the cell in the grid.
+    ///
+    /// @param index the index of the cell.
+    /// @param functor the functor to be called on each neighbour.
+    ///
+    /// @return void.
+    template <typename Functor>
+    void ForEachNeighbour(Index index, Functor functor) const
+    {
+      const Point kPoint = PointOf(index);
+      if (kPoint.y > 0) functor(Neighbour(index, kNorth), kNorth);
+      if (kPoint.x + 1 < Width()) functor(Neighbour(index, kEast), kEast);
+      if (kPoint.y + 1 < Height()) functor(Neighbour(index, kSouth), kSouth);
+      if (kPoint.x > 0) functor(Neighbour(index, kWest), kWest);
+    }
+
+    /// ForEachConnected - Call functor(neighbourIndex, direction) on each neighbour connected to the cell.
+    ///
+    /// @param index the index of the cell.
+    /// @param functor the functor to be called on each connected neighbour.
+    ///
+    /// @return void.
+    template <typename Functor>
+    void ForEachConnected(Index index, Functor functor) const
+    {
+      for (uint8_t direction = kNorth; direction <= kWest; ++direction)
+        if ((this->links[index] >> direction) & 1)
+          functor(Neighbour(index, static_cast<GridDirection>(direction)), static_cast<GridDirection>(direction));
+    }
+
+    // Accessors
+    CellInfo& Info(Index index) { return this->infos[index]; }
+    const CellInfo& Info(Index index) const { return this->infos[index]; }
+    CellInfo& Info(const Point& point) { return this->infos[IndexOf(point)]; }
+    const CellInfo& Info(const Point& point) const { return this->infos[IndexOf(point)]; }
+    const uint8_t* LinksData() const { return this->links.data(); }
+    uint8_t* LinksData() { return this->links.data(); }
+    const CellInfo* InfosData() const { return this->infos.data(); }
+    CellInfo* InfosData() { return this->infos.data(); }
+
+  private:
+    FlatGrid operator=(FlatGrid&);  // Not Implemented
+
+    Layout layout;                  // Mapping of the coordinates to the indexes
+    std::vector<uint8_t> links;     // Connection mask of each index (bit set per GridDirection)
+    std::vector<CellInfo> infos;    // Extra information of each index
+
+    /// Direction from first to second, false if they are not orthogonal neighbours within the grid.
+    bool DirectionTo(const Point& first, const Point& second, GridDirection& direction) const
+    {
+      if (first.x >= Width() || first.y >= Height() || second.x >= Width() || second.y >= Height())
+        return false;
+
+      if (first.y == second.y && first.x + 1 == second.x) direction = kEast;
+      else if (first.y == second.y && second.x + 1 == first.x) direction = kWest;
+      else if (first.x == second.x && first.y + 1 == second.y) direction = kSouth;
+      else if (first.x == second.x && second.y + 1 == first.y) direction = kNorth;
+      else return false;
+      return true;
+    }
+  };
+
+  /// ToFlatGrid - Copy a Grid within a FlatGrid: orthogonal connections and CellInfo of the cells.
+  ///
+  /// @tparam Layout the layout of the FlatGrid.
+  /// @tparam CellInfo the struct storing extra information associated with each cell.
+  /// @tparam Allocator the allocator template of the Grid.
+  ///
+  /// @param grid the grid to be copied.
+  ///
+  /// @return the FlatGrid to be owned.
+  template <typename Layout = RowMajorLayout, typename CellInfo, template <typename> class Allocator>
+  std::unique_ptr<FlatGrid<CellInfo, Layout>> ToFlatGrid(const Grid<CellInfo, Allocator>& grid)
+  {
+    typedef FlatGrid<CellInfo, Layout> Flat;
+    typedef typename Flat::Point Point;
+    std::unique_ptr<Flat> flatGrid(new Flat(grid.Width(), grid.Height()));
+    for (uint32_t x = 0; x < grid.Width(); ++x)
+      for (uint32_t y = 0; y < grid.Height(); ++y)
+      {
+        flatGrid->Info(Point(x, y)) = grid[x][y]->info;
+        const auto& kConnected = grid[x][y]->connectedCells;
+        for (auto it = kConnected.begin(); it != kConnected.end(); ++it)
+          if (auto cell = it->lock())
+            flatGrid->Connect(Point(x, y), Point(cell->x, cell->y));
+      }
+    return flatGrid;
+  }
+}
+
+#endif // MODULE_DS_FLAT_GRID_HXX
@@ -0,0 +1,199 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#ifndef MODULE_DS_FLAT_HASH_COUNTER_HXX
+#define MODULE_DS_FLAT_HASH_COUNTER_HXX
+
+// STD includes
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace huc
+{
+  /// @class FlatHashCounter
+  ///
+  /// A Flat Hash Counter keeps the number of occurrences of each key within an open-addressing table.
+  /// Keys, counts and slot states are stored in three contiguous arrays and collisions are resolved by
+  /// linear probing over a power of two capacity.
+  ///
+  /// Keys are never removed from the table: a count can reach zero while the key keeps its slot, which
+  /// avoids tombstones and keeps the probing sequences valid.
+  ///
+  /// @advantages
+  /// - A handful of allocations for the whole table instead of one node per key (std::map, std::multiset).
+  /// - Probing sequences walk contiguous memory and are cache friendly.
+  ///
+  /// @drawbacks
+  /// - Memory is proportional to the number of distinct keys ever inserted, even once their count is 0.
+  /// - The quality of the probing depends on the hash function (a multiplicative mix is applied on top).
+  ///
+  /// @tparam Key type of the counted keys.
+  /// @tparam Hash functor type used to hash the keys.
+  /// @tparam KeyEqual functor type used to compare the keys.
+  template <typename Key, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+  class FlatHashCounter
+  {
+  public:
+    /// FlatHashCounter constructor.
+    ///
+    /// @param expectedSize number of distinct keys expected, used to size the table up-front.
+    explicit FlatHashCounter(size_t expectedSize = 0) : size(0), shift(64) { Reserve(expectedSize); }
+
+    /// Reserve - Make sure the table can hold expectedSize distinct keys without growing.
+    ///
+    /// @param expectedSize number of distinct keys expected.
+    ///
+    /// @return void.
+    void Reserve(size_t expectedSize)
+    {
+      // Keep the load factor below 1/2
+      size_t capacity = kMinCapacity;
+      while (capacity < 2 * expectedSize)
+        capacity <<= 1;
+
+      if (capacity > this->keys.size())
+        Rehash(capacity);
+    }
+
+    /// Add - Increase the count of key.
+    ///
+    /// @param key the key to be counted.
+    /// @param n the number of occurrences to add.
+    ///
+    /// @return the new count of the key.
+    size_t Add(const Key& key, size_t n = 1)
+    {
+      if (2 * (this->size + 1) > this->keys.size())
+        Rehash(2 * this->keys.size());
+
+      const size_t slot = FindSlot(key);
+      if (!this->used[slot])
+      {
+        this->used[slot] = 1;
+        this->keys[slot] = key;
+        ++this->size;
+      }
+
+      return this->counts[slot] += n;
+    }
+
+    /// Consume - Decrease by one the count of key if the key has a positive count.
+    ///
+    /// @param key the key to be consumed.
+    ///
+    /// @return true if an occurrence has been consumed, false otherwise.
+    bool Consume(const Key& key)
+    {
+      const size_t slot = FindSlot(key);
+      if (!this->used[slot] || this->counts[slot] == 0)
+        return false;
+
+      --this->counts[slot];
+      return true;
+    }
+
+    /// Count - Retrieve the number of occurrences of key.
+    ///
+    /// @param key the searched key.
+    ///
+    /// @return the count of the key, 0 if never added.
+    size_t Count(const Key& key) const
+    {
+      const size_t slot = FindSlot(key);
+      return (this->used[slot]) ? this->counts[slot] : 0;
+    }
+
+    /// ForEach - Call functor(key, count) on each key ever added to the counter.
+    ///
+    /// @param functor the functor to be called on each (key, count) pair.
+    ///
+    /// @return void.
+    template <typename Functor>
+    void ForEach(Functor functor) const
+    {
+      for (size_t slot = 0; slot < this->keys.size(); ++slot)
+        if (this->used[slot])
+          functor(this->keys[slot], this->counts[slot]);
+    }
+
+    /// Clear - Remove all the keys while keeping the allocated capacity.
+    ///
+    /// @return void.
+    void Clear()
+    {
+      std::fill(this->used.begin(), this->used.end(), 0);
+      std::fill(this->counts.begin(), this->counts.end(), 0);
+      this->size = 0;
+    }
+
+    size_t Size() const { return this->size; }
+    size_t Capacity() const { return this->keys.size(); }
+
+  private:
+    static const size_t kMinCapacity = 16;
+
+    std::vector<Key> keys;       // Keys stored per slot
+    std::vector<size_t> counts;  // Count of the key stored at the same slot
+    std::vector<uint8_t> used;   // Whether a slot holds a key
+    size_t size;                 // Number of distinct keys
+    uint32_t shift;              // 64 - log2(capacity): keeps the top bits of the mixed hash
+
+    /// Mix the hash (Fibonacci hashing) so that weak hash functions (e.g. identity) spread well: the top bits
+    /// of the product depend on every bit of the hash, the low ones only on the low bits.
+    size_t HomeSlot(const Key& key) const
+    { return static_cast<size_t>((static_cast<uint64_t>(Hash()(key)) * 0x9E3779B97F4A7C15ull) >> this->shift); }
+
+    /// Return the slot containing key, or the empty slot where it should be inserted.
+    size_t FindSlot(const Key& key) const
+    {
+      const size_t mask = this->keys.size() - 1;
+      size_t slot = HomeSlot(key);
+      while (this->used[slot] && !KeyEqual()(this->keys[slot], key))
+        slot = (slot + 1) & mask;
+      return slot;
+    }
+
+    void Rehash(size_t capacity)
+    {
+      std::vector<Key> oldKeys(capacity);
+      std::vector<size_t> oldCounts(capacity, 0);
+      std::vector<uint8_t> oldUsed(capacity, 0);
+      oldKeys.swap(this->keys);
+      oldCounts.swap(this->counts);
+      oldUsed.swap(this->used);
+
+      this->shift = 64;
+      for (size_t bits = capacity; bits > 1; bits >>= 1)
+        --this->shift;
+
+      for (size_t i = 0; i < oldKeys.size(); ++i)
+        if (oldUsed[i])
+        {
+          const size_t slot = FindSlot(oldKeys[i]);
+          this->used[slot] = 1;
+          this->keys[slot] = oldKeys[i];
+          this->counts[slot] = oldCounts[i];
+        }
+    }
+  };
+}
+
+#endif // MODULE_DS_FLAT_HASH_COUNTER_HXX
@@ -39,17 +39,27 @@ namespace huc
   /// The grid class may be used to generate all kind of networks/graphs/mazes with uniform and othonormal
   /// cell positionning.
   ///
+  /// The Allocator policy allocates each cell together with its shared_ptr control block
+  /// (std::allocate_shared) and the nodes of its connectedCells set: with PoolAllocator (cf. node_pool.hxx)
+  /// all of them are carved out of a per-grid NodePool, so that building and destroying the grid touch a
+  /// handful of large blocks instead of millions of small ones. The pool lives as long as one of its cells.
+  ///
   /// @tparam CellInfo a struct used to store extra information associated with each Grid::Cell
-  template <typename CellInfo = CellInfoBase>
+  /// @tparam Allocator standard allocator template used for the cells and their connections.
+  template <typename CellInfo = CellInfoBase, template <typename> class Allocator = std::allocator>
   class Grid
   {
   public:
+    class Cell;
+
     /// Grid constructor.
     ///
     /// @param width the desired width for the Grid.
     /// @param height the desired height for the Grid.
     /// @param isConnected whether or not the cells of the grid are connected at the initialization.
-    explicit Grid(uint32_t width, uint32_t height, bool isConnected = false)
+    /// @param allocator the allocator of the cells and their connections.
+    explicit Grid(uint32_t width, uint32_t height, bool isConnected = false,
+                  const Allocator<Cell>& allocator = Allocator<Cell>()) : allocator(allocator)
     { Init(width, height, isConnected); }
 
     /// Point struct is a convenient struct use to represent a 2D point for a grid (index position).
@@ -64,12 +74,15 @@ namespace huc
     /// It handles a set of its connection to other nodes and extra information passed as template parameter.
     class Cell {
     public:
-      Cell(uint32_t x, uint32_t y) : x(x), y(y) {}
+      typedef Allocator<std::weak_ptr<Cell>> ConnectionAllocator;
+
+      Cell(uint32_t x, uint32_t y, const ConnectionAllocator& allocator = ConnectionAllocator()) :
+        x(x), y(y), connectedCells(std::owner_less<std::weak_ptr<Cell>>(), allocator) {}
 
       const uint32_t x; // X coordinate
       const uint32_t y; // Y coordinate
 
-      std::set<std::weak_ptr<Cell>, std::owner_less<std::weak_ptr<Cell>>>
+      std::set<std::weak_ptr<Cell>, std::owner_less<std::weak_ptr<Cell>>, ConnectionAllocator>
         connectedCells;  // Direct connections from this cell (!do not use shared_ptr to avoid cycle!)
       CellInfo info;     // Use to store extra information
 
@@ -191,6 +204,7 @@ namespace huc
 
     uint32_t Width() const { return data.size(); }
     uint32_t Height() const { return (data.size() > 0) ? data[0].size() : 0; }
+    const Allocator<Cell>& GetAllocator() const { return this->allocator; }
 
     // Accessors
     std::vector<std::shared_ptr<Cell>>& operator[] (size_t n) { return this->data[n]; }
@@ -198,18 +212,20 @@ namespace huc
 
   private:
     Grid operator=(Grid&);                                // Not Implemented
+    Allocator<Cell> allocator;                            // Allocator of the cells and their connections
     std::vector<std::vector<std::shared_ptr<Cell>>> data; // Grid wrapper
 
     void Init(uint32_t width, uint32_t height, bool isConneccted)
     {
-      // Generate the Grid
+      // Generate the Grid - each cell shares a single allocation with its control block
+      const typename Cell::ConnectionAllocator kConnectionAllocator(this->allocator);
       this->data.resize(width);
       for (uint32_t x = 0; x < width; ++x)
       {
         this->data[x].reserve(height);
         for (uint32_t y = 0; y < height; ++y)
         {
-          this->data[x].push_back(std::shared_ptr<Cell>(new Cell(x, y)));
+          this->data[x].push_back(std::allocate_shared<Cell>(this->allocator, x, y, kConnectionAllocator));
 
           // Connect West
           if (isConneccted && x > 0)
@@ -0,0 +1,411 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#ifndef MODULE_DS_GRID_FILE_HXX
+#define MODULE_DS_GRID_FILE_HXX
+
+#include <DataStructures/flat_grid.hxx>
+
+// STD includes
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if !defined(_WIN32)
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <sys/types.h>
+  #include <unistd.h>
+#endif
+
+namespace huc
+{
+  /// GridFileHeader - First 64 bytes of a grid file, in the byte order of the host which wrote it.
+  ///
+  /// The header is followed by the links section: one row after the other, each row padded to whole
+  /// bytes, with 2 bits per cell (bit 0: connected to East, bit 1: connected to South; North and West are
+  /// read from the neighbours). The optional infos section holds the raw CellInfo of each cell in index
+  /// order (y * width + x) at a 64 bytes aligned offset.
+  struct GridFileHeader
+  {
+    enum : uint64_t { kMagic = 0x3144495247435548ull };  // Reads "HUCGRID1" on little endian hosts
+    enum : uint32_t { kVersion = 1 };
+
+    uint64_t magic;          // kMagic, a mismatch also reveals a byte order mismatch
+    uint32_t version;        // Format version
+    uint32_t headerSize;     // sizeof(GridFileHeader)
+    uint32_t width;          // Number of columns
+    uint32_t height;         // Number of rows
+    uint32_t generatorId;    // Identifier of the generator of the maze, free for the application
+    uint32_t infoLayoutId;   // Identifier of the CellInfo layout, free for the application
+    uint64_t seed;           // Seed of the generator
+    uint32_t infoSize;       // sizeof(CellInfo), 0 without infos section
+    uint32_t infoAlignment;  // alignof(CellInfo), 0 without infos section
+    uint64_t linksOffset;    // Offset of the links section
+    uint64_t infosOffset;    // Offset of the infos section, 0 without infos section
+
+    /// RowBytes - Number of bytes of a row of the links section.
+    uint64_t RowBytes() const { return (static_cast<uint64_t>(this->width) + 3) / 4; }
+
+    /// FitsWithin - Whether the sections lie within a file of size bytes. The fields being read from the
+    /// file, each offset and product is checked against the remaining bytes before being added: corrupt
+    /// fields cannot wrap the sums around.
+    bool FitsWithin(uint64_t size) const
+    {
+      if (this->linksOffset > size ||
+          (this->height > 0 && RowBytes() > (size - this->linksOffset) / this->height))
+        return false;
+      if (this->infoSize == 0)
+        return true;
+
+      const uint64_t kCellCount = static_cast<uint64_t>(this->width) * this->height;
+      return this->infosOffset <= size &&
+             (kCellCount == 0 || this->infoSize <= (size - this->infosOffset) / kCellCount);
+    }
+  };
+  static_assert(sizeof(GridFileHeader) == 64, "The grid file header must be 64 bytes long");
+
+  /// @class GridFileWriter
+  ///
+  /// Grid File Writer streams a grid to a file row by row (cf. GridFileHeader): the links and the infos
+  /// sections are written sequentially through two handles on the same file, so that the whole grid never
+  /// has to be in memory.
+  ///
+  /// @tparam CellInfo a trivially copyable struct stored with each cell, if any.
+  template <typename CellInfo = CellInfoBase>
+  class GridFileWriter
+  {
+  public:
+    /// Open - Create (or truncate) the file at path and write its header.
+    ///
+    /// @param path the path of the file.
+    /// @param width,height the dimensions of the grid.
+    /// @param generatorId,seed the generator of the grid and its seed.
+    /// @param withInfos whether the infos section is written.
+    /// @param infoLayoutId identifier of the CellInfo layout, checked at loading.
+    ///
+    /// @return the writer, nullptr if the file cannot be created.
+    static std::unique_ptr<GridFileWriter> Open(const std::string& path, uint32_t width, uint32_t height,
+                                                uint32_t generatorId, uint64_t seed, bool withInfos = false,
+                                                uint32_t infoLayoutId = 0)
+    {
+      GridFileHeader header;
+      std::memset(&header, 0, sizeof(header));
+      header.magic = GridFileHeader::kMagic;
+      header.version = GridFileHeader::kVersion;
+      header.headerSize = sizeof(GridFileHeader);
+      header.width = width;
+      header.height = height;
+      header.generatorId = generatorId;
+      header.infoLayoutId = infoLayoutId;
+      header.seed = seed;
+      header.infoSize = withInfos ? static_cast<uint32_t>(sizeof(CellInfo)) : 0;
+      header.infoAlignment = withInfos ? static_cast<uint32_t>(std::alignment_of<CellInfo>::value) : 0;
+      header.linksOffset = sizeof(GridFileHeader);
+      header.infosOffset = withInfos ? (header.linksOffset + header.RowBytes() * height + 63) / 64 * 64 : 0;
+
+      std::unique_ptr<GridFileWriter> writer(new GridFileWriter(header));
+      writer->links = std::fopen(path.c_str(), "wb");
+      if (!writer->links || std::fwrite(&header, sizeof(header), 1, writer->links) != 1)
+        return nullptr;
+
+      if (withInfos)
+      {
+        // Second handle positioned on the infos section, the gap being filled with zeros
+        std::fflush(writer->links);
+        writer->infos = std::fopen(path.c_str(), "r+b");
+        if (!writer->infos || !Seek(writer->infos, header.linksOffset + header.RowBytes() * height))
+          return nullptr;
+        const std::vector<uint8_t> kPad(header.infosOffset - header.linksOffset - header.RowBytes() * height);
+        if (!kPad.empty() && std::fwrite(kPad.data(), 1, kPad.size(), writer->infos) != kPad.size())
+          return nullptr;
+      }
+      return writer;
+    }
+
+    ~GridFileWriter() { Close(); }
+
+    /// WriteRow - Append the next row of the grid.
+    ///
+    /// @param links the connection masks (cf. FlatGrid::Links) of the width cells of the row.
+    ///
+    /// @return false if the row could not be written, if all rows were already written or if the infos
+    /// of the row are expected.
+    bool WriteRow(const uint8_t* links)
+    { return this->header.infoSize == 0 && WriteLinks(links); }
+
+    /// WriteRow - Append the next row of the grid along with its infos.
+    ///
+    /// @param links the connection masks (cf. FlatGrid::Links) of the width cells of the row.
+    /// @param infos the CellInfo of the width cells of the row.
+    ///
+    /// @return false if the row could not be written, if all rows were already written or if the file
+    /// has no infos section.
+    bool WriteRow(const uint8_t* links, const CellInfo* infos)
+    {
+      static_assert(std::is_trivially_copyable<CellInfo>::value, "CellInfo must be trivially copyable");
+      if (this->header.infoSize == 0 || !WriteLinks(links))
+        return false;
+      return std::fwrite(infos, sizeof(CellInfo), this->header.width, this->infos) == this->header.width;
+    }
+
+    /// Close - Flush and close the file.
+    ///
+    /// @return true if all the rows have been successfully written.
+    bool Close()
+    {
+      bool isValid = this->rowCount == this->header.height;
+      if (this->links)
+        isValid = (std::fclose(this->links) == 0) && isValid;
+      if (this->infos)
+        isValid = (std::fclose(this->infos) == 0) && isValid;
+      this->links = this->infos = nullptr;
+      return isValid;
+    }
+
+    uint32_t RowCount() const { return this->rowCount; }
+    const GridFileHeader& Header() const { return this->header; }
+
+  private:
+    GridFileWriter(const GridFileWriter&);             // Not Implemented
+    GridFileWriter operator=(const GridFileWriter&);   // Not Implemented
+
+    explicit GridFileWriter(const GridFileHeader& header) :
+      header(header), links(nullptr), infos(nullptr), rowCount(0), row(header.RowBytes()) {}
+
+    GridFileHeader header;    // Header written at the beginning of the file
+    std::FILE* links;         // Handle writing the header and the links section
+    std::FILE* infos;         // Handle writing the infos section
+    uint32_t rowCount;        // Number of rows already written
+    std::vector<uint8_t> row; // Packed links of a row
+
+    bool WriteLinks(const uint8_t* links)
+    {
+      if (!this->links || this->rowCount >= this->header.height)
+        return false;
+
+      std::fill(this->row.begin(), this->row.end(), 0);
+      for (uint32_t x = 0; x < this->header.width; ++x)
+      {
+        const uint8_t kBits = static_cast<uint8_t>(((links[x] >> kEast) & 1) | (((links[x] >> kSouth) & 1) << 1));
+        this->row[x / 4] |= static_cast<uint8_t>(kBits << (2 * (x % 4)));
+      }
+      if (std::fwrite(this->row.data(), 1, this->row.size(), this->links) != this->row.size())
+        return false;
+
+      ++this->rowCount;
+      return true;
+    }
+
+    static bool Seek(std::FILE* file, uint64_t offset)
+    {
+#if defined(_WIN32)
+      return _fseeki64(file, static_cast<__int64>(offset), SEEK_SET) == 0;
+#else
+      return fseeko(file, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+    }
+  };
+
+  /// @class MappedGrid
+  ///
+  /// Mapped Grid gives a read-only access to a grid file (cf. GridFileHeader) mapped in memory: opening
+  /// only checks the header, pages are loaded by the system when cells are accessed. Without mmap
+  /// (Windows) the file is read in memory.
+  ///
+  /// @tparam CellInfo a trivially copyable struct stored with each cell, if any.
+  template <typename CellInfo = CellInfoBase>
+  class MappedGrid
+  {
+  public:
+    typedef typename FlatGrid<CellInfo>::Index Index;
+
+    /// Open - Map the grid file at path.
+    ///
+    /// @param path the path of the file.
+    /// @param infoLayoutId identifier of the CellInfo layout the infos section must have been written with.
+    ///
+    /// @return the mapped grid, nullptr if the file cannot be read or if its header, size or CellInfo
+    /// layout do not match.
+    static std::unique_ptr<MappedGrid> Open(const std::string& path, uint32_t infoLayoutId = 0)
+    {
+      std::unique_ptr<MappedGrid> grid(new MappedGrid());
+#if !defined(_WIN32)
+      const int kFile = ::open(path.c_str(), O_RDONLY);
+      if (kFile < 0)
+        return nullptr;
+      struct stat status;
+      if (fstat(kFile, &status) == 0 && status.st_size >= static_cast<off_t>(sizeof(GridFileHeader)))
+      {
+        void* data = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_SHARED, kFile, 0);
+        if (data != MAP_FAILED)
+        {
+          grid->data = static_cast<const uint8_t*>(data);
+          grid->size = static_cast<uint64_t>(status.st_size);
+        }
+      }
+      ::close(kFile);
+#else
+      std::FILE* file = std::fopen(path.c_str(), "rb");
+      if (!file)
+        return nullptr;
+      uint8_t buffer[1 << 16];
+      for (size_t read; (read = std::fread(buffer, 1, sizeof(buffer), file)) > 0;)
+        grid->buffer.insert(grid->buffer.end(), buffer, buffer + read);
+      std::fclose(file);
+      grid->data = grid->buffer.data();
+      grid->size = grid->buffer.size();
+#endif
+      if (!grid->data || grid->size < sizeof(GridFileHeader))
+        return nullptr;
+
+      const GridFileHeader& kHeader = grid->Header();
+      if (kHeader.magic != GridFileHeader::kMagic || kHeader.version != GridFileHeader::kVersion ||
+          kHeader.headerSize != sizeof(GridFileHeader) || kHeader.linksOffset != sizeof(GridFileHeader) ||
+          !kHeader.FitsWithin(grid->size))
+        return nullptr;
+      if (kHeader.infoSize > 0 &&
+          (kHeader.infoSize != sizeof(CellInfo) || kHeader.infoAlignment != std::alignment_of<CellInfo>::value ||
+           kHeader.infoLayoutId != infoLayoutId || kHeader.infosOffset % kHeader.infoAlignment != 0 ||
+           kHeader.infosOffset < kHeader.linksOffset + kHeader.RowBytes() * kHeader.height))
+        return nullptr;
+
+      return grid;
+    }
+
+    ~MappedGrid()
+    {
+#if !defined(_WIN32)
+      if (this->data)
+        munmap(const_cast<uint8_t*>(this->data), static_cast<size_t>(this->size));
+#endif
+    }
+
+    const GridFileHeader& Header() const { return *reinterpret_cast<const GridFileHeader*>(this->data); }
+    uint32_t Width() const { return Header().width; }
+    uint32_t Height() const { return Header().height; }
+    Index Size() const { return static_cast<Index>(Width()) * Height(); }
+    uint32_t GeneratorId() const { return Header().generatorId; }
+    uint64_t Seed() const { return Header().seed; }
+    bool HasInfos() const { return Header().infoSize > 0; }
+
+    /// Links - Return the 4 bits mask of the directions the cell at (x, y) is connected to (cf. FlatGrid).
+    uint8_t Links(uint32_t x, uint32_t y) const
+    {
+      return static_cast<uint8_t>(((Bits(x, y) & 1) << kEast) | ((Bits(x, y) >> 1) << kSouth) |
+                                  ((x > 0) ? (Bits(x - 1, y) & 1) << kWest : 0) |
+                                  ((y > 0) ? (Bits(x, y - 1) >> 1) << kNorth : 0));
+    }
+
+    /// IsConnected - Whether the cell at (x, y) is connected to its neighbour in the direction.
+    bool IsConnected(uint32_t x, uint32_t y, GridDirection direction) const
+    { return (Links(x, y) >> direction) & 1; }
+
+    /// Info - CellInfo of the cell at index (y * width + x), read in place from the mapped file.
+    ///
+    /// @warning the file must have an infos section (cf. HasInfos).
+    const CellInfo& Info(Index index) const
+    {
+      static_assert(std::is_trivially_copyable<CellInfo>::value, "CellInfo must be trivially copyable");
+      return reinterpret_cast<const CellInfo*>(this->data + Header().infosOffset)[index];
+    }
+
+    /// ToFlatGrid - Copy the mapped grid within a FlatGrid (infos are left default if not stored).
+    ///
+    /// @tparam Layout the layout of the FlatGrid.
+    ///
+    /// @return the FlatGrid to be owned.
+    template <typename Layout = RowMajorLayout>
+    std::unique_ptr<FlatGrid<CellInfo, Layout>> ToFlatGrid() const
+    {
+      std::unique_ptr<FlatGrid<CellInfo, Layout>> grid(new FlatGrid<CellInfo, Layout>(Width(), Height()));
+      uint8_t* links = grid->LinksData();
+      Index fileIndex = 0;
+      for (uint32_t y = 0; y < Height(); ++y)
+        for (uint32_t x = 0; x < Width(); ++x, ++fileIndex)
+        {
+          links[grid->IndexOf(x, y)] = Links(x, y);
+          if (HasInfos())
+            grid->Info(grid->IndexOf(x, y)) = Info(fileIndex);
+        }
+      return grid;
+    }
+
+  private:
+    MappedGrid(const MappedGrid&);             // Not Implemented
+    MappedGrid operator=(const MappedGrid&);   // Not Implemented
+
+    MappedGrid() : data(nullptr), size(0) {}
+
+    const uint8_t* data;         // Content of the file
+    uint64_t size;               // Size of the file
+#if defined(_WIN32)
+    std::vector<uint8_t> buffer; // Content of the file read in memory
+#endif
+
+    /// Packed East (bit 0) and South (bit 1) links of the cell at (x, y).
+    uint8_t Bits(uint32_t x, uint32_t y) const
+    {
+      const uint8_t kByte = this->data[Header().linksOffset + y * Header().RowBytes() + x / 4];
+      return static_cast<uint8_t>((kByte >> (2 * (x % 4))) & 3);
+    }
+  };
+
+  /// SaveGrid - Stream a FlatGrid to a grid file (cf. GridFileWriter), gathering it row by row whatever
+  /// its layout.
+  ///
+  /// @param grid the grid to be saved.
+  /// @param path the path of the file.
+  /// @param generatorId,seed the generator of the grid and its seed.
+  /// @param withInfos whether the CellInfo of the cells are saved.
+  /// @param infoLayoutId identifier of the CellInfo layout, checked at loading.
+  ///
+  /// @return true if the grid has been successfully saved.
+  template <typename CellInfo, typename Layout>
+  bool SaveGrid(const FlatGrid<CellInfo, Layout>& grid, const std::string& path, uint32_t generatorId,
+                uint64_t seed, bool withInfos = false, uint32_t infoLayoutId = 0)
+  {
+    auto writer = GridFileWriter<CellInfo>::Open(path, grid.Width(), grid.Height(), generatorId, seed,
+                                                 withInfos, infoLayoutId);
+    if (!writer)
+      return false;
+
+    std::vector<uint8_t> links(grid.Width());
+    std::vector<CellInfo> infos(withInfos ? grid.Width() : 0);
+    for (uint32_t y = 0; y < grid.Height(); ++y)
+    {
+      for (uint32_t x = 0; x < grid.Width(); ++x)
+      {
+        links[x] = grid.Links(grid.IndexOf(x, y));
+        if (withInfos)
+          infos[x] = grid.Info(grid.IndexOf(x, y));
+      }
+      if (withInfos ? !writer->WriteRow(links.data(), infos.data()) : !writer->WriteRow(links.data()))
+        return false;
+    }
+    return writer->Close();
+  }
+}
+
+#endif // MODULE_DS_GRID_FILE_HXX
@@ -0,0 +1,285 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#ifndef MODULE_DS_GRID_LAYOUT_HXX
+#define MODULE_DS_GRID_LAYOUT_HXX
+
+// STD includes
+#include <cstdint>
+
+namespace huc
+{
+  /// GridDirection - Orthogonal directions of a cell, opposite directions differ by their second bit.
+  enum GridDirection : uint8_t { kNorth = 0, kEast = 1, kSouth = 2, kWest = 3 };
+
+  /// OppositeDirection - Return the direction pointing back to the cell from its neighbour.
+  inline GridDirection OppositeDirection(GridDirection direction)
+  { return static_cast<GridDirection>(direction ^ 2); }
+
+  // Grid layouts map the (x, y) coordinates of the cells of a width x height grid to the indexes of their
+  // storage. They all provide:
+  // - Capacity(): the number of indexes, at least width * height (some layouts pad the grid).
+  // - IndexOf(x, y) and PointOf(index, x, y): the mapping and its inverse.
+  // - Neighbour(index, direction): the index of an existing neighbour, without going through coordinates
+  //   whenever possible.
+
+  /// @class RowMajorLayout
+  ///
+  /// Rows stored one after the other: index = y * width + x. East and West neighbours share cache lines,
+  /// North and South ones are a row away.
+  class RowMajorLayout
+  {
+  public:
+    RowMajorLayout(uint32_t width, uint32_t height) : width(width), height(height) {}
+
+    uint32_t Width() const { return this->width; }
+    uint32_t Height() const { return this->height; }
+    uint64_t Capacity() const { return static_cast<uint64_t>(this->width) * this->height; }
+
+    uint64_t IndexOf(uint32_t x, uint32_t y) const { return static_cast<uint64_t>(y) * this->width + x; }
+    void PointOf(uint64_t index, uint32_t& x, uint32_t& y) const
+    {
+      x = static_cast<uint32_t>(index % this->width);
+      y = static_cast<uint32_t>(index / this->width);
+    }
+
+    uint64_t Neighbour(uint64_t index, GridDirection direction) const
+    {
+      switch (direction)
+      {
+        case kNorth: return index - this->width;
+        case kEast: return index + 1;
+        case kSouth: return index + this->width;
+        default: return index - 1;
+      }
+    }
+
+  private:
+    uint32_t width;   // Number of columns
+    uint32_t height;  // Number of rows
+  };
+
+  /// @class ColumnMajorLayout
+  ///
+  /// Columns stored one after the other: index = x * height + y, the layout of Grid (data[x][y]).
+  class ColumnMajorLayout
+  {
+  public:
+    ColumnMajorLayout(uint32_t width, uint32_t height) : width(width), height(height) {}
+
+    uint32_t Width() const { return this->width; }
+    uint32_t Height() const { return this->height; }
+    uint64_t Capacity() const { return static_cast<uint64_t>(this->width) * this->height; }
+
+    uint64_t IndexOf(uint32_t x, uint32_t y) const { return static_cast<uint64_t>(x) * this->height + y; }
+    void PointOf(uint64_t index, uint32_t& x, uint32_t& y) const
+    {
+      x = static_cast<uint32_t>(index / this->height);
+      y = static_cast<uint32_t>(index % this->height);
+    }
+
+    uint64_t Neighbour(uint64_t index, GridDirection direction) const
+    {
+      switch (direction)
+      {
+        case kNorth: return index - 1;
+        case kEast: return index + this->height;
+        case kSouth: return index + 1;
+        default: return index - this->height;
+      }
+    }
+
+  private:
+    uint32_t width;   // Number of columns
+    uint32_t height;  // Number of rows
+  };
+
+  /// @class TiledLayout
+  ///
+  /// Square tiles of 2^TileBits x 2^TileBits cells stored row-major one after the other, cells being
+  /// row-major within each tile. With the default 8 x 8 tiles of one byte cells, a tile fills a cache
+  /// line and the four neighbours of a cell are within its tile most of the time.
+  /// The grid is padded to whole tiles.
+  ///
+  /// @tparam TileBits the base 2 logarithm of the side of the tiles.
+  template <uint32_t TileBits = 3>
+  class TiledLayout
+  {
+  public:
+    enum : uint32_t { kTileSide = 1u << TileBits, kTileMask = kTileSide - 1 };
+
+    TiledLayout(uint32_t width, uint32_t height) : width(width), height(height),
+      tilesPerRow((static_cast<uint64_t>(width) + kTileMask) >> TileBits),
+      tilesPerCol((static_cast<uint64_t>(height) + kTileMask) >> TileBits) {}
+
+    uint32_t Width() const { return this->width; }
+    uint32_t Height() const { return this->height; }
+    uint64_t Capacity() const { return (this->tilesPerRow * this->tilesPerCol) << (2 * TileBits); }
+
+    uint64_t IndexOf(uint32_t x, uint32_t y) const
+    {
+      const uint64_t kTile = (y >> TileBits) * this->tilesPerRow + (x >> TileBits);
+      return (kTile << (2 * TileBits)) | ((y & kTileMask) << TileBits) | (x & kTileMask);
+    }
+
+    void PointOf(uint64_t index, uint32_t& x, uint32_t& y) const
+    {
+      const uint64_t kTile = index >> (2 * TileBits);
+      x = static_cast<uint32_t>(((kTile % this->tilesPerRow) << TileBits) | (index & kTileMask));
+      y = static_cast<uint32_t>(((kTile / this->tilesPerRow) << TileBits) | ((index >> TileBits) & kTileMask));
+    }
+
+    uint64_t Neighbour(uint64_t index, GridDirection direction) const
+    {
+      // Within the tile
+      switch (direction)
+      {
+        case kNorth: if ((index >> TileBits) & kTileMask) return index - kTileSide; break;
+        case kEast: if ((index & kTileMask) != kTileMask) return index + 1; break;
+        case kSouth: if (((index >> TileBits) & kTileMask) != kTileMask) return index + kTileSide; break;
+        default: if (index & kTileMask) return index - 1; break;
+      }
+
+      // Across tiles
+      uint32_t x, y;
+      PointOf(index, x, y);
+      switch (direction)
+      {
+        case kNorth: return IndexOf(x, y - 1);
+        case kEast: return IndexOf(x + 1, y);
+        case kSouth: return IndexOf(x, y + 1);
+        default: return IndexOf(x - 1, y);
+      }
+    }
+
+  private:
+    uint32_t width;        // Number of columns
+    uint32_t height;       // Number of rows
+    uint64_t tilesPerRow;  // Number of tiles along a row
+    uint64_t tilesPerCol;  // Number of tiles along a column
+  };
+
+  /// @class MortonLayout
+  ///
+  /// Morton (Z-order) curve: the bits of x and y are interleaved so that any aligned square of 2^k x 2^k
+  /// cells is contiguous, whatever k. Only the low bits common to both dimensions are interleaved, the
+  /// remaining high bits of the longest dimension select the square: padding stays below 4 times the grid.
+  ///
+  /// Neighbours are found by dilated arithmetic on the interleaved bits (x on even bits, y on odd bits).
+  class MortonLayout
+  {
+  public:
+    MortonLayout(uint32_t width, uint32_t height) : width(width), height(height),
+      bits(CeilLog2(width) < CeilLog2(height) ? CeilLog2(width) : CeilLog2(height)),
+      lowMask((bits < 32) ? (uint64_t(1) << (2 * bits)) - 1 : ~uint64_t(0)),
+      xMask(0x5555555555555555ull & lowMask),
+      yMask(0xAAAAAAAAAAAAAAAAull & lowMask) {}
+
+    uint32_t Width() const { return this->width; }
+    uint32_t Height() const { return this->height; }
+    uint64_t Capacity() const
+    {
+      const uint64_t kLongest = (this->width > this->height) ? this->width : this->height;
+      return (this->width == 0 || this->height == 0) ? 0 :
+        ((kLongest + (uint64_t(1) << this->bits) - 1) >> this->bits) << (2 * this->bits);
+    }
+
+    uint64_t IndexOf(uint32_t x, uint32_t y) const
+    {
+      const uint64_t kLowMask = (uint64_t(1) << this->bits) - 1;
+      const uint64_t kHigh = (static_cast<uint64_t>(x) >> this->bits) | (static_cast<uint64_t>(y) >> this->bits);
+      return (kHigh << (2 * this->bits)) | Dilate(x & kLowMask) | (Dilate(y & kLowMask) << 1);
+    }
+
+    void PointOf(uint64_t index, uint32_t& x, uint32_t& y) const
+    {
+      const uint64_t kHigh = (index >> (2 * this->bits)) << this->bits;
+      x = Compact(index & this->xMask);
+      y = Compact((index & this->yMask) >> 1);
+      if (this->width > this->height)
+        x |= static_cast<uint32_t>(kHigh);
+      else
+        y |= static_cast<uint32_t>(kHigh);
+    }
+
+    uint64_t Neighbour(uint64_t index, GridDirection direction) const
+    {
+      // Within the interleaved square
+      const uint64_t kLow = index & this->lowMask, kHigh = index & ~this->lowMask;
+      const uint64_t kX = kLow & this->xMask, kY = kLow & this->yMask;
+      switch (direction)
+      {
+        case kNorth: if (kY) return kHigh | (((kY - 1) & this->yMask) | kX); break;
+        case kEast: if (kX != this->xMask) return kHigh | (((kLow | this->yMask) + 1) & this->xMask) | kY; break;
+        case kSouth: if (kY != this->yMask) return kHigh | (((kLow | this->xMask) + 1) & this->yMask) | kX; break;
+        default: if (kX) return kHigh | (((kX - 1) & this->xMask) | kY); break;
+      }
+
+      // Across squares
+      uint32_t x, y;
+      PointOf(index, x, y);
+      switch (direction)
+      {
+        case kNorth: return IndexOf(x, y - 1);
+        case kEast: return IndexOf(x + 1, y);
+        case kSouth: return IndexOf(x, y + 1);
+        default: return IndexOf(x - 1, y);
+      }
+    }
+
+  private:
+    uint32_t width;    // Number of columns
+    uint32_t height;   // Number of rows
+    uint32_t bits;     // Number of interleaved bits of each coordinate
+    uint64_t lowMask;  // Mask of the interleaved bits
+    uint64_t xMask;    // Interleaved bits of x (even bits)
+    uint64_t yMask;    // Interleaved bits of y (odd bits)
+
+    static uint32_t CeilLog2(uint32_t value)
+    {
+      uint32_t log = 0;
+      while (log < 32 && (uint64_t(1) << log) < value)
+        ++log;
+      return log;
+    }
+
+    /// Spread the 32 bits of value over the even bits of a 64 bits word.
+    static uint64_t Dilate(uint64_t value)
+    {
+      value = (value | (value << 16)) & 0x0000FFFF0000FFFFull;
+      value = (value | (value << 8)) & 0x00FF00FF00FF00FFull;
+      value = (value | (value << 4)) & 0x0F0F0F0F0F0F0F0Full;
+      value = (value | (value << 2)) & 0x3333333333333333ull;
+      return (value | (value << 1)) & 0x5555555555555555ull;
+    }
+
+    /// Gather the even bits of value (inverse of Dilate).
+    static uint32_t Compact(uint64_t value)
+    {
+      value &= 0x5555555555555555ull;
+      value = (value | (value >> 1)) & 0x3333333333333333ull;
+      value = (value | (value >> 2)) & 0x0F0F0F0F0F0F0F0Full;
+      value = (value | (value >> 4)) & 0x00FF00FF00FF00FFull;
+      value = (value | (value >> 8)) & 0x0000FFFF0000FFFFull;
+      return static_cast<uint32_t>(value | (value >> 16));
+    }
+  };
+}
+
+#endif // MODULE_DS_GRID_LAYOUT_HXX
@@ -0,0 +1,343 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#ifndef MODULE_DS_GRID_N_HXX
+#define MODULE_DS_GRID_N_HXX
+
+#include <DataStructures/grid.hxx>
+
+// STD includes
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace huc
+{
+  /// @class GridN
+  ///
+  /// A GridN is the D dimensional FlatGrid: cells are stored within one contiguous array, axis 0 being the
+  /// fastest varying one (x, then y, then z...), and the connections of each cell are a 2 x D bits mask.
+  ///
+  /// Direction 2 * axis goes backward along the axis and direction 2 * axis + 1 forward, the opposite of a
+  /// direction being direction ^ 1. The direction table (Axis, IsForward, Opposite, Unit) is constexpr and
+  /// the dimension being a template parameter, every loop over the axes or the directions has a compile time
+  /// bound: index arithmetic reduces to the per grid stride table, unrolled by the compiler.
+  ///
+  /// For D = 2 the directions are West, East, North and South; DisconnectHyperplane generalizes
+  /// DisconnectCol (axis 0) and DisconnectRow (axis 1).
+  ///
+  /// @advantages
+  /// - Same storage as FlatGrid whatever the dimension: one mask plus one CellInfo per cell.
+  /// - Neighbours are found by adding a constant offset to the index.
+  ///
+  /// @drawbacks
+  /// - Only orthogonal neighbours can be connected (no diagonals).
+  ///
+  /// @tparam D the number of dimensions, from 1 to 16.
+  /// @tparam CellInfo a struct used to store extra information associated with each cell.
+  template <uint32_t D, typename CellInfo = CellInfoBase>
+  class GridN
+  {
+  public:
+    static_assert(D >= 1 && D <= 16, "GridN supports 1 to 16 dimensions");
+
+    typedef uint64_t Index;
+    typedef uint8_t Direction;
+    typedef std::array<uint32_t, D> Coordinates;
+    typedef typename std::conditional<(D <= 4), uint8_t,
+            typename std::conditional<(D <= 8), uint16_t, uint32_t>::type>::type Mask;
+
+    enum : uint32_t { kDimension = D, kDirectionCount = 2 * D };
+
+    static constexpr uint32_t Axis(Direction direction) { return direction >> 1; }
+    static constexpr bool IsForward(Direction direction) { return (direction & 1) != 0; }
+    static constexpr Direction Opposite(Direction direction) { return direction ^ 1; }
+    static constexpr Direction DirectionOf(uint32_t axis, bool isForward)
+    { return static_cast<Direction>(2 * axis + (isForward ? 1 : 0)); }
+    /// Unit - Component along axis of the unit vector of the direction.
+    static constexpr int32_t Unit(Direction direction, uint32_t axis)
+    { return (Axis(direction) != axis) ? 0 : (IsForward(direction) ? 1 : -1); }
+    static constexpr Mask AllLinks() { return static_cast<Mask>((uint64_t(1) << kDirectionCount) - 1); }
+
+    /// GridN constructor.
+    ///
+    /// @param extents the number of cells along each axis.
+    /// @param isConnected whether or not the cells of the grid are connected at the initialization.
+    explicit GridN(const Coordinates& extents, bool isConnected = false) : extents(extents), size(1)
+    {
+      for (uint32_t axis = 0; axis < D; ++axis)
+      {
+        this->strides[axis] = this->size;
+        this->size *= extents[axis];
+      }
+      for (Direction direction = 0; direction < kDirectionCount; ++direction)
+        this->offsets[direction] = IsForward(direction) ? this->strides[Axis(direction)]
+                                                        : Index(0) - this->strides[Axis(direction)];
+
+      this->links.assign(static_cast<size_t>(this->size), 0);
+      this->infos.resize(static_cast<size_t>(this->size));
+      if (!isConnected)
+        return;
+
+      for (Index index = 0; index < this->size; ++index)
+        for (Direction direction = 0; direction < kDirectionCount; ++direction)
+          if (HasNeighbour(index, direction))
+            this->links[index] |= static_cast<Mask>(Mask(1) << direction);
+    }
+
+    uint32_t Extent(uint32_t axis) const { return this->extents[axis]; }
+    const Coordinates& Extents() const { return this->extents; }
+    Index Size() const { return this->size; }
+    Index Stride(uint32_t axis) const { return this->strides[axis]; }
+
+    Index IndexOf(const Coordinates& coordinates) const
+    {
+      Index index = 0;
+      for (uint32_t axis = 0; axis < D; ++axis)
+        index += coordinates[axis] * this->strides[axis];
+      return index;
+    }
+
+    Coordinates CoordinatesOf(Index index) const
+    {
+      Coordinates coordinates;
+      for (uint32_t axis = 0; axis < D; ++axis)
+      {
+        coordinates[axis] = static_cast<uint32_t>(index % this->extents[axis]);
+        index /= this->extents[axis];
+      }
+      return coordinates;
+    }
+
+    /// Contains - Whether the coordinates are within the grid.
+    bool Contains(const Coordinates& coordinates) const
+    {
+      for (uint32_t axis = 0; axis < D; ++axis)
+        if (coordinates[axis] >= this->extents[axis])
+          return false;
+      return true;
+    }
+
+    /// HasNeighbour - Whether the cell at index has a neighbour within the grid in the direction.
+    bool HasNeighbour(Index index, Direction direction) const
+    {
+      const uint32_t kAxis = Axis(direction);
+      const Index kCoordinate = (index / this->strides[kAxis]) % this->extents[kAxis];
+      return IsForward(direction) ? kCoordinate + 1 < this->extents[kAxis] : kCoordinate > 0;
+    }
+
+    /// Neighbour - Index of the neighbour in the direction.
+    ///
+    /// @warning the neighbour must exist (cf. HasNeighbour).
+    Index Neighbour(Index index, Direction direction) const { return index + this->offsets[direction]; }
+
+    /// Links - Return the 2 x D bits mask of the directions the cell at index is connected to.
+    Mask Links(Index index) const { return this->links[index]; }
+
+    /// IsConnected - Whether the cell at index is connected to its neighbour in the direction.
+    bool IsConnected(Index index, Direction direction) const { return (this->links[index] >> direction) & 1; }
+
+    /// IsConnected - Whether first and second are orthogonal neighbours connected together.
+    bool IsConnected(const Coordinates& first, const Coordinates& second) const
+    {
+      Direction direction;
+      return DirectionTo(first, second, direction) && IsConnected(IndexOf(first), direction);
+    }
+
+    /// Connect with a bidirectionnal link the cell at index and its neighbour in the direction.
+    ///
+    /// @warning the neighbour must exist (cf. HasNeighbour).
+    ///
+    /// @param index the index of the cell to be connected.
+    /// @param direction the direction of the neighbour to be connected.
+    ///
+    /// @return void.
+    void Connect(Index index, Direction direction)
+    {
+      this->links[index] |= static_cast<Mask>(Mask(1) << direction);
+      this->links[Neighbour(index, direction)] |= static_cast<Mask>(Mask(1) << Opposite(direction));
+    }
+
+    /// Connect with a bidirectionnal link first and second.
+    /// Nothing is done if the cells are not orthogonal neighbours.
+    ///
+    /// @param first the cell to be connected to the second cell.
+    /// @param second the cell to be connected to the first cell.
+    ///
+    /// @return void.
+    void Connect(const Coordinates& first, const Coordinates& second)
+    {
+      Direction direction;
+      if (DirectionTo(first, second, direction))
+        Connect(IndexOf(first), direction);
+    }
+
+    /// Disconnect the bidirectionnal link between the cell at index and its neighbour in the direction.
+    ///
+    /// @warning the neighbour must exist (cf. HasNeighbour).
+    ///
+    /// @param index the index of the cell to be disconnected.
+    /// @param direction the direction of the neighbour to be disconnected.
+    ///
+    /// @return void.
+    void Disconnect(Index index, Direction direction)
+    {
+      this->links[index] &= static_cast<Mask>(~(Mask(1) << direction));
+      this->links[Neighbour(index, direction)] &= static_cast<Mask>(~(Mask(1) << Opposite(direction)));
+    }
+
+    /// Disconnect the bidirectionnal link between first and second.
+    /// Nothing is done if the cells are not orthogonal neighbours.
+    ///
+    /// @param first the cell to be disconnected to the second cell.
+    /// @param second the cell to be disconnected to the first cell.
+    ///
+    /// @return void.
+    void Disconnect(const Coordinates& first, const Coordinates& second)
+    {
+      Direction direction;
+      if (DirectionTo(first, second, direction))
+        Disconnect(IndexOf(first), direction);
+    }
+
+    /// Disconnect a hyperplane of cells - Build a wall between connected cells.
+    /// Each cell of the layer origin[axis] + idx within the box starting at origin is disconnected from its
+    /// forward neighbour along axis, except the one at the door.
+    ///
+    /// @param origin the origin point on the grid setting the current relative position.
+    /// @param axis the axis orthogonal to the wall.
+    /// @param idx the relative index along axis of the layer of cells to be disconnected.
+    /// @param sizes the size of wall constructed along each other axis (sizes[axis] is ignored). If it
+    /// exceeds the size of the Grid: wall will be construted until the border.
+    /// @param door the relative coordinates of the path (door) within the wall (door[axis] is ignored).
+    /// No path is created if the door is out of the wall, or if D = 1.
+    ///
+    /// @return void.
+    void DisconnectHyperplane(const Coordinates& origin, const uint32_t axis, const uint32_t idx,
+                              const Coordinates& sizes, const Coordinates& door)
+    {
+      if (axis >= D || !Contains(origin) || static_cast<uint64_t>(origin[axis]) + idx + 1 >= this->extents[axis])
+        return;
+
+      // Walk the box of the wall with an odometer over the other axes
+      Coordinates counts, relative;
+      for (uint32_t a = 0; a < D; ++a)
+      {
+        counts[a] = (a == axis) ? 1 : std::min(sizes[a], this->extents[a] - origin[a]);
+        relative[a] = 0;
+        if (counts[a] == 0)
+          return;
+      }
+
+      const Direction kForward = DirectionOf(axis, true);
+      const Index kLayer = IndexOf(origin) + idx * this->strides[axis];
+      while (true)
+      {
+        bool isDoor = D > 1;
+        Index index = kLayer;
+        for (uint32_t a = 0; a < D; ++a)
+          if (a != axis)
+          {
+            index += relative[a] * this->strides[a];
+            isDoor = isDoor && relative[a] == door[a];
+          }
+        if (!isDoor)
+          Disconnect(index, kForward);
+
+        uint32_t a = 0;
+        for (; a < D; ++a)
+        {
+          if (++relative[a] < counts[a])
+            break;
+          relative[a] = 0;
+        }
+        if (a == D)
+          return;
+      }
+    }
+
+    /// ForEachNeighbour - Call functor(neighbourIndex, direction) on each neighbour of the cell in the grid.
+    ///
+    /// @param index the index of the cell.
+    /// @param functor the functor to be called on each neighbour.
+    ///
+    /// @return void.
+    template <typename Functor>
+    void ForEachNeighbour(Index index, Functor functor) const
+    {
+      for (Direction direction = 0; direction < kDirectionCount; ++direction)
+        if (HasNeighbour(index, direction))
+          functor(Neighbour(index, direction), direction);
+    }
+
+    /// ForEachConnected - Call functor(neighbourIndex, direction) on each neighbour connected to the cell.
+    ///
+    /// @param index the index of the cell.
+    /// @param functor the functor to be called on each connected neighbour.
+    ///
+    /// @return void.
+    template <typename Functor>
+    void ForEachConnected(Index index, Functor functor) const
+    {
+      for (Direction direction = 0; direction < kDirectionCount; ++direction)
+        if ((this->links[index] >> direction) & 1)
+          functor(Neighbour(index, direction), direction);
+    }
+
+    // Accessors
+    CellInfo& Info(Index index) { return this->infos[index]; }
+    const CellInfo& Info(Index index) const { return this->infos[index]; }
+    CellInfo& Info(const Coordinates& coordinates) { return this->infos[IndexOf(coordinates)]; }
+    const CellInfo& Info(const Coordinates& coordinates) const { return this->infos[IndexOf(coordinates)]; }
+    const Mask* LinksData() const { return this->links.data(); }
+    Mask* LinksData() { return this->links.data(); }
+
+  private:
+    GridN operator=(GridN&);                     // Not Implemented
+
+    Coordinates extents;                         // Number of cells along each axis
+    Index size;                                  // Number of cells
+    std::array<Index, D> strides;                // Index step along each axis
+    std::array<Index, kDirectionCount> offsets;  // Index step toward each direction (modulo 2^64)
+    std::vector<Mask> links;                     // Connection mask of each index (bit set per Direction)
+    std::vector<CellInfo> infos;                 // Extra information of each index
+
+    /// Direction from first to second, false if they are not orthogonal neighbours within the grid.
+    bool DirectionTo(const Coordinates& first, const Coordinates& second, Direction& direction) const
+    {
+      if (!Contains(first) || !Contains(second))
+        return false;
+
+      uint32_t differences = 0;
+      for (uint32_t axis = 0; axis < D; ++axis)
+        if (first[axis] != second[axis])
+        {
+          if (first[axis] + 1 == second[axis]) direction = DirectionOf(axis, true);
+          else if (second[axis] + 1 == first[axis]) direction = DirectionOf(axis, false);
+          else return false;
+          ++differences;
+        }
+      return differences == 1;
+    }
+  };
+}
+
+#endif // MODULE_DS_GRID_N_HXX
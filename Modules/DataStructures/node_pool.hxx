@@ -0,0 +1,173 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#ifndef MODULE_DS_NODE_POOL_HXX
+#define MODULE_DS_NODE_POOL_HXX
+
+// STD includes
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace huc
+{
+  /// @class NodePool
+  ///
+  /// A Node Pool carves small allocations (nodes of node based containers, shared_ptr control blocks...)
+  /// out of large blocks. Released nodes are kept within one free list per size class and reused by the next
+  /// allocations of the same size class; the blocks themselves are only released with the pool.
+  ///
+  /// @advantages
+  /// - A handful of large allocations instead of one per node, nodes allocated together stay contiguous.
+  /// - Destroying the pool releases everything at once.
+  ///
+  /// @drawbacks
+  /// - Memory of released nodes is not given back to the system before the pool is destroyed.
+  /// - Not thread safe.
+  class NodePool
+  {
+  public:
+    enum : size_t
+    {
+      kAlignment = alignof(std::max_align_t),  // Alignment of every node, and granularity of size classes
+      kMaxNodeSize = 256,                      // Larger allocations go directly to operator new
+      kDefaultBlockSize = 64 * 1024            // Bytes of each block
+    };
+
+    /// NodePool constructor.
+    ///
+    /// @param blockSize number of bytes allocated at once when the pool runs out of nodes.
+    explicit NodePool(size_t blockSize = kDefaultBlockSize) :
+      blockSize(std::max<size_t>(blockSize, kMaxNodeSize)), current(nullptr), remaining(0)
+    { std::fill(this->freeLists, this->freeLists + kClassCount, nullptr); }
+
+    ~NodePool()
+    {
+      for (auto it = this->blocks.begin(); it != this->blocks.end(); ++it)
+        ::operator delete(*it);
+    }
+
+    /// Allocate - Return size bytes aligned on kAlignment.
+    ///
+    /// @param size the number of bytes.
+    ///
+    /// @return pointer to the allocated bytes.
+    void* Allocate(size_t size)
+    {
+      if (size > kMaxNodeSize)
+        return ::operator new(size);
+
+      FreeNode*& head = this->freeLists[SizeClass(size)];
+      if (head)
+      {
+        FreeNode* node = head;
+        head = node->next;
+        return node;
+      }
+
+      const size_t kBytes = (SizeClass(size) + 1) * kAlignment;
+      if (this->remaining < kBytes)
+      {
+        this->blocks.push_back(::operator new(this->blockSize));
+        this->current = static_cast<uint8_t*>(this->blocks.back());
+        this->remaining = this->blockSize;
+      }
+
+      void* node = this->current;
+      this->current += kBytes;
+      this->remaining -= kBytes;
+      return node;
+    }
+
+    /// Deallocate - Give back bytes previously returned by Allocate for the same size.
+    ///
+    /// @param node pointer returned by Allocate.
+    /// @param size the number of bytes given to Allocate.
+    ///
+    /// @return void.
+    void Deallocate(void* node, size_t size)
+    {
+      if (size > kMaxNodeSize)
+        return ::operator delete(node);
+
+      FreeNode* freeNode = static_cast<FreeNode*>(node);
+      freeNode->next = this->freeLists[SizeClass(size)];
+      this->freeLists[SizeClass(size)] = freeNode;
+    }
+
+    size_t BlockCount() const { return this->blocks.size(); }
+    size_t BlockSize() const { return this->blockSize; }
+
+  private:
+    NodePool(const NodePool&);            // Not Implemented
+    NodePool operator=(const NodePool&);  // Not Implemented
+
+    enum : size_t { kClassCount = kMaxNodeSize / kAlignment };
+
+    struct FreeNode { FreeNode* next; };
+
+    static size_t SizeClass(size_t size) { return (std::max<size_t>(size, 1) - 1) / kAlignment; }
+
+    size_t blockSize;                   // Bytes of each block
+    std::vector<void*> blocks;          // Blocks owned by the pool
+    uint8_t* current;                   // Next free byte of the last block
+    size_t remaining;                   // Free bytes left after current
+    FreeNode* freeLists[kClassCount];   // Released nodes per size class
+  };
+
+  /// @class PoolAllocator
+  ///
+  /// Standard allocator drawing from a shared NodePool: copies and rebinds (e.g. to the nodes of a std::set
+  /// or to the control block of std::allocate_shared) share the pool, which lives as long as one of them.
+  /// A default constructed allocator owns a new pool.
+  ///
+  /// @tparam T type of the allocated objects.
+  template <typename T>
+  class PoolAllocator
+  {
+  public:
+    static_assert(alignof(T) <= NodePool::kAlignment, "PoolAllocator does not support over-aligned types");
+
+    typedef T value_type;
+    template <typename U> struct rebind { typedef PoolAllocator<U> other; };
+
+    PoolAllocator() : pool(std::make_shared<NodePool>()) {}
+    explicit PoolAllocator(const std::shared_ptr<NodePool>& pool) : pool(pool) {}
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>& other) : pool(other.Pool()) {}
+
+    T* allocate(size_t n) { return static_cast<T*>(this->pool->Allocate(n * sizeof(T))); }
+    void deallocate(T* p, size_t n) { this->pool->Deallocate(p, n * sizeof(T)); }
+
+    const std::shared_ptr<NodePool>& Pool() const { return this->pool; }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U>& other) const { return this->pool == other.Pool(); }
+    template <typename U>
+    bool operator!=(const PoolAllocator<U>& other) const { return this->pool != other.Pool(); }
+
+  private:
+    std::shared_ptr<NodePool> pool; // Shared pool
+  };
+}
+
+#endif // MODULE_DS_NODE_POOL_HXX
@@ -19,16 +19,11 @@
  *=========================================================================================================*/
 #include <gtest/gtest.h>
 #include <binary_tree_generator.hxx>
+#include "maze_checks.hxx"
 
 using namespace huc;
 using namespace maze;
 
-#ifndef DOXYGEN_SKIP
-namespace {
-
-}
-#endif /* DOXYGEN_SKIP */
-
 // Test Binary Tree Generator
 TEST(TestBinaryTreeGen, build)
 {
@@ -58,3 +53,38 @@ TEST(TestBinaryTreeGen, build)
     EXPECT_EQ(maze->Height(), 10);
   }
 }
+
+// Test Binary Tree Generator over flat grids
+TEST(TestBinaryTreeGen, flatGrid)
+{
+  const uint32_t kSeed = 94;
+  auto maze = BinaryTreeGenerator()(13, 7, kSeed);
+
+  FlatGrid<CellInfoBase, RowMajorLayout> rowMajor(13, 7);
+  FlatGrid<CellInfoBase, TiledLayout<>> tiled(13, 7);
+  FlatGrid<CellInfoBase, MortonLayout> morton(13, 7);
+  BinaryTreeGenerator()(rowMajor, kSeed);
+  BinaryTreeGenerator()(tiled, kSeed);
+  BinaryTreeGenerator()(morton, kSeed);
+  EXPECT_TRUE(IsSameMaze(*maze, rowMajor));
+  EXPECT_TRUE(IsSameMaze(*maze, tiled));
+  EXPECT_TRUE(IsSameMaze(*maze, morton));
+}
+
+// Test Binary Tree Generator over N-dimensional grids
+TEST(TestBinaryTreeGen, gridN)
+{
+  const uint32_t kSeed = 94;
+  auto maze = BinaryTreeGenerator()(13, 7, kSeed);
+  GridN<2> maze2(GridN<2>::Coordinates{{ 13, 7 }});
+  BinaryTreeGenerator()(maze2, kSeed);
+  EXPECT_TRUE(IsSameMaze(*maze, maze2));
+
+  GridN<3> maze3(GridN<3>::Coordinates{{ 6, 5, 4 }});
+  BinaryTreeGenerator()(maze3, kSeed);
+  EXPECT_TRUE(IsPerfectMaze(maze3));
+
+  GridN<5> maze5(GridN<5>::Coordinates{{ 3, 2, 4, 2, 3 }});
+  BinaryTreeGenerator()(maze5, kSeed);
+  EXPECT_TRUE(IsPerfectMaze(maze5));
+}
@@ -19,13 +19,32 @@
  *=========================================================================================================*/
 #include <gtest/gtest.h>
 #include <dfs_generator.hxx>
+#include "maze_checks.hxx"
+
+// STD includes
+#include <vector>
 
 using namespace huc;
 using namespace maze;
 
 #ifndef DOXYGEN_SKIP
 namespace {
-
+  // Square lattice graph, vertex x + y * width. Edges are listed by diagonal (x + y), the horizontal ones first,
+  // so that the arcs of each vertex go west, north, east then south.
+  std::unique_ptr<CSRGraph> LatticeGraph(uint32_t width, uint32_t height)
+  {
+    std::vector<CSRGraph::Edge> edges;
+    for (uint32_t diagonal = 0; diagonal + 1 < width + height; ++diagonal)
+    {
+      for (uint32_t x = 0; x < width && x <= diagonal; ++x)
+        if (diagonal - x < height && x + 1 < width)
+          edges.push_back(CSRGraph::Edge(x + (diagonal - x) * width, x + 1 + (diagonal - x) * width));
+      for (uint32_t x = 0; x < width && x <= diagonal; ++x)
+        if (diagonal - x + 1 < height)
+          edges.push_back(CSRGraph::Edge(x + (diagonal - x) * width, x + (diagonal - x + 1) * width));
+    }
+    return CSRGraph::Build(width * height, edges);
+  }
 }
 #endif /* DOXYGEN_SKIP */
 
@@ -77,3 +96,74 @@ TEST(TestDFSGen, build)
     EXPECT_EQ(maze, nullptr);
   }
 }
+
+// Test DFS Generator over flat grids
+TEST(TestDFSGen, flatGrid)
+{
+  const uint32_t kSeed = 94;
+  auto maze = DFSGenerator()(13, 7, DFSGenerator::Point(4, 2), kSeed);
+
+  FlatGrid<CellInfoBase, RowMajorLayout> rowMajor(13, 7);
+  FlatGrid<CellInfoBase, TiledLayout<>> tiled(13, 7);
+  FlatGrid<CellInfoBase, MortonLayout> morton(13, 7);
+  DFSGenerator()(rowMajor, FlatGrid<>::Point(4, 2), kSeed);
+  DFSGenerator()(tiled, FlatGrid<>::Point(4, 2), kSeed);
+  DFSGenerator()(morton, FlatGrid<>::Point(4, 2), kSeed);
+  EXPECT_TRUE(IsSameMaze(*maze, rowMajor));
+  EXPECT_TRUE(IsSameMaze(*maze, tiled));
+  EXPECT_TRUE(IsSameMaze(*maze, morton));
+
+  // Start out of the grid - Nothing carved
+  FlatGrid<> empty(13, 7);
+  DFSGenerator()(empty, FlatGrid<>::Point(13, 0), kSeed);
+  EXPECT_EQ(0u, empty.Links(0));
+}
+
+// Test DFS Generator over N-dimensional grids
+TEST(TestDFSGen, gridN)
+{
+  const uint32_t kSeed = 94;
+  auto maze = DFSGenerator()(13, 7, DFSGenerator::Point(4, 2), kSeed);
+  GridN<2> maze2(GridN<2>::Coordinates{{ 13, 7 }});
+  DFSGenerator()(maze2, GridN<2>::Coordinates{{ 4, 2 }}, kSeed);
+  EXPECT_TRUE(IsSameMaze(*maze, maze2));
+
+  GridN<3> maze3(GridN<3>::Coordinates{{ 6, 5, 4 }});
+  DFSGenerator()(maze3, GridN<3>::Coordinates{{ 5, 0, 3 }}, kSeed);
+  EXPECT_TRUE(IsPerfectMaze(maze3));
+
+  // Start out of the grid - Nothing carved
+  GridN<3> empty(GridN<3>::Coordinates{{ 6, 5, 4 }});
+  DFSGenerator()(empty, GridN<3>::Coordinates{{ 6, 0, 0 }}, kSeed);
+  EXPECT_EQ(0u, empty.Links(0));
+}
+
+// Test DFS Generator over CSR graphs
+TEST(TestDFSGen, csrGraph)
+{
+  const uint32_t kSeed = 94;
+
+  // Hexagonal grid - Spanning tree
+  {
+    auto graph = HexGraph(23, 17);
+    ASSERT_NE(nullptr, graph);
+    DFSGenerator()(*graph, 5, kSeed);
+    EXPECT_TRUE(IsSpanningTree(*graph));
+  }
+
+  // Square lattice, arcs in the order the grid generator looks at the neighbours - Same maze as the grid one
+  {
+    auto maze = DFSGenerator()(13, 7, DFSGenerator::Point(4, 2), kSeed);
+    auto graph = LatticeGraph(13, 7);
+    ASSERT_NE(nullptr, graph);
+    DFSGenerator()(*graph, 4 + 2 * 13, kSeed);
+    EXPECT_TRUE(IsSameMaze(*maze, *graph));
+  }
+
+  // Start out of the graph - Nothing carved
+  {
+    auto graph = HexGraph(5, 4);
+    DFSGenerator()(*graph, 20, kSeed);
+    EXPECT_EQ(0u, graph->ActiveCount());
+  }
+}
@@ -0,0 +1,126 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#include <gtest/gtest.h>
+#include <distance_field.hxx>
+#include <kruskals_generator.hxx>
+#include "maze_checks.hxx"
+
+// STD includes
+#include <random>
+
+using namespace huc;
+using namespace maze;
+
+#ifndef DOXYGEN_SKIP
+namespace {
+  // Open grid with random walls
+  template <typename Layout>
+  std::unique_ptr<FlatGrid<CellInfoBase, Layout>> WalledGrid(uint32_t width, uint32_t height, int wallCount)
+  {
+    std::unique_ptr<FlatGrid<CellInfoBase, Layout>> grid(new FlatGrid<CellInfoBase, Layout>(width, height, true));
+    std::mt19937 mt(96);
+    for (int wall = 0; wall < wallCount; ++wall)
+    {
+      const FlatGrid<>::Point kOrigin(mt() % width, mt() % height);
+      if (mt() % 2)
+        grid->DisconnectRow(kOrigin, 0, mt() % (width / 2), mt() % width);
+      else
+        grid->DisconnectCol(kOrigin, 0, mt() % (height / 2), mt() % height);
+    }
+    return grid;
+  }
+}
+#endif /* DOXYGEN_SKIP */
+
+// Test distance fields within perfect mazes (thin frontiers, top-down but for the last levels)
+TEST(TestDistanceField, mazes)
+{
+  const auto kMaze = ToFlatGrid<MortonLayout>(*KruskalsGenerator()(60, 45, 96));
+  std::vector<uint32_t> distances;
+  for (uint32_t threadCount = 1; threadCount <= 4; threadCount += 3)
+  {
+    const auto kSource = kMaze->IndexOf(17, 30);
+    const auto kExpected = Distances(*kMaze, kSource);
+    uint32_t bottomUpLevels = 1;
+    const uint32_t kEccentricity = ParallelDistanceField(*kMaze, kSource, distances, threadCount, &bottomUpLevels);
+    EXPECT_EQ(kExpected, distances);
+    EXPECT_LT(bottomUpLevels, kEccentricity / 4);
+
+    ParallelDistanceField(*kMaze, kSource, distances, threadCount, &bottomUpLevels, 0);
+    EXPECT_EQ(kExpected, distances);
+    EXPECT_EQ(0u, bottomUpLevels);
+
+    uint32_t maxDistance = 0;
+    for (auto it = kExpected.begin(); it != kExpected.end(); ++it)
+      if (*it != kUnreachable)
+        maxDistance = std::max(maxDistance, *it);
+    EXPECT_EQ(maxDistance, kEccentricity);
+  }
+
+  // Single cell
+  FlatGrid<> cell(1, 1);
+  EXPECT_EQ(0u, ParallelDistanceField(cell, 0, distances));
+  EXPECT_EQ(std::vector<uint32_t>(1, 0), distances);
+}
+
+// Test distance fields within open grids (wide frontiers) whatever the direction of the steps
+TEST(TestDistanceField, openGrids)
+{
+  std::vector<uint32_t> distances;
+  const auto kGrid = WalledGrid<RowMajorLayout>(300, 200, 100);
+  const auto kTiledGrid = WalledGrid<TiledLayout<>>(90, 70, 30);
+  const auto kExpected = Distances(*kGrid, kGrid->IndexOf(150, 100));
+  const auto kTiledExpected = Distances(*kTiledGrid, kTiledGrid->IndexOf(0, 0));
+  const uint64_t kAlways = uint64_t(1) << 40;
+  for (uint32_t threadCount = 1; threadCount <= 4; threadCount += 3)
+  {
+    // Default heuristic, bottom-up within the widest levels only, bottom-up only
+    uint32_t bottomUpLevels = 0;
+    const auto kEccentricity = ParallelDistanceField(*kGrid, kGrid->IndexOf(150, 100), distances, threadCount);
+    EXPECT_EQ(kExpected, distances);
+
+    ParallelDistanceField(*kGrid, kGrid->IndexOf(150, 100), distances, threadCount, &bottomUpLevels,
+                          kAlways, 1000);
+    EXPECT_EQ(kExpected, distances);
+    EXPECT_GT(bottomUpLevels, 0u);
+    EXPECT_LT(bottomUpLevels, kEccentricity);
+
+    ParallelDistanceField(*kTiledGrid, kTiledGrid->IndexOf(0, 0), distances, threadCount, &bottomUpLevels,
+                          kAlways, kAlways);
+    EXPECT_EQ(kTiledExpected, distances);
+    EXPECT_GT(bottomUpLevels, 0u);
+  }
+
+  // Large open grid, run by a thread team over many consecutive wide levels: the default heuristic goes
+  // bottom-up once the frontier exceeds 1 / kTopDownFactor of the remaining cells, within the last levels
+  // (unreachable cells, never visited, would keep it top-down)
+  const auto kLargeGrid = WalledGrid<RowMajorLayout>(800, 600, 0);
+  const auto kLargeExpected = Distances(*kLargeGrid, kLargeGrid->IndexOf(400, 300));
+  uint32_t bottomUpLevels = 0;
+  const auto kEccentricity = ParallelDistanceField(*kLargeGrid, kLargeGrid->IndexOf(400, 300), distances, 4,
+                                                   &bottomUpLevels);
+  EXPECT_EQ(kLargeExpected, distances);
+  EXPECT_GT(bottomUpLevels, 0u);
+  EXPECT_LT(bottomUpLevels, kEccentricity / 4);
+
+  ParallelDistanceField(*kLargeGrid, kLargeGrid->IndexOf(400, 300), distances, 4, &bottomUpLevels, 0);
+  EXPECT_EQ(kLargeExpected, distances);
+  EXPECT_EQ(0u, bottomUpLevels);
+}
@@ -0,0 +1,93 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#include <gtest/gtest.h>
+#include <graph_path_finder.hxx>
+#include <kruskals_generator.hxx>
+#include "maze_checks.hxx"
+
+// STD includes
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace huc;
+using namespace maze;
+
+// Test Graph Path Finder BFS
+TEST(TestGraphPathFinder, bfs)
+{
+  // Ring of 10 vertices with a chord 0 - 5, all passages open
+  std::vector<CSRGraph::Edge> edges;
+  for (uint32_t vertex = 0; vertex < 10; ++vertex)
+    edges.push_back(CSRGraph::Edge(vertex, (vertex + 1) % 10));
+  edges.push_back(CSRGraph::Edge(0, 5));
+  auto graph = CSRGraph::Build(12, edges);
+  ASSERT_NE(nullptr, graph);
+  graph->SetAllActive(true);
+
+  GraphPathFinder finder(*graph);
+  std::vector<CSRGraph::Vertex> path;
+  EXPECT_TRUE(finder.BFS(1, 6, path));
+  EXPECT_EQ(4u, path.size());
+  EXPECT_EQ(1u, path.front());
+  EXPECT_EQ(6u, path.back());
+  EXPECT_TRUE(IsValidPath(*graph, path, CSRGraph::Vertex(1), CSRGraph::Vertex(6)));
+
+  // Same vertex, isolated vertex and unknown vertex
+  EXPECT_TRUE(finder.BFS(3, 3, path));
+  EXPECT_EQ(1u, path.size());
+  EXPECT_FALSE(finder.BFS(3, 11, path));
+  EXPECT_TRUE(path.empty());
+  EXPECT_FALSE(finder.BFS(3, 12, path));
+
+  // Closed passages are not followed
+  graph->SetActive(10, false);
+  EXPECT_TRUE(finder.BFS(1, 6, path));
+  EXPECT_EQ(6u, path.size());
+  graph->SetActive(0, false);
+  graph->SetActive(5, false);
+  EXPECT_FALSE(finder.BFS(1, 6, path));
+}
+
+// Test Graph Path Finder within a maze carved over a random graph
+TEST(TestGraphPathFinder, maze)
+{
+  std::mt19937 mt(3);
+  std::vector<CSRGraph::Edge> edges;
+  for (uint32_t vertex = 1; vertex < 2000; ++vertex)
+    edges.push_back(CSRGraph::Edge(vertex, mt() % vertex));  // Connected graph
+  for (int i = 0; i < 4000; ++i)
+    edges.push_back(CSRGraph::Edge(mt() % 2000, mt() % 2000));
+  auto graph = CSRGraph::Build(2000, edges);
+  ASSERT_NE(nullptr, graph);
+  KruskalsGenerator()(*graph, 94);
+
+  // Within a perfect maze every vertex is reachable through a single path
+  GraphPathFinder finder(*graph);
+  std::vector<CSRGraph::Vertex> path, backPath;
+  for (CSRGraph::Vertex target = 0; target < 2000; target += 37)
+  {
+    EXPECT_TRUE(finder.BFS(11, target, path));
+    EXPECT_TRUE(IsValidPath(*graph, path, CSRGraph::Vertex(11), target));
+    EXPECT_TRUE(finder.BFS(target, 11, backPath));
+    std::reverse(backPath.begin(), backPath.end());
+    EXPECT_EQ(path, backPath);
+  }
+}
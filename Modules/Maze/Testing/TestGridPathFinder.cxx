@@ -0,0 +1,124 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#include <gtest/gtest.h>
+#include <grid_path_finder.hxx>
+#include <dfs_generator.hxx>
+#include <kruskals_generator.hxx>
+#include <recursive_division_generator.hxx>
+#include "maze_checks.hxx"
+
+// STD includes
+#include <random>
+
+using namespace huc;
+using namespace maze;
+
+#ifndef DOXYGEN_SKIP
+namespace {
+  typedef uint64_t Index;
+
+  // Run every search between random pairs of cells against the reference distances
+  template <typename CellInfo, typename Layout>
+  void CheckSearches(const FlatGrid<CellInfo, Layout>& maze, uint32_t seed, int queryCount = 40)
+  {
+    typedef GridPathFinder<CellInfo, Layout> Finder;
+    typedef bool (Finder::*Search)(Index, Index, std::vector<Index>&);
+    const Search kSearches[] =
+      {&Finder::BFS, &Finder::BidirectionalBFS, &Finder::AStar, &Finder::JumpPointSearch};
+
+    Finder finder(maze);
+    std::mt19937 mt(seed);
+    std::vector<Index> path;
+    for (int query = 0; query < queryCount; ++query)
+    {
+      const Index kSource = maze.IndexOf(mt() % maze.Width(), mt() % maze.Height());
+      const Index kTarget = maze.IndexOf(mt() % maze.Width(), mt() % maze.Height());
+      const uint32_t kDistance = Distances(maze, kSource)[kTarget];
+      for (auto search : kSearches)
+      {
+        const bool kIsFound = (finder.*search)(kSource, kTarget, path);
+        EXPECT_EQ(kDistance != kUnreached, kIsFound);
+        if (kIsFound)
+        {
+          EXPECT_TRUE(IsValidPath(maze, path, kSource, kTarget));
+          EXPECT_EQ(kDistance + 1u, path.size());
+          if (kSource != kTarget)
+          {
+            EXPECT_GT(finder.ExpandedCount(), 0u);
+          }
+        }
+        else
+        {
+          EXPECT_TRUE(path.empty());
+        }
+      }
+    }
+  }
+}
+#endif /* DOXYGEN_SKIP */
+
+// Test the searches within perfect mazes
+TEST(TestGridPathFinder, mazes)
+{
+  CheckSearches(*ToFlatGrid(*DFSGenerator()(31, 17, DFSGenerator::Point(3, 5), 95)), 1);
+  CheckSearches(*ToFlatGrid<MortonLayout>(*KruskalsGenerator()(20, 20, 95)), 2);
+  CheckSearches(*ToFlatGrid<TiledLayout<>>(*RecursiveDivisionGenerator()(40, 9, 95)), 3);
+  CheckSearches(*ToFlatGrid(*DFSGenerator()(1, 1, DFSGenerator::Point(0, 0), 95)), 4, 2);
+}
+
+// Test the searches within open grids with random walls, some cells being unreachable
+TEST(TestGridPathFinder, openGrids)
+{
+  std::mt19937 mt(95);
+  for (int iteration = 0; iteration < 20; ++iteration)
+  {
+    const uint32_t kWidth = 1 + mt() % 40, kHeight = 1 + mt() % 40;
+    FlatGrid<CellInfoBase, MortonLayout> grid(kWidth, kHeight, true);
+    for (int wall = 0; wall < iteration; ++wall)
+    {
+      const FlatGrid<>::Point kOrigin(mt() % kWidth, mt() % kHeight);
+      if (mt() % 2)
+        grid.DisconnectRow(kOrigin, 0, mt() % 20, (mt() % 3) ? kWidth : 0);
+      else
+        grid.DisconnectCol(kOrigin, 0, mt() % 20, (mt() % 3) ? kHeight : 0);
+    }
+    CheckSearches(grid, iteration);
+  }
+}
+
+// Test guided searches expand fewer cells than breadth first searches on open grids
+TEST(TestGridPathFinder, expandedCount)
+{
+  FlatGrid<> grid(100, 100, true);
+  grid.DisconnectCol(FlatGrid<>::Point(0, 10), 49, 80, 100);
+  GridPathFinder<CellInfoBase, RowMajorLayout> finder(grid);
+  std::vector<uint64_t> path;
+
+  ASSERT_TRUE(finder.BFS(grid.IndexOf(10, 50), grid.IndexOf(90, 50), path));
+  const uint64_t kBFSExpanded = finder.ExpandedCount();
+  ASSERT_TRUE(finder.BidirectionalBFS(grid.IndexOf(10, 50), grid.IndexOf(90, 50), path));
+  EXPECT_LT(finder.ExpandedCount(), kBFSExpanded);
+  ASSERT_TRUE(finder.AStar(grid.IndexOf(10, 50), grid.IndexOf(90, 50), path));
+  const uint64_t kAStarExpanded = finder.ExpandedCount();
+  EXPECT_LT(kAStarExpanded, kBFSExpanded);
+  ASSERT_TRUE(finder.JumpPointSearch(grid.IndexOf(10, 50), grid.IndexOf(90, 50), path));
+  EXPECT_LT(finder.ExpandedCount(), kAStarExpanded);
+  EXPECT_EQ(80u + 2 * 40 + 1, path.size()); // Around the bottom end of the wall
+}
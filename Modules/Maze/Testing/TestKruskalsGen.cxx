@@ -19,16 +19,14 @@
  *=========================================================================================================*/
 #include <gtest/gtest.h>
 #include <kruskals_generator.hxx>
+#include "maze_checks.hxx"
+
+// STD includes
+#include <vector>
 
 using namespace huc;
 using namespace maze;
 
-#ifndef DOXYGEN_SKIP
-namespace {
-
-}
-#endif /* DOXYGEN_SKIP */
-
 // Test Binary Tree Generator
 TEST(TestKruskalsGen, build)
 {
@@ -58,3 +56,81 @@ TEST(TestKruskalsGen, build)
     EXPECT_EQ(maze->Height(), 10);
   }
 }
+
+// Test Kruskal's Generator over flat grids
+TEST(TestKruskalsGen, flatGrid)
+{
+  for (uint32_t seed = 0; seed < 5; ++seed)
+  {
+    FlatGrid<CellInfoBase, RowMajorLayout> rowMajor(17, 9);
+    FlatGrid<CellInfoBase, TiledLayout<>> tiled(17, 9);
+    FlatGrid<CellInfoBase, MortonLayout> morton(17, 9);
+    KruskalsGenerator()(rowMajor, seed);
+    KruskalsGenerator()(tiled, seed);
+    KruskalsGenerator()(morton, seed);
+    EXPECT_TRUE(IsPerfectMaze(rowMajor));
+    EXPECT_TRUE(IsSameMaze(rowMajor, tiled));
+    EXPECT_TRUE(IsSameMaze(rowMajor, morton));
+  }
+
+  // Single cell - Nothing to carve
+  FlatGrid<> cell(1, 1);
+  KruskalsGenerator()(cell, 0);
+  EXPECT_TRUE(IsPerfectMaze(cell));
+}
+
+// Test Kruskal's Generator over N-dimensional grids
+TEST(TestKruskalsGen, gridN)
+{
+  const uint32_t kSeed = 94;
+  FlatGrid<> maze(13, 7);
+  KruskalsGenerator()(maze, kSeed);
+  GridN<2> maze2(GridN<2>::Coordinates{{ 13, 7 }});
+  KruskalsGenerator()(maze2, kSeed);
+  EXPECT_TRUE(IsSameMaze(maze, maze2));
+
+  GridN<3> maze3(GridN<3>::Coordinates{{ 6, 5, 4 }});
+  KruskalsGenerator()(maze3, kSeed);
+  EXPECT_TRUE(IsPerfectMaze(maze3));
+
+  GridN<5> maze5(GridN<5>::Coordinates{{ 3, 2, 4, 2, 3 }});
+  KruskalsGenerator()(maze5, kSeed);
+  EXPECT_TRUE(IsPerfectMaze(maze5));
+}
+
+// Test Kruskal's Generator over CSR graphs
+TEST(TestKruskalsGen, csrGraph)
+{
+  const uint32_t kSeed = 94;
+
+  // Hexagonal grid - Spanning tree
+  {
+    auto graph = HexGraph(23, 17);
+    ASSERT_NE(nullptr, graph);
+    KruskalsGenerator()(*graph, kSeed);
+    EXPECT_TRUE(IsSpanningTree(*graph));
+  }
+
+  // Two hexagonal grids, every edge doubled and a loop on each vertex - A spanning tree of each grid
+  {
+    std::vector<CSRGraph::Edge> edges;
+    AddHexEdges(edges, 9, 7);
+    AddHexEdges(edges, 9, 7, 63);
+    AddHexEdges(edges, 9, 7);
+    AddHexEdges(edges, 9, 7, 63);
+    const auto kFirstLoop = static_cast<CSRGraph::EdgeId>(edges.size());
+    for (CSRGraph::Vertex vertex = 0; vertex < 126; ++vertex)
+      edges.push_back(CSRGraph::Edge(vertex, vertex));
+    auto graph = CSRGraph::Build(126, edges);
+    ASSERT_NE(nullptr, graph);
+    KruskalsGenerator()(*graph, kSeed);
+    EXPECT_EQ(124u, graph->ActiveCount());
+    EXPECT_EQ(63u, ReachedCount(*graph, 126, CSRGraph::Vertex(0)));
+    EXPECT_EQ(63u, ReachedCount(*graph, 126, CSRGraph::Vertex(63)));
+
+    bool isLoopActive = false;
+    for (CSRGraph::EdgeId edge = kFirstLoop; edge < graph->EdgeCount(); ++edge)
+      isLoopActive = isLoopActive || graph->IsActive(edge);
+    EXPECT_FALSE(isLoopActive);
+  }
+}
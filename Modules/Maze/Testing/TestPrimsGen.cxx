@@ -19,16 +19,14 @@
  *=========================================================================================================*/
 #include <gtest/gtest.h>
 #include <prims_generator.hxx>
+#include "maze_checks.hxx"
+
+// STD includes
+#include <vector>
 
 using namespace huc;
 using namespace maze;
 
-#ifndef DOXYGEN_SKIP
-namespace {
-
-}
-#endif /* DOXYGEN_SKIP */
-
 // Test Binary Tree Generator
 TEST(TestPrimsGen, build)
 {
@@ -77,3 +75,75 @@ TEST(TestPrimsGen, build)
     EXPECT_EQ(maze, nullptr);
   }
 }
+
+// Test Prim's Generator over flat grids
+TEST(TestPrimsGen, flatGrid)
+{
+  for (uint32_t seed = 0; seed < 5; ++seed)
+  {
+    FlatGrid<CellInfoBase, RowMajorLayout> rowMajor(17, 9);
+    FlatGrid<CellInfoBase, TiledLayout<>> tiled(17, 9);
+    FlatGrid<CellInfoBase, MortonLayout> morton(17, 9);
+    PrimsGenerator()(rowMajor, FlatGrid<>::Point(8, 4), seed);
+    PrimsGenerator()(tiled, FlatGrid<>::Point(8, 4), seed);
+    PrimsGenerator()(morton, FlatGrid<>::Point(8, 4), seed);
+    EXPECT_TRUE(IsPerfectMaze(rowMajor));
+    EXPECT_TRUE(IsSameMaze(rowMajor, tiled));
+    EXPECT_TRUE(IsSameMaze(rowMajor, morton));
+  }
+
+  // Start out of the grid - Nothing carved
+  FlatGrid<> empty(17, 9);
+  PrimsGenerator()(empty, FlatGrid<>::Point(0, 9), 0);
+  EXPECT_EQ(0u, empty.Links(0));
+}
+
+// Test Prim's Generator over N-dimensional grids
+TEST(TestPrimsGen, gridN)
+{
+  const uint32_t kSeed = 94;
+  GridN<2> maze2(GridN<2>::Coordinates{{ 13, 7 }});
+  PrimsGenerator()(maze2, GridN<2>::Coordinates{{ 4, 2 }}, kSeed);
+  EXPECT_TRUE(IsPerfectMaze(maze2));
+
+  GridN<3> maze3(GridN<3>::Coordinates{{ 6, 5, 4 }});
+  PrimsGenerator()(maze3, GridN<3>::Coordinates{{ 5, 0, 3 }}, kSeed);
+  EXPECT_TRUE(IsPerfectMaze(maze3));
+
+  GridN<5> maze5(GridN<5>::Coordinates{{ 3, 2, 4, 2, 3 }});
+  PrimsGenerator()(maze5, GridN<5>::Coordinates{{ 1, 1, 2, 0, 2 }}, kSeed);
+  EXPECT_TRUE(IsPerfectMaze(maze5));
+
+  // Start out of the grid - Nothing carved
+  GridN<3> empty(GridN<3>::Coordinates{{ 6, 5, 4 }});
+  PrimsGenerator()(empty, GridN<3>::Coordinates{{ 0, 5, 0 }}, kSeed);
+  EXPECT_EQ(0u, empty.Links(0));
+}
+
+// Test Prim's Generator over CSR graphs
+TEST(TestPrimsGen, csrGraph)
+{
+  const uint32_t kSeed = 94;
+
+  // Hexagonal grid - Spanning tree
+  {
+    auto graph = HexGraph(23, 17);
+    ASSERT_NE(nullptr, graph);
+    PrimsGenerator()(*graph, 5, kSeed);
+    EXPECT_TRUE(IsSpanningTree(*graph));
+  }
+
+  // Two hexagonal grids and a loop on the start - Only the grid of the start is spanned, never the loop
+  {
+    std::vector<CSRGraph::Edge> edges;
+    AddHexEdges(edges, 9, 7);
+    AddHexEdges(edges, 9, 7, 63);
+    edges.push_back(CSRGraph::Edge(70, 70));
+    auto graph = CSRGraph::Build(126, edges);
+    ASSERT_NE(nullptr, graph);
+    PrimsGenerator()(*graph, 70, kSeed);
+    EXPECT_EQ(62u, graph->ActiveCount());
+    EXPECT_EQ(63u, ReachedCount(*graph, 126, CSRGraph::Vertex(70)));
+    EXPECT_FALSE(graph->IsActive(static_cast<CSRGraph::EdgeId>(edges.size() - 1)));
+  }
+}
@@ -19,16 +19,11 @@
  *=========================================================================================================*/
 #include <gtest/gtest.h>
 #include <sidewinder_generator.hxx>
+#include "maze_checks.hxx"
 
 using namespace huc;
 using namespace maze;
 
-#ifndef DOXYGEN_SKIP
-namespace {
-
-}
-#endif /* DOXYGEN_SKIP */
-
 // Test Binary Tree Generator
 TEST(TestSidewinderGen, build)
 {
@@ -58,3 +53,23 @@ TEST(TestSidewinderGen, build)
     EXPECT_EQ(maze->Height(), 10);
   }
 }
+
+// Test Sidewinder Generator over flat grids
+TEST(TestSidewinderGen, flatGrid)
+{
+  for (uint32_t seed = 0; seed < 5; ++seed)
+  {
+    FlatGrid<CellInfoBase, RowMajorLayout> rowMajor(17, 9);
+    FlatGrid<CellInfoBase, ColumnMajorLayout> columnMajor(17, 9);
+    FlatGrid<CellInfoBase, MortonLayout> morton(17, 9);
+    SidewinderGenerator()(rowMajor, seed);
+    SidewinderGenerator()(columnMajor, seed);
+    SidewinderGenerator()(morton, seed);
+
+    EXPECT_TRUE(IsPerfectMaze(rowMajor));
+    EXPECT_TRUE(IsPerfectMaze(columnMajor));
+    EXPECT_TRUE(IsPerfectMaze(morton));
+    EXPECT_TRUE(IsSameMaze(rowMajor, columnMajor));
+    EXPECT_TRUE(IsSameMaze(rowMajor, morton));
+  }
+}
@@ -0,0 +1,285 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#ifndef MODULE_MAZE_MAZE_CHECKS_HXX
+#define MODULE_MAZE_MAZE_CHECKS_HXX
+
+#include <DataStructures/csr_graph.hxx>
+#include <DataStructures/flat_grid.hxx>
+#include <DataStructures/grid.hxx>
+#include <DataStructures/grid_n.hxx>
+#include <DataStructures/Testing/graph_fixtures.hxx>
+
+// STD includes
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <vector>
+
+// Checks shared by the maze generator tests.
+#ifndef DOXYGEN_SKIP
+namespace {
+  // Number of bits set within the links mask
+  inline uint32_t LinkCount(uint64_t links)
+  {
+    uint32_t count = 0;
+    for (; links; links &= links - 1)
+      ++count;
+    return count;
+  }
+
+  // Visitor of the neighbours connected to a cell, stacking the ones not reached yet
+  template <typename Index>
+  struct Reach
+  {
+    template <typename Link>
+    void operator()(Index neighbour, Link) const
+    {
+      if (isReached[static_cast<size_t>(neighbour)])
+        return;
+      isReached[static_cast<size_t>(neighbour)] = 1;
+      ++reachedCount;
+      stack.push_back(neighbour);
+    }
+
+    std::vector<uint8_t>& isReached;
+    std::vector<Index>& stack;
+    uint64_t& reachedCount;
+  };
+
+  // Number of cells reached from root through the passages, indexes ranging in [0, indexCount)
+  template <typename Maze, typename Index>
+  uint64_t ReachedCount(const Maze& maze, uint64_t indexCount, Index root)
+  {
+    std::vector<uint8_t> isReached(static_cast<size_t>(indexCount), 0);
+    std::vector<Index> stack(1, root);
+    uint64_t reachedCount = 1;
+    isReached[static_cast<size_t>(root)] = 1;
+    const Reach<Index> kReach = { isReached, stack, reachedCount };
+    while (!stack.empty())
+    {
+      const Index kIndex = stack.back();
+      stack.pop_back();
+      maze.ForEachConnected(kIndex, kReach);
+    }
+    return reachedCount;
+  }
+
+  // Distance of the cells unreached by Distances, same as maze::kUnreachable
+  const uint32_t kUnreached = std::numeric_limits<uint32_t>::max();
+
+  // Visitor of the neighbours connected to a cell, queueing the ones not reached yet one step further
+  template <typename Index>
+  struct Step
+  {
+    template <typename Link>
+    void operator()(Index neighbour, Link) const
+    {
+      if (distances[static_cast<size_t>(neighbour)] != kUnreached)
+        return;
+      distances[static_cast<size_t>(neighbour)] = distance + 1;
+      queue.push_back(neighbour);
+    }
+
+    std::vector<uint32_t>& distances;
+    std::vector<Index>& queue;
+    uint32_t distance;
+  };
+
+  // Sequential breadth first search distances from source, kUnreached for unreachable cells
+  template <typename Maze, typename Index>
+  std::vector<uint32_t> Distances(const Maze& maze, Index source)
+  {
+    std::vector<uint32_t> distances(static_cast<size_t>(maze.Capacity()), kUnreached);
+    std::vector<Index> queue(1, source);
+    distances[static_cast<size_t>(source)] = 0;
+    for (size_t head = 0; head < queue.size(); ++head)
+    {
+      const Step<Index> kStep = { distances, queue, distances[static_cast<size_t>(queue[head])] };
+      maze.ForEachConnected(queue[head], kStep);
+    }
+    return distances;
+  }
+
+  // Visitor of the neighbours connected to a cell, looking for the next cell of a path
+  template <typename Index>
+  struct IsNext
+  {
+    template <typename Link>
+    void operator()(Index neighbour, Link) const
+    { isConnected = isConnected || neighbour == next; }
+
+    Index next;
+    bool& isConnected;
+  };
+
+  // Whether path goes from source to target through connected cells
+  template <typename Maze, typename Index>
+  bool IsValidPath(const Maze& maze, const std::vector<Index>& path, Index source, Index target)
+  {
+    if (path.empty() || path.front() != source || path.back() != target)
+      return false;
+    for (size_t i = 1; i < path.size(); ++i)
+    {
+      bool isConnected = false;
+      const IsNext<Index> kIsNext = { path[i], isConnected };
+      maze.ForEachConnected(path[i - 1], kIsNext);
+      if (!isConnected)
+        return false;
+    }
+    return true;
+  }
+
+  // Whether the flat maze is perfect: Size - 1 passages and every cell reachable from the first one
+  template <typename CellInfo, typename Layout>
+  bool IsPerfectMaze(const huc::FlatGrid<CellInfo, Layout>& maze)
+  {
+    uint64_t passageCount = 0;
+    for (uint32_t y = 0; y < maze.Height(); ++y)
+      for (uint32_t x = 0; x < maze.Width(); ++x)
+        passageCount += LinkCount(maze.Links(maze.IndexOf(x, y)));
+    return passageCount == 2 * (maze.Size() - 1) &&
+           ReachedCount(maze, maze.Capacity(), maze.IndexOf(0, 0)) == maze.Size();
+  }
+
+  // Whether the GridN is a perfect maze: Size - 1 passages and every cell reachable from the first one
+  template <uint32_t D, typename CellInfo>
+  bool IsPerfectMaze(const huc::GridN<D, CellInfo>& maze)
+  {
+    uint64_t passageCount = 0;
+    for (typename huc::GridN<D, CellInfo>::Index index = 0; index < maze.Size(); ++index)
+      passageCount += LinkCount(maze.Links(index));
+    return passageCount == 2 * (maze.Size() - 1) &&
+           ReachedCount(maze, maze.Size(), typename huc::GridN<D, CellInfo>::Index(0)) == maze.Size();
+  }
+
+  // Whether the flat maze has the connections of the maze
+  template <typename Maze, typename CellInfo, typename Layout>
+  bool IsSameMaze(const Maze& maze, const huc::FlatGrid<CellInfo, Layout>& flatMaze)
+  {
+    for (uint32_t x = 0; x < maze.Width(); ++x)
+      for (uint32_t y = 0; y < maze.Height(); ++y)
+      {
+        if (LinkCount(flatMaze.Links(flatMaze.IndexOf(x, y))) != maze[x][y]->connectedCells.size())
+          return false;
+
+        const auto& kConnected = maze[x][y]->connectedCells;
+        for (auto it = kConnected.begin(); it != kConnected.end(); ++it)
+          if (!flatMaze.IsConnected(huc::Grid<>::Point(x, y), huc::Grid<>::Point(it->lock()->x, it->lock()->y)))
+            return false;
+      }
+    return true;
+  }
+
+  // Whether the 2D GridN has the connections of the maze
+  template <typename Maze, typename CellInfo>
+  bool IsSameMaze(const Maze& maze, const huc::GridN<2, CellInfo>& mazeN)
+  {
+    typedef typename huc::GridN<2, CellInfo>::Coordinates Coordinates;
+    for (uint32_t x = 0; x < maze.Width(); ++x)
+      for (uint32_t y = 0; y < maze.Height(); ++y)
+      {
+        const Coordinates kPoint = {{ x, y }};
+        if (LinkCount(mazeN.Links(mazeN.IndexOf(kPoint))) != maze[x][y]->connectedCells.size())
+          return false;
+
+        const auto& kConnected = maze[x][y]->connectedCells;
+        for (auto it = kConnected.begin(); it != kConnected.end(); ++it)
+          if (!mazeN.IsConnected(kPoint, Coordinates{{ it->lock()->x, it->lock()->y }}))
+            return false;
+      }
+    return true;
+  }
+
+  // Whether the 2D GridN has the connections of the flat maze, whatever its layout
+  template <typename CellInfo, typename Layout, typename OtherCellInfo>
+  bool IsSameMaze(const huc::FlatGrid<CellInfo, Layout>& maze, const huc::GridN<2, OtherCellInfo>& mazeN)
+  {
+    typedef huc::GridN<2, OtherCellInfo> MazeN;
+    if (maze.Width() != mazeN.Extent(0) || maze.Height() != mazeN.Extent(1))
+      return false;
+    for (uint32_t y = 0; y < maze.Height(); ++y)
+      for (uint32_t x = 0; x < maze.Width(); ++x)
+      {
+        const typename MazeN::Coordinates kPoint = {{ x, y }};
+        const auto kIndex = maze.IndexOf(x, y);
+        const auto kIndexN = mazeN.IndexOf(kPoint);
+        if (maze.IsConnected(kIndex, huc::kWest) != mazeN.IsConnected(kIndexN, MazeN::DirectionOf(0, false)) ||
+            maze.IsConnected(kIndex, huc::kEast) != mazeN.IsConnected(kIndexN, MazeN::DirectionOf(0, true)) ||
+            maze.IsConnected(kIndex, huc::kNorth) != mazeN.IsConnected(kIndexN, MazeN::DirectionOf(1, false)) ||
+            maze.IsConnected(kIndex, huc::kSouth) != mazeN.IsConnected(kIndexN, MazeN::DirectionOf(1, true)))
+          return false;
+      }
+    return true;
+  }
+
+  // Whether the graph has the connections of the maze, vertex x + y * width
+  template <typename Maze>
+  bool IsSameMaze(const Maze& maze, const huc::CSRGraph& graph)
+  {
+    for (uint32_t x = 0; x < maze.Width(); ++x)
+      for (uint32_t y = 0; y < maze.Height(); ++y)
+      {
+        std::vector<huc::CSRGraph::Vertex> neighbours;
+        graph.ForEachConnected(x + y * maze.Width(), [&](huc::CSRGraph::Vertex neighbour, huc::CSRGraph::EdgeId)
+        { neighbours.push_back(neighbour); });
+        if (neighbours.size() != maze[x][y]->connectedCells.size())
+          return false;
+
+        const auto& kConnected = maze[x][y]->connectedCells;
+        for (auto it = kConnected.begin(); it != kConnected.end(); ++it)
+          if (std::find(neighbours.begin(), neighbours.end(), it->lock()->x + it->lock()->y * maze.Width()) ==
+              neighbours.end())
+            return false;
+      }
+    return true;
+  }
+
+  // Hexagonal grid graph (odd rows shifted right), vertex x + y * width
+  inline std::unique_ptr<huc::CSRGraph> HexGraph(uint32_t width, uint32_t height)
+  {
+    std::vector<huc::CSRGraph::Edge> edges;
+    AddHexEdges(edges, width, height);
+    return huc::CSRGraph::Build(width * height, edges);
+  }
+
+  // Whether the active edges form a spanning tree: VertexCount - 1 edges reaching every vertex
+  inline bool IsSpanningTree(const huc::CSRGraph& graph)
+  {
+    return graph.ActiveCount() + 1 == graph.VertexCount() &&
+           ReachedCount(graph, graph.VertexCount(), huc::CSRGraph::Vertex(0)) == graph.VertexCount();
+  }
+
+  // Whether both flat mazes have the same connections, whatever their layouts
+  template <typename CellInfo, typename Layout, typename OtherCellInfo, typename OtherLayout>
+  bool IsSameMaze(const huc::FlatGrid<CellInfo, Layout>& maze,
+                  const huc::FlatGrid<OtherCellInfo, OtherLayout>& other)
+  {
+    if (maze.Width() != other.Width() || maze.Height() != other.Height())
+      return false;
+    for (uint32_t y = 0; y < maze.Height(); ++y)
+      for (uint32_t x = 0; x < maze.Width(); ++x)
+        if (maze.Links(maze.IndexOf(x, y)) != other.Links(other.IndexOf(x, y)))
+          return false;
+    return true;
+  }
+}
+#endif /* DOXYGEN_SKIP */
+
+#endif // MODULE_MAZE_MAZE_CHECKS_HXX
@@ -20,7 +20,9 @@
 #ifndef MODULE_MAZE_BTG_HXX
 #define MODULE_MAZE_BTG_HXX
 
+#include <DataStructures/flat_grid.hxx>
 #include <DataStructures/grid.hxx>
+#include <DataStructures/grid_n.hxx>
 
 // STD
 #include <random>
@@ -79,6 +81,58 @@ namespace huc
         return maze;
       }
 
+      /// Carve the maze within a disconnected FlatGrid, whatever its layout.
+      /// The maze is the one built by operator()(width, height, seed).
+      ///
+      /// @param maze the grid to be carved.
+      /// @param seed number used to initiate the random generator.
+      ///
+      /// @return void.
+      template <typename CellInfo, typename Layout>
+      void operator()(FlatGrid<CellInfo, Layout>& maze, const uint32_t seed = 0)
+      {
+        std::mt19937 mt(seed); // Initialize random generator based on Mersenne Twister algorithm
+
+        // For each existing cell, randomly carve a passage either west or north (same order as GetNeighbours)
+        for (uint32_t y = 0; y < maze.Height(); ++y)
+          for (uint32_t x = 0; x < maze.Width(); ++x)
+          {
+            const uint32_t kCount = ((x > 0) ? 1 : 0) + ((y > 0) ? 1 : 0);
+            if (kCount == 0)
+              continue;
+
+            const bool kIsWest = (mt() % kCount == 0) && x > 0;
+            maze.Connect(maze.IndexOf(x, y), kIsWest ? kWest : kNorth);
+          }
+      }
+
+      /// Carve the maze within a disconnected GridN: each cell is connected to one of its backward
+      /// neighbours. For D = 2 the maze is the one built by operator()(width, height, seed).
+      ///
+      /// @param maze the grid to be carved.
+      /// @param seed number used to initiate the random generator.
+      ///
+      /// @return void.
+      template <uint32_t D, typename CellInfo>
+      void operator()(GridN<D, CellInfo>& maze, const uint32_t seed = 0)
+      {
+        typedef GridN<D, CellInfo> MazeN;
+        std::mt19937 mt(seed); // Initialize random generator based on Mersenne Twister algorithm
+
+        // For each existing cell, randomly carve a passage backward along one of the axes
+        typename MazeN::Direction directions[D];
+        for (typename MazeN::Index index = 0; index < maze.Size(); ++index)
+        {
+          uint32_t count = 0;
+          for (uint32_t axis = 0; axis < D; ++axis)
+            if (maze.HasNeighbour(index, MazeN::DirectionOf(axis, false)))
+              directions[count++] = MazeN::DirectionOf(axis, false);
+
+          if (count > 0)
+            maze.Connect(index, directions[mt() % count]);
+        }
+      }
+
     private:
       /// GetNeighbours - Retrieve available neighbours
       ///
@@ -20,11 +20,16 @@
 #ifndef MODULE_MAZE_DFSG_HXX
 #define MODULE_MAZE_DFSG_HXX
 
+#include <DataStructures/csr_graph.hxx>
+#include <DataStructures/flat_grid.hxx>
 #include <DataStructures/grid.hxx>
+#include <DataStructures/grid_n.hxx>
 
 // STD
 #include <random>
 #include <stack>
+#include <utility>
+#include <vector>
 
 namespace huc
 {
@@ -102,7 +107,157 @@ namespace huc
         return maze;
       }
 
+      /// Carve the maze within a disconnected FlatGrid, whatever its layout, starting from the cell at start.
+      /// Neighbours are considered west, north, east then south, so that the maze is the one built by
+      /// operator()(width, height, startPoint, seed).
+      ///
+      /// @param maze the grid to be carved.
+      /// @param start the point to start the algorithm, nothing is carved if out of the grid.
+      /// @param seed number used to initiate the random generator.
+      ///
+      /// @return void.
+      template <typename CellInfo, typename Layout>
+      void operator()(FlatGrid<CellInfo, Layout>& maze, const typename FlatGrid<CellInfo, Layout>::Point& start,
+                      const uint32_t seed = 0)
+      {
+        typedef FlatGrid<CellInfo, Layout> FlatMaze;
+        typedef typename FlatMaze::Index Index;
+        if (start.x >= maze.Width() || start.y >= maze.Height())
+          return;
+
+        Carve<Index, GridDirection>(FlatAxisOrder<FlatMaze>(maze), maze.Capacity(), maze.IndexOf(start), seed,
+                                    [&](Index cell, GridDirection direction) { maze.Connect(cell, direction); });
+      }
+
+      /// Carve the maze within a disconnected GridN, starting from the cell at start.
+      /// Neighbours are considered backward then forward along each axis, so that for D = 2 the maze is the
+      /// one built by operator()(width, height, startPoint, seed).
+      ///
+      /// @param maze the grid to be carved.
+      /// @param start the coordinates of the cell to start the algorithm, nothing is carved if out of the grid.
+      /// @param seed number used to initiate the random generator.
+      ///
+      /// @return void.
+      template <uint32_t D, typename CellInfo>
+      void operator()(GridN<D, CellInfo>& maze, const typename GridN<D, CellInfo>::Coordinates& start,
+                      const uint32_t seed = 0)
+      {
+        typedef GridN<D, CellInfo> MazeN;
+        typedef typename MazeN::Index Index;
+        typedef typename MazeN::Direction Direction;
+        if (!maze.Contains(start))
+          return;
+
+        Carve<Index, Direction>(AxisOrderN<MazeN>(maze), maze.Size(), maze.IndexOf(start), seed,
+                                [&](Index cell, Direction direction) { maze.Connect(cell, direction); });
+      }
+
+      /// Carve the maze within a CSRGraph whose edges are all inactive, starting from the start vertex.
+      ///
+      /// @param graph the graph to be carved.
+      /// @param start the vertex to start the algorithm, nothing is carved if out of the graph.
+      /// @param seed number used to initiate the random generator.
+      ///
+      /// @return void.
+      void operator()(CSRGraph& graph, const CSRGraph::Vertex start, const uint32_t seed = 0)
+      {
+        if (start >= graph.VertexCount())
+          return;
+
+        Carve<CSRGraph::Vertex, CSRGraph::EdgeId>(graph, graph.VertexCount(), start, seed,
+                                                  [&](CSRGraph::Vertex, CSRGraph::EdgeId edge)
+                                                  { graph.SetActive(edge, true); });
+      }
+
     private:
+      /// FlatAxisOrder - FlatGrid neighbours west, north, east then south, the order of GetNeighbours.
+      template <typename FlatMaze>
+      struct FlatAxisOrder
+      {
+        explicit FlatAxisOrder(const FlatMaze& maze) : maze(maze) {}
+
+        template <typename Functor>
+        void ForEachNeighbour(typename FlatMaze::Index index, Functor functor) const
+        {
+          static const GridDirection kDirections[] = { kWest, kNorth, kEast, kSouth };
+          for (uint32_t i = 0; i < 4; ++i)
+            if (this->maze.HasNeighbour(index, kDirections[i]))
+              functor(this->maze.Neighbour(index, kDirections[i]), kDirections[i]);
+        }
+
+        const FlatMaze& maze;
+      };
+
+      /// AxisOrderN - GridN neighbours backward then forward along each axis, the order of GetNeighbours.
+      template <typename MazeN>
+      struct AxisOrderN
+      {
+        explicit AxisOrderN(const MazeN& maze) : maze(maze) {}
+
+        template <typename Functor>
+        void ForEachNeighbour(typename MazeN::Index index, Functor functor) const
+        {
+          for (uint32_t i = 0; i < MazeN::kDirectionCount; ++i)
+          {
+            const auto kDirection = MazeN::DirectionOf(i % MazeN::kDimension, i >= MazeN::kDimension);
+            if (this->maze.HasNeighbour(index, kDirection))
+              functor(this->maze.Neighbour(index, kDirection), kDirection);
+          }
+        }
+
+        const MazeN& maze;
+      };
+
+      /// Carve - Carve the maze from the start vertex over any graph exposing ForEachNeighbour: the neighbours
+      /// not visited yet are all pushed on the stack, a randomly selected one on top, and connected to the vertex.
+      ///
+      /// @param graph the graph whose ForEachNeighbour(vertex, functor(neighbour, link)) lists the neighbours
+      /// in the order they are considered.
+      /// @param vertexCount upper bound of the vertices of the graph.
+      /// @param start the vertex to start the algorithm.
+      /// @param seed number used to initiate the random generator.
+      /// @param connect functor(vertex, link) carving the passage from the vertex through the link.
+      ///
+      /// @return void.
+      template <typename Vertex, typename Link, typename Graph, typename Connect>
+      static void Carve(const Graph& graph, const uint64_t vertexCount, const Vertex start, const uint32_t seed,
+                        Connect connect)
+      {
+        std::mt19937 mt(seed);                           // Random generator - Mersenne Twister algorithm
+        std::stack<Vertex> pathStack;                    // Keep track of the vertex path
+        std::vector<uint8_t> isVisited(static_cast<size_t>(vertexCount), 0);
+        std::vector<std::pair<Vertex, Link>> neighbours; // Available neighbours and the links toward them
+
+        isVisited[start] = 1;
+        pathStack.push(start);
+        while (!pathStack.empty())
+        {
+          const Vertex kVertex = pathStack.top();
+          pathStack.pop();
+
+          // Get available neighbours, each one once even through parallel links
+          neighbours.clear();
+          graph.ForEachNeighbour(kVertex, [&](Vertex neighbour, Link link)
+          {
+            if (isVisited[neighbour])
+              return;
+            isVisited[neighbour] = 1;
+            neighbours.push_back(std::make_pair(neighbour, link));
+          });
+          if (neighbours.empty())
+            continue;
+
+          // Push them all, the randomly selected one on top, and connect them to the vertex
+          const auto kRandIdx = mt() % neighbours.size();
+          for (size_t i = 0; i < neighbours.size(); ++i)
+          {
+            connect(kVertex, neighbours[i].second);
+            if (i != kRandIdx) pathStack.push(neighbours[i].first);
+          }
+          pathStack.push(neighbours[kRandIdx].first);
+        }
+      }
+
       /// GetNeighbours - Retrieve available neighbours
       ///
       /// @param maze Grid within the search occurs
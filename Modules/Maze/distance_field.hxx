@@ -0,0 +1,309 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#ifndef MODULE_MAZE_DISTANCE_FIELD_HXX
+#define MODULE_MAZE_DISTANCE_FIELD_HXX
+
+#include <Combinatory/intrinsics.hxx>
+#include <Combinatory/parallel.hxx>
+#include <DataStructures/flat_grid.hxx>
+
+// STD includes
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
+namespace huc
+{
+  namespace maze
+  {
+    enum : uint32_t { kUnreachable = std::numeric_limits<uint32_t>::max() };
+
+    /// Frontiers below this size are expanded by the calling thread alone.
+    enum : size_t { kParallelFrontierSize = 1 << 10 };
+    /// Default factors of the direction optimizing heuristic (cf. ParallelDistanceField).
+    enum : uint64_t { kTopDownFactor = 14, kBottomUpFactor = 24 };
+
+    /// ParallelDistanceField - Compute the shortest distance (number of passages) from source to each cell
+    /// of a FlatGrid by a level-synchronous breadth first search.
+    ///
+    /// Each level is expanded either top-down, the cells of the frontier claiming their unvisited neighbours
+    /// within an atomic visited bitmap and filling per-thread frontier queues, or bottom-up, each unvisited
+    /// cell looking for a neighbour within the frontier bitmap, words of the bitmaps being owned by a single
+    /// task. The direction follows Beamer's heuristic: the search goes bottom-up once the frontier exceeds
+    /// 1 / topDownFactor of the unvisited cells, and back top-down once the frontier shrinks below
+    /// 1 / bottomUpFactor of the grid. Within open areas and perfect mazes, whose frontiers stay far below
+    /// the unvisited cells, this leaves the last levels of the searches bottom-up.
+    ///
+    /// Levels with a frontier below kParallelFrontierSize are expanded by the calling thread alone; the
+    /// other levels are run by a single team of threadCount threads kept alive across consecutive levels.
+    ///
+    /// @tparam CellInfo the struct storing extra information associated with each cell.
+    /// @tparam Layout the layout of the grid.
+    ///
+    /// @param maze the grid.
+    /// @param source the index of the source cell.
+    /// @param distances the distance of each index of the grid (kUnreachable if not connected to source).
+    /// @param threadCount number of threads to be used, 0 to use every hardware thread.
+    /// @param bottomUpLevels if not null, receives the number of levels expanded bottom-up.
+    /// @param topDownFactor,bottomUpFactor the factors of the direction optimizing heuristic (a null
+    /// topDownFactor keeps every level top-down).
+    ///
+    /// @return the largest distance from source.
+    template <typename CellInfo, typename Layout>
+    uint32_t ParallelDistanceField(const FlatGrid<CellInfo, Layout>& maze, uint64_t source,
+                                   std::vector<uint32_t>& distances, uint32_t threadCount = 0,
+                                   uint32_t* bottomUpLevels = nullptr, uint64_t topDownFactor = kTopDownFactor,
+                                   uint64_t bottomUpFactor = kBottomUpFactor)
+    {
+      typedef uint64_t Index;
+      enum : size_t { kWordsPerTask = 1 << 10, kCellsPerTask = 1 << 12 };
+
+      threadCount = combinatory::GetThreadCount(threadCount);
+      const size_t kCapacity = static_cast<size_t>(maze.Capacity());
+      const size_t kWordCount = (kCapacity + 63) / 64;
+      const size_t kWordTaskCount = (kWordCount + kWordsPerTask - 1) / kWordsPerTask;
+
+      // Initialize the distances and bitmaps
+      distances.resize(kCapacity);
+      std::vector<std::atomic<uint64_t>> visited(kWordCount), frontier(kWordCount);
+      std::vector<uint64_t> nextFrontier(kWordCount);
+      combinatory::ParallelTasks(kWordTaskCount, threadCount, [&](size_t task, uint32_t)
+      {
+        const size_t kEnd = std::min<size_t>(kWordCount, (task + 1) * kWordsPerTask);
+        for (size_t word = task * kWordsPerTask; word < kEnd; ++word)
+        {
+          visited[word].store(0, std::memory_order_relaxed);
+          frontier[word].store(0, std::memory_order_relaxed);
+          std::fill(distances.begin() + std::min(kCapacity, 64 * word),
+                    distances.begin() + std::min(kCapacity, 64 * (word + 1)), kUnreachable);
+        }
+      });
+
+      std::vector<std::vector<Index>> queues(threadCount), nextQueues(threadCount);
+      std::vector<uint64_t> counts(threadCount);  // Cells reached by each thread, added once per task
+      queues[0].push_back(source);
+      visited[source / 64].store(uint64_t(1) << (source % 64), std::memory_order_relaxed);
+      distances[source] = 0;
+
+      // State of the current level, only changed by a single thread between the phases
+      enum : uint8_t { kNoSwitch = 0, kToBottomUp, kToTopDown };
+      uint64_t frontierSize = 1, previousFrontierSize = 0, unvisitedCount = maze.Size() - 1;
+      uint32_t level = 0, bottomUpCount = 0;
+      uint8_t directionSwitch = kNoSwitch;
+      bool isBottomUp = false, isParallel = false;
+      std::vector<size_t> firstTasks(threadCount + 1, 0); // First top-down task of each queue
+      std::atomic<size_t> nextTasks[3];                   // Task counters of the phases of a level
+
+      // Choose the direction of the level and how it is run
+      auto lPrepareLevel = [&]()
+      {
+        const bool kIsSmallFrontier = frontierSize * bottomUpFactor < maze.Size();
+        directionSwitch = kNoSwitch;
+        if (!isBottomUp && frontierSize * topDownFactor > unvisitedCount)
+          directionSwitch = kToBottomUp;
+        else if (isBottomUp && kIsSmallFrontier && frontierSize < previousFrontierSize)
+          directionSwitch = kToTopDown;
+        isBottomUp = (directionSwitch == kNoSwitch) ? isBottomUp : directionSwitch == kToBottomUp;
+        bottomUpCount += isBottomUp ? 1 : 0;
+        isParallel = isBottomUp || directionSwitch != kNoSwitch || frontierSize >= kParallelFrontierSize;
+
+        // Tasks are chunks of the per-thread queues (once moved out of the bitmap when switching to top-down)
+        for (uint32_t thread = 0; thread < threadCount && directionSwitch == kNoSwitch && !isBottomUp; ++thread)
+          firstTasks[thread + 1] =
+            firstTasks[thread] + (queues[thread].size() + kCellsPerTask - 1) / kCellsPerTask;
+        std::fill(counts.begin(), counts.end(), 0);
+        for (size_t phase = 0; phase < 3; ++phase)
+          nextTasks[phase].store(0, std::memory_order_relaxed);
+      };
+
+      // Account for the cells reached by the level
+      auto lFinishLevel = [&]()
+      {
+        for (uint32_t thread = 0; thread < threadCount && !isBottomUp; ++thread)
+        {
+          queues[thread].swap(nextQueues[thread]);
+          nextQueues[thread].clear();
+        }
+
+        previousFrontierSize = frontierSize;
+        frontierSize = 0;
+        for (auto it = counts.begin(); it != counts.end(); ++it)
+          frontierSize += *it;
+        unvisitedCount -= frontierSize;
+        if (frontierSize > 0)
+          ++level;
+      };
+
+      // Each cell of the frontier claims its unvisited neighbours
+      auto lExpand = [&](const std::vector<Index>& queue, size_t begin, size_t end, uint32_t threadIdx)
+      {
+        uint64_t count = 0;
+        for (size_t i = begin; i < end; ++i)
+          maze.ForEachConnected(queue[i], [&](Index neighbour, GridDirection)
+          {
+            const uint64_t kBit = uint64_t(1) << (neighbour % 64);
+            if (visited[neighbour / 64].load(std::memory_order_relaxed) & kBit)
+              return;
+            if (visited[neighbour / 64].fetch_or(kBit, std::memory_order_relaxed) & kBit)
+              return;
+            distances[neighbour] = level + 1;
+            nextQueues[threadIdx].push_back(neighbour);
+            ++count;
+          });
+        counts[threadIdx] += count;
+      };
+
+      // Run the phases of the level, the threads of a team pulling their tasks from shared counters and
+      // waiting for each other at the end of each phase
+      combinatory::Barrier barrier(threadCount);
+      auto lRunLevel = [&](uint32_t threadIdx, bool isTeam)
+      {
+        auto lRunTasks = [&](std::atomic<size_t>& nextTask, size_t taskCount, const std::function<void(size_t)>& f)
+        {
+          for (size_t task = nextTask++; task < taskCount; task = nextTask++)
+            f(task);
+          if (isTeam)
+            barrier.Wait();
+        };
+
+        // Direction switch, moving the frontier between queues and bitmap
+        if (directionSwitch == kToBottomUp)
+          lRunTasks(nextTasks[0], threadCount, [&](size_t task)
+          {
+            for (auto it = queues[task].begin(); it != queues[task].end(); ++it)
+              frontier[*it / 64].fetch_or(uint64_t(1) << (*it % 64), std::memory_order_relaxed);
+            queues[task].clear();
+          });
+        else if (directionSwitch == kToTopDown)
+          lRunTasks(nextTasks[0], kWordTaskCount, [&](size_t task)
+          {
+            const size_t kEnd = std::min<size_t>(kWordCount, (task + 1) * kWordsPerTask);
+            for (size_t word = task * kWordsPerTask; word < kEnd; ++word)
+            {
+              for (uint64_t bits = frontier[word].load(std::memory_order_relaxed); bits; bits &= bits - 1)
+                queues[threadIdx].push_back(64 * word + combinatory::CountTrailingZeros(bits));
+              frontier[word].store(0, std::memory_order_relaxed);
+            }
+          });
+
+        if (isBottomUp)
+        {
+          // Each unvisited cell looks for a neighbour within the frontier
+          lRunTasks(nextTasks[1], kWordTaskCount, [&](size_t task)
+          {
+            const size_t kEnd = std::min<size_t>(kWordCount, (task + 1) * kWordsPerTask);
+            uint64_t count = 0;
+            for (size_t word = task * kWordsPerTask; word < kEnd; ++word)
+            {
+              uint64_t found = 0;
+              for (uint64_t bits = ~visited[word].load(std::memory_order_relaxed); bits; bits &= bits - 1)
+              {
+                const Index kCell = 64 * word + combinatory::CountTrailingZeros(bits);
+                if (kCell >= kCapacity)
+                  break;
+
+                bool isReached = false;
+                maze.ForEachConnected(kCell, [&](Index neighbour, GridDirection)
+                {
+                  isReached = isReached ||
+                    ((frontier[neighbour / 64].load(std::memory_order_relaxed) >> (neighbour % 64)) & 1);
+                });
+                if (isReached)
+                {
+                  found |= uint64_t(1) << (kCell % 64);
+                  distances[kCell] = level + 1;
+                }
+              }
+              nextFrontier[word] = found;
+              visited[word].fetch_or(found, std::memory_order_relaxed);
+              count += combinatory::PopCount(found);
+            }
+            counts[threadIdx] += count;
+          });
+          lRunTasks(nextTasks[2], kWordTaskCount, [&](size_t task)
+          {
+            const size_t kEnd = std::min<size_t>(kWordCount, (task + 1) * kWordsPerTask);
+            for (size_t word = task * kWordsPerTask; word < kEnd; ++word)
+              frontier[word].store(nextFrontier[word], std::memory_order_relaxed);
+          });
+        }
+        else if (directionSwitch == kToTopDown)
+        {
+          // The queues were just filled from the bitmap: one task per queue
+          lRunTasks(nextTasks[1], threadCount, [&](size_t task)
+          { lExpand(queues[task], 0, queues[task].size(), threadIdx); });
+        }
+        else
+        {
+          lRunTasks(nextTasks[1], firstTasks.back(), [&](size_t task)
+          {
+            const uint32_t kQueue = static_cast<uint32_t>(
+              std::upper_bound(firstTasks.begin(), firstTasks.end(), task) - firstTasks.begin() - 1);
+            const size_t kBegin = (task - firstTasks[kQueue]) * kCellsPerTask;
+            lExpand(queues[kQueue], kBegin, std::min(queues[kQueue].size(), kBegin + kCellsPerTask), threadIdx);
+          });
+        }
+      };
+
+      // Levels with a small top-down frontier are run by the calling thread alone. The others are run by a
+      // team of threads kept alive across consecutive levels, thread 0 preparing each level between barriers.
+      lPrepareLevel();
+      while (frontierSize > 0)
+      {
+        if (!isParallel)
+        {
+          lRunLevel(0, false);
+          lFinishLevel();
+          if (frontierSize > 0)
+            lPrepareLevel();
+          continue;
+        }
+
+        bool isTeamNeeded = true;
+        combinatory::ParallelRun(threadCount, [&](uint32_t threadIdx)
+        {
+          while (true)
+          {
+            lRunLevel(threadIdx, true);
+            if (threadIdx == 0)
+            {
+              lFinishLevel();
+              if (frontierSize > 0)
+                lPrepareLevel();
+              isTeamNeeded = frontierSize > 0 && isParallel;
+            }
+            barrier.Wait();
+            if (!isTeamNeeded)
+              return;
+          }
+        });
+      }
+
+      if (bottomUpLevels)
+        *bottomUpLevels = bottomUpCount;
+      return level;
+    }
+  }
+}
+
+#endif // MODULE_MAZE_DISTANCE_FIELD_HXX
@@ -0,0 +1,120 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#ifndef MODULE_MAZE_GRAPH_PATH_FINDER_HXX
+#define MODULE_MAZE_GRAPH_PATH_FINDER_HXX
+
+#include <DataStructures/csr_graph.hxx>
+
+// STD includes
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace huc
+{
+  namespace maze
+  {
+    /// @class GraphPathFinder
+    ///
+    /// Graph Path Finder answers shortest path queries between vertices of a CSRGraph, following its active
+    /// edges (unit cost per passage): the graph counterpart of GridPathFinder::BFS for any topology.
+    ///
+    /// The buffers (visited bitset, parent vertices, frontier) are allocated once for the graph and only the
+    /// vertices touched by a query are cleared afterwards.
+    ///
+    /// @warning the graph must outlive the path finder.
+    class GraphPathFinder
+    {
+    public:
+      typedef CSRGraph::Vertex Vertex;
+
+      /// GraphPathFinder constructor - Allocate the search buffers for the graph.
+      ///
+      /// @param graph the graph within which paths are searched.
+      explicit GraphPathFinder(const CSRGraph& graph) :
+        graph(graph), visited((static_cast<size_t>(graph.VertexCount()) + 63) / 64, 0),
+        parents(graph.VertexCount(), 0), expandedCount(0)
+      { this->frontier.reserve(1024); }
+
+      /// BFS - Breadth first search from source to target.
+      ///
+      /// @param source,target the end vertices.
+      /// @param path the vertices of the shortest path from source to target, both included (empty if none).
+      ///
+      /// @return true if target is reachable from source.
+      bool BFS(Vertex source, Vertex target, std::vector<Vertex>& path)
+      {
+        path.clear();
+        this->expandedCount = 0;
+        if (source >= this->graph.VertexCount() || target >= this->graph.VertexCount())
+          return false;
+
+        this->frontier.clear();
+        this->frontier.push_back(source);
+        Mark(source);
+
+        bool isFound = (source == target);
+        for (size_t head = 0; head < this->frontier.size() && !isFound; ++head)
+        {
+          const Vertex kVertex = this->frontier[head];
+          ++this->expandedCount;
+          this->graph.ForEachConnected(kVertex, [&](Vertex neighbour, CSRGraph::EdgeId)
+          {
+            if (IsMarked(neighbour))
+              return;
+            Mark(neighbour);
+            this->parents[neighbour] = kVertex;
+            this->frontier.push_back(neighbour);
+            isFound = isFound || neighbour == target;
+          });
+        }
+
+        if (isFound)
+        {
+          for (Vertex vertex = target; vertex != source; vertex = this->parents[vertex])
+            path.push_back(vertex);
+          path.push_back(source);
+          std::reverse(path.begin(), path.end());
+        }
+
+        for (auto it = this->frontier.begin(); it != this->frontier.end(); ++it)
+          this->visited[*it >> 6] = 0;
+        return isFound;
+      }
+
+      /// ExpandedCount - Number of vertices expanded by the last query.
+      uint64_t ExpandedCount() const { return this->expandedCount; }
+
+    private:
+      GraphPathFinder operator=(const GraphPathFinder&);  // Not Implemented
+
+      const CSRGraph& graph;           // Searched graph
+      std::vector<uint64_t> visited;   // Visited vertices bitset
+      std::vector<Vertex> parents;     // Parent of each visited vertex
+      std::vector<Vertex> frontier;    // Visited vertices, in visit order
+      uint64_t expandedCount;          // Number of vertices expanded by the last query
+
+      bool IsMarked(Vertex vertex) const { return (this->visited[vertex >> 6] >> (vertex & 63)) & 1; }
+      void Mark(Vertex vertex) { this->visited[vertex >> 6] |= uint64_t(1) << (vertex & 63); }
+    };
+  }
+}
+
+#endif // MODULE_MAZE_GRAPH_PATH_FINDER_HXX
@@ -0,0 +1,444 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#ifndef MODULE_MAZE_GRID_PATH_FINDER_HXX
+#define MODULE_MAZE_GRID_PATH_FINDER_HXX
+
+#include <Combinatory/intrinsics.hxx>
+#include <DataStructures/flat_grid.hxx>
+
+// STD includes
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace huc
+{
+  namespace maze
+  {
+    /// @class GridPathFinder
+    ///
+    /// Grid Path Finder answers shortest path queries between cells of a FlatGrid, following its
+    /// connections (unit cost per passage) whatever its layout:
+    /// - BFS: breadth first search over a flat frontier array.
+    /// - BidirectionalBFS: breadth first searches from both ends, expanding the smallest frontier level.
+    /// - AStar: A* guided by the Manhattan distance, over a radix heap.
+    /// - JumpPointSearch: A* over jump points only, skipping the cells of straight runs that cannot start a
+    ///   canonical shortest path, which pays off on open grids (few walls).
+    ///
+    /// All the buffers (visited bitsets, parent directions, costs, frontiers, heap) are allocated once for the
+    /// grid and only the cells touched by a query are cleared afterwards: queries do not allocate once the
+    /// frontiers and the path have reached their working capacity.
+    ///
+    /// @warning the grid must outlive the path finder and keep its dimensions.
+    ///
+    /// @tparam CellInfo the struct storing extra information associated with each cell.
+    /// @tparam Layout the layout of the grid.
+    template <typename CellInfo, typename Layout>
+    class GridPathFinder
+    {
+    public:
+      typedef FlatGrid<CellInfo, Layout> Maze;
+      typedef typename Maze::Index Index;
+
+      /// GridPathFinder constructor - Allocate the search buffers for the maze.
+      ///
+      /// @param maze the grid within which paths are searched.
+      explicit GridPathFinder(const Maze& maze) : maze(maze), expandedCount(0)
+      {
+        const size_t kWords = static_cast<size_t>((maze.Capacity() + 63) / 64);
+        for (int side = 0; side < 2; ++side)
+        {
+          this->visited[side].assign(kWords, 0);
+          this->parents[side].assign(static_cast<size_t>(maze.Capacity()), 0);
+          this->frontiers[side].reserve(1024);
+        }
+        this->costs.assign(static_cast<size_t>(maze.Capacity()), 0);
+      }
+
+      /// BFS - Breadth first search from source to target.
+      ///
+      /// @param source,target the indexes of the end cells.
+      /// @param path the cells of the shortest path from source to target, both included (empty if none).
+      ///
+      /// @return true if target is reachable from source.
+      bool BFS(Index source, Index target, std::vector<Index>& path)
+      {
+        path.clear();
+        this->expandedCount = 0;
+
+        auto& frontier = this->frontiers[0];
+        frontier.clear();
+        frontier.push_back(source);
+        Mark(0, source);
+
+        bool isFound = (source == target);
+        for (size_t head = 0; head < frontier.size() && !isFound; ++head)
+        {
+          const Index kCell = frontier[head];
+          ++this->expandedCount;
+          this->maze.ForEachConnected(kCell, [&](Index neighbour, GridDirection direction)
+          {
+            if (IsMarked(0, neighbour))
+              return;
+            Mark(0, neighbour);
+            this->parents[0][neighbour] = OppositeDirection(direction);
+            frontier.push_back(neighbour);
+            isFound = isFound || neighbour == target;
+          });
+        }
+
+        if (isFound)
+          AppendChain(0, target, source, path);
+        std::reverse(path.begin(), path.end());
+
+        Unmark(0, frontier);
+        return isFound;
+      }
+
+      /// BidirectionalBFS - Breadth first searches from source and from target until they meet, expanding
+      /// one level of the smallest frontier at a time.
+      ///
+      /// @param source,target the indexes of the end cells.
+      /// @param path the cells of the shortest path from source to target, both included (empty if none).
+      ///
+      /// @return true if target is reachable from source.
+      bool BidirectionalBFS(Index source, Index target, std::vector<Index>& path)
+      {
+        path.clear();
+        this->expandedCount = 0;
+
+        const Index kEnds[2] = {source, target};
+        size_t heads[2] = {0, 0};
+        for (int side = 0; side < 2; ++side)
+        {
+          this->frontiers[side].clear();
+          this->frontiers[side].push_back(kEnds[side]);
+          Mark(side, kEnds[side]);
+        }
+
+        bool isFound = (source == target);
+        Index meeting = source;
+        while (!isFound && heads[0] < this->frontiers[0].size() && heads[1] < this->frontiers[1].size())
+        {
+          // Expand a whole level of the smallest frontier: any meeting is then a shortest path
+          const int kSide = (this->frontiers[0].size() - heads[0] <= this->frontiers[1].size() - heads[1]) ? 0 : 1;
+          auto& frontier = this->frontiers[kSide];
+          const size_t kLevelEnd = frontier.size();
+          for (; heads[kSide] < kLevelEnd && !isFound; ++heads[kSide])
+          {
+            ++this->expandedCount;
+            this->maze.ForEachConnected(frontier[heads[kSide]], [&](Index neighbour, GridDirection direction)
+            {
+              if (isFound || IsMarked(kSide, neighbour))
+                return;
+              Mark(kSide, neighbour);
+              this->parents[kSide][neighbour] = OppositeDirection(direction);
+              frontier.push_back(neighbour);
+              if (IsMarked(1 - kSide, neighbour))
+              {
+                isFound = true;
+                meeting = neighbour;
+              }
+            });
+          }
+        }
+
+        if (isFound)
+        {
+          AppendChain(0, meeting, source, path);
+          std::reverse(path.begin(), path.end());
+          if (meeting != target)
+          {
+            AppendChain(1, this->maze.Neighbour(meeting, static_cast<GridDirection>(this->parents[1][meeting])),
+                        target, path);
+          }
+        }
+
+        Unmark(0, this->frontiers[0]);
+        Unmark(1, this->frontiers[1]);
+        return isFound;
+      }
+
+      /// AStar - A* search from source to target guided by the Manhattan distance.
+      ///
+      /// @param source,target the indexes of the end cells.
+      /// @param path the cells of the shortest path from source to target, both included (empty if none).
+      ///
+      /// @return true if target is reachable from source.
+      bool AStar(Index source, Index target, std::vector<Index>& path)
+      { return Search(source, target, path, false); }
+
+      /// JumpPointSearch - A* search from source to target over jump points (cf. Jump).
+      ///
+      /// @param source,target the indexes of the end cells.
+      /// @param path the cells of the shortest path from source to target, both included (empty if none).
+      ///
+      /// @return true if target is reachable from source.
+      bool JumpPointSearch(Index source, Index target, std::vector<Index>& path)
+      { return Search(source, target, path, true); }
+
+      /// ExpandedCount - Number of cells (jump points for JumpPointSearch) expanded by the last query.
+      uint64_t ExpandedCount() const { return this->expandedCount; }
+
+    private:
+      GridPathFinder operator=(const GridPathFinder&); // Not Implemented
+
+      /// Monotone priority queue (keys never below the last popped one): an entry lives in the bucket of
+      /// the highest bit differing from the last popped key, and is only moved to lower buckets.
+      class RadixHeap
+      {
+      public:
+        RadixHeap() : last(0), size(0) {}
+
+        bool IsEmpty() const { return this->size == 0; }
+        void Clear()
+        {
+          for (int i = 0; i < kBucketCount; ++i)
+            this->buckets[i].clear();
+          this->last = 0;
+          this->size = 0;
+        }
+
+        void Push(uint32_t key, Index value)
+        {
+          this->buckets[Bucket(key)].push_back(std::make_pair(key, value));
+          ++this->size;
+        }
+
+        std::pair<uint32_t, Index> Pop()
+        {
+          if (this->buckets[0].empty())
+          {
+            int i = 1;
+            while (this->buckets[i].empty())
+              ++i;
+
+            // Redistribute the bucket around its minimum key
+            auto& bucket = this->buckets[i];
+            this->last = std::min_element(bucket.begin(), bucket.end())->first;
+            for (auto it = bucket.begin(); it != bucket.end(); ++it)
+              this->buckets[Bucket(it->first)].push_back(*it);
+            bucket.clear();
+          }
+
+          const auto kEntry = this->buckets[0].back();
+          this->buckets[0].pop_back();
+          --this->size;
+          return kEntry;
+        }
+
+      private:
+        enum : int { kBucketCount = 33 };
+
+        std::vector<std::pair<uint32_t, Index>> buckets[kBucketCount];
+        uint32_t last;  // Last popped key
+        size_t size;    // Number of entries
+
+        int Bucket(uint32_t key) const
+        {
+          return (key == this->last) ? 0 :
+            64 - static_cast<int>(combinatory::CountLeadingZeros(key ^ this->last));
+        }
+      };
+
+      const Maze& maze;                          // Grid within which paths are searched
+      std::vector<uint64_t> visited[2];          // Visited (BFS) or seen and closed (A*) cells
+      std::vector<uint8_t> parents[2];           // Direction from each cell towards its parent
+      std::vector<uint32_t> costs;               // Cost from the source (A*)
+      std::vector<Index> frontiers[2];           // BFS frontiers, cells seen by A*
+      RadixHeap heap;                            // A* open list keyed by cost + heuristic
+      uint64_t expandedCount;                    // Number of cells expanded by the last query
+
+      bool IsMarked(int side, Index index) const
+      { return (this->visited[side][index >> 6] >> (index & 63)) & 1; }
+      void Mark(int side, Index index) { this->visited[side][index >> 6] |= uint64_t(1) << (index & 63); }
+      void Unmark(int side, const std::vector<Index>& cells)
+      {
+        for (auto it = cells.begin(); it != cells.end(); ++it)
+          this->visited[side][*it >> 6] = 0;
+      }
+
+      /// Push the cells from index to end following the parents of the side, both included.
+      void AppendChain(int side, Index index, Index end, std::vector<Index>& path) const
+      {
+        path.push_back(index);
+        for (; index != end; path.push_back(index))
+          index = this->maze.Neighbour(index, static_cast<GridDirection>(this->parents[side][index]));
+      }
+
+      uint32_t Manhattan(Index index, const typename Maze::Point& target) const
+      {
+        const auto kPoint = this->maze.PointOf(index);
+        return ((kPoint.x > target.x) ? kPoint.x - target.x : target.x - kPoint.x) +
+               ((kPoint.y > target.y) ? kPoint.y - target.y : target.y - kPoint.y);
+      }
+
+      /// A* over cells or jump points: side 0 marks the seen cells, side 1 the closed ones.
+      bool Search(Index source, Index target, std::vector<Index>& path, bool isJumping)
+      {
+        path.clear();
+        this->expandedCount = 0;
+        this->heap.Clear();
+
+        const auto kTarget = this->maze.PointOf(target);
+        auto& seen = this->frontiers[0];
+        seen.clear();
+        seen.push_back(source);
+        Mark(0, source);
+        this->costs[source] = 0;
+        this->heap.Push(Manhattan(source, kTarget), source);
+
+        bool isFound = false;
+        while (!this->heap.IsEmpty())
+        {
+          const Index kCell = this->heap.Pop().second;
+          if (IsMarked(1, kCell))
+            continue;   // Already reached with a lower cost
+
+          Mark(1, kCell);
+          ++this->expandedCount;
+          if (kCell == target)
+          {
+            isFound = true;
+            break;
+          }
+
+          const uint8_t kLinks = this->maze.Links(kCell);
+          const uint8_t kDirections = (isJumping && kCell != source) ? JumpDirections(kCell) : kLinks;
+          for (uint8_t direction = kNorth; direction <= kWest; ++direction)
+          {
+            if (!((kDirections >> direction) & 1))
+              continue;
+
+            Index next = this->maze.Neighbour(kCell, static_cast<GridDirection>(direction));
+            uint32_t steps = 1;
+            if (isJumping && !Jump(kCell, static_cast<GridDirection>(direction), target, next, steps))
+              continue;
+
+            const uint32_t kCost = this->costs[kCell] + steps;
+            if (IsMarked(1, next) || (IsMarked(0, next) && this->costs[next] <= kCost))
+              continue;
+            if (!IsMarked(0, next))
+            {
+              Mark(0, next);
+              seen.push_back(next);
+            }
+            this->costs[next] = kCost;
+            this->parents[0][next] = OppositeDirection(static_cast<GridDirection>(direction));
+            this->heap.Push(kCost + Manhattan(next, kTarget), next);
+          }
+        }
+
+        if (isFound)
+        {
+          // Walk back each straight segment until its closed origin
+          path.push_back(target);
+          for (Index cell = target; cell != source;)
+          {
+            const auto kDirection = static_cast<GridDirection>(this->parents[0][cell]);
+            uint32_t steps = 0;
+            Index previous = cell;
+            do
+            {
+              previous = this->maze.Neighbour(previous, kDirection);
+              path.push_back(previous);
+              ++steps;
+            } while (!(IsMarked(1, previous) && this->costs[previous] + steps == this->costs[cell]));
+            cell = previous;
+          }
+          std::reverse(path.begin(), path.end());
+        }
+
+        Unmark(0, seen);
+        Unmark(1, seen);
+        return isFound;
+      }
+
+      /// Directions worth following from a jump point (canonical paths turn vertically after a horizontal
+      /// move only where the vertical move could not have been made one cell earlier).
+      uint8_t JumpDirections(Index index) const
+      {
+        const auto kTravel = OppositeDirection(static_cast<GridDirection>(this->parents[0][index]));
+        const uint8_t kLinks = this->maze.Links(index);
+        if (kTravel == kNorth || kTravel == kSouth)
+          return kLinks & static_cast<uint8_t>((1 << kTravel) | (1 << kEast) | (1 << kWest));
+
+        const Index kPrevious = this->maze.Neighbour(index, OppositeDirection(kTravel));
+        return kLinks & static_cast<uint8_t>((1 << kTravel) | ForcedDirections(index, kPrevious, kTravel));
+      }
+
+      /// Vertical directions open from index that cannot be reached by turning one cell earlier at previous.
+      uint8_t ForcedDirections(Index index, Index previous, GridDirection travel) const
+      {
+        uint8_t forced = 0;
+        const GridDirection kVerticals[2] = {kNorth, kSouth};
+        for (int i = 0; i < 2; ++i)
+          if (this->maze.IsConnected(index, kVerticals[i]) &&
+              !(this->maze.IsConnected(previous, kVerticals[i]) &&
+                this->maze.IsConnected(this->maze.Neighbour(previous, kVerticals[i]), travel)))
+            forced |= static_cast<uint8_t>(1 << kVerticals[i]);
+        return forced;
+      }
+
+      /// Horizontal jump: run straight until the target or a cell with a forced vertical direction.
+      bool JumpHorizontal(Index index, GridDirection travel, Index target, Index& jumpPoint, uint32_t& steps) const
+      {
+        while (this->maze.IsConnected(index, travel))
+        {
+          const Index kNext = this->maze.Neighbour(index, travel);
+          ++steps;
+          if (kNext == target || ForcedDirections(kNext, index, travel))
+          {
+            jumpPoint = kNext;
+            return true;
+          }
+          index = kNext;
+        }
+        return false;
+      }
+
+      /// Jump from index in the travel direction: vertical jumps stop where a horizontal jump succeeds.
+      bool Jump(Index index, GridDirection travel, Index target, Index& jumpPoint, uint32_t& steps) const
+      {
+        steps = 0;
+        if (travel == kEast || travel == kWest)
+          return JumpHorizontal(index, travel, target, jumpPoint, steps);
+
+        while (this->maze.IsConnected(index, travel))
+        {
+          index = this->maze.Neighbour(index, travel);
+          ++steps;
+          Index sideJumpPoint;
+          uint32_t sideSteps = 0;
+          if (index == target || JumpHorizontal(index, kEast, target, sideJumpPoint, sideSteps) ||
+              JumpHorizontal(index, kWest, target, sideJumpPoint, sideSteps))
+          {
+            jumpPoint = index;
+            return true;
+          }
+        }
+        return false;
+      }
+    };
+  }
+}
+
+#endif // MODULE_MAZE_GRID_PATH_FINDER_HXX
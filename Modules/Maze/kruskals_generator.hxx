@@ -20,10 +20,15 @@
 #ifndef MODULE_MAZE_KRUSKALSG_HXX
 #define MODULE_MAZE_KRUSKALSG_HXX
 
+#include <DataStructures/csr_graph.hxx>
+#include <DataStructures/flat_grid.hxx>
 #include <DataStructures/grid.hxx>
+#include <DataStructures/grid_n.hxx>
 
 // STD
+#include <algorithm>
 #include <random>
+#include <vector>
 
 namespace huc
 {
@@ -107,7 +112,139 @@ namespace huc
         return maze;
       }
 
+      /// Carve the maze within a disconnected FlatGrid, whatever its layout: the east and south passages are
+      /// taken in random order and carved when they join two distinct buckets (union-find). Passages being
+      /// enumerated row by row whatever the layout, the maze does not depend on the layout.
+      ///
+      /// @param maze the grid to be carved.
+      /// @param seed number used to initiate the random generator.
+      ///
+      /// @return void.
+      template <typename CellInfo, typename Layout>
+      void operator()(FlatGrid<CellInfo, Layout>& maze, const uint32_t seed = 0)
+      {
+        typedef typename FlatGrid<CellInfo, Layout>::Index Index;
+        const uint64_t kWidth = maze.Width();
+        Carve<Index, GridDirection>(maze, maze.Size(), maze.Capacity(), seed,
+                                    [&](uint64_t idx)
+                                    { return maze.IndexOf(static_cast<uint32_t>(idx % kWidth),
+                                                          static_cast<uint32_t>(idx / kWidth)); },
+                                    [](Index, Index, GridDirection direction)
+                                    { return direction == kEast || direction == kSouth; },
+                                    [&](Index cell, GridDirection direction) { maze.Connect(cell, direction); });
+      }
+
+      /// Carve the maze within a disconnected GridN: the forward passages are taken in random order and carved
+      /// when they join two distinct buckets (union-find). Passages are enumerated cell by cell along increasing
+      /// axes, so that for D = 2 the maze is the one built over a row-major FlatGrid.
+      ///
+      /// @param maze the grid to be carved.
+      /// @param seed number used to initiate the random generator.
+      ///
+      /// @return void.
+      template <uint32_t D, typename CellInfo>
+      void operator()(GridN<D, CellInfo>& maze, const uint32_t seed = 0)
+      {
+        typedef GridN<D, CellInfo> MazeN;
+        typedef typename MazeN::Index Index;
+        typedef typename MazeN::Direction Direction;
+        Carve<Index, Direction>(maze, maze.Size(), maze.Size(), seed,
+                                [](uint64_t idx) { return static_cast<Index>(idx); },
+                                [](Index, Index, Direction direction) { return MazeN::IsForward(direction); },
+                                [&](Index cell, Direction direction) { maze.Connect(cell, direction); });
+      }
+
+      /// Carve the maze within a CSRGraph whose edges are all inactive: edges are taken in random order and
+      /// activated when they join two distinct buckets (union-find), building a random spanning forest.
+      ///
+      /// @param graph the graph to be carved.
+      /// @param seed number used to initiate the random generator.
+      ///
+      /// @return void.
+      void operator()(CSRGraph& graph, const uint32_t seed = 0)
+      {
+        typedef CSRGraph::Vertex Vertex;
+        Carve<Vertex, CSRGraph::EdgeId>(graph, graph.VertexCount(), graph.VertexCount(), seed,
+                                        [](uint64_t idx) { return static_cast<Vertex>(idx); },
+                                        [](Vertex vertex, Vertex neighbour, CSRGraph::EdgeId)
+                                        { return vertex < neighbour; },
+                                        [&](Vertex, CSRGraph::EdgeId edge) { graph.SetActive(edge, true); });
+      }
+
     private:
+      /// Passage - Link from a vertex toward its neighbour.
+      template <typename Vertex, typename Link>
+      struct Passage
+      {
+        Vertex vertex;
+        Vertex neighbour;
+        Link link;
+      };
+
+      /// Carve - Carve the maze over any graph exposing ForEachNeighbour: the passages are taken in random order
+      /// and carved when they join two distinct buckets (union-find).
+      ///
+      /// @param graph the graph whose ForEachNeighbour(vertex, functor(neighbour, link)) lists the neighbours.
+      /// @param vertexCount number of vertices to enumerate.
+      /// @param bucketCount upper bound of the vertices of the graph.
+      /// @param seed number used to initiate the random generator.
+      /// @param vertexAt functor(idx) returning the idx-th vertex, passages being enumerated in that order.
+      /// @param isPassage functor(vertex, neighbour, link) keeping a single arc of each passage.
+      /// @param connect functor(vertex, link) carving the passage from the vertex through the link.
+      ///
+      /// @return void.
+      template <typename Vertex, typename Link, typename Graph, typename VertexAt, typename IsPassage,
+                typename Connect>
+      static void Carve(const Graph& graph, const uint64_t vertexCount, const uint64_t bucketCount,
+                        const uint32_t seed, VertexAt vertexAt, IsPassage isPassage, Connect connect)
+      {
+        std::mt19937 mt(seed); // Random generator - Mersenne Twister algorithm
+
+        // Random order of the passages (Fisher-Yates)
+        std::vector<Passage<Vertex, Link>> passages;
+        for (uint64_t idx = 0; idx < vertexCount; ++idx)
+        {
+          const Vertex kVertex = vertexAt(idx);
+          graph.ForEachNeighbour(kVertex, [&](Vertex neighbour, Link link)
+          {
+            if (!isPassage(kVertex, neighbour, link))
+              return;
+            const size_t kIdx = mt() % (passages.size() + 1);
+            const Passage<Vertex, Link> kPassage = { kVertex, neighbour, link };
+            passages.push_back(kPassage);
+            std::swap(passages[kIdx], passages.back());
+          });
+        }
+
+        // Each vertex starts within its own bucket, represented by its root vertex
+        std::vector<Vertex> buckets(static_cast<size_t>(bucketCount));
+        for (uint64_t vertex = 0; vertex < bucketCount; ++vertex)
+          buckets[static_cast<size_t>(vertex)] = static_cast<Vertex>(vertex);
+
+        for (auto it = passages.begin(); it != passages.end(); ++it)
+        {
+          const auto kFirstBucket = FindBucket(buckets, it->vertex);
+          const auto kSecondBucket = FindBucket(buckets, it->neighbour);
+          if (kFirstBucket != kSecondBucket)
+          {
+            connect(it->vertex, it->link);
+            buckets[kFirstBucket] = kSecondBucket;
+          }
+        }
+      }
+
+      /// FindBucket - Root of the bucket of index, halving the path to the root on the way.
+      template <typename Index>
+      static Index FindBucket(std::vector<Index>& buckets, Index index)
+      {
+        while (buckets[index] != index)
+        {
+          buckets[index] = buckets[buckets[index]];
+          index = buckets[index];
+        }
+        return index;
+      }
+
       /// MergeBucket - Merge two buckets of node together and update node bucket Id.
       ///
       /// @param buckets vector containing all the buckets
@@ -20,11 +20,15 @@
 #ifndef MODULE_MAZE_PRIMSG_HXX
 #define MODULE_MAZE_PRIMSG_HXX
 
+#include <DataStructures/csr_graph.hxx>
+#include <DataStructures/flat_grid.hxx>
 #include <DataStructures/grid.hxx>
+#include <DataStructures/grid_n.hxx>
 
 // STD
 #include <random>
 #include <stack>
+#include <vector>
 
 namespace huc
 {
@@ -96,6 +100,69 @@ namespace huc
         return maze;
       }
 
+      /// Carve the maze within a disconnected FlatGrid, whatever its layout, starting from the cell at start:
+      /// randomly pick a cell adjacent to the maze, connect it to a random neighbour within the maze and add its
+      /// other neighbours to the cells to expand. Neighbours being enumerated in the same order by every
+      /// layout, the maze does not depend on the layout.
+      ///
+      /// @param maze the grid to be carved.
+      /// @param start the point to start the algorithm, nothing is carved if out of the grid.
+      /// @param seed number used to initiate the random generator.
+      ///
+      /// @return void.
+      template <typename CellInfo, typename Layout>
+      void operator()(FlatGrid<CellInfo, Layout>& maze, const typename FlatGrid<CellInfo, Layout>::Point& start,
+                      const uint32_t seed = 0)
+      {
+        typedef typename FlatGrid<CellInfo, Layout>::Index Index;
+        if (start.x >= maze.Width() || start.y >= maze.Height())
+          return;
+
+        Carve<Index, GridDirection>(maze, maze.Capacity(), maze.IndexOf(start), seed,
+                                    [&](Index cell, GridDirection direction) { maze.Connect(cell, direction); });
+      }
+
+      /// Carve the maze within a disconnected GridN, starting from the cell at start: randomly pick a cell
+      /// adjacent to the maze, connect it to a random neighbour within the maze and add its other neighbours to
+      /// the cells to expand.
+      ///
+      /// @param maze the grid to be carved.
+      /// @param start the coordinates of the cell to start the algorithm, nothing is carved if out of the grid.
+      /// @param seed number used to initiate the random generator.
+      ///
+      /// @return void.
+      template <uint32_t D, typename CellInfo>
+      void operator()(GridN<D, CellInfo>& maze, const typename GridN<D, CellInfo>::Coordinates& start,
+                      const uint32_t seed = 0)
+      {
+        typedef typename GridN<D, CellInfo>::Index Index;
+        typedef typename GridN<D, CellInfo>::Direction Direction;
+        if (!maze.Contains(start))
+          return;
+
+        Carve<Index, Direction>(maze, maze.Size(), maze.IndexOf(start), seed,
+                                [&](Index cell, Direction direction) { maze.Connect(cell, direction); });
+      }
+
+      /// Carve the maze within a CSRGraph whose edges are all inactive, starting from the start vertex:
+      /// randomly pick a vertex adjacent to the maze, activate an edge toward a random vertex of the maze and
+      /// add its other neighbours to the vertices to expand.
+      ///
+      /// @param graph the graph to be carved.
+      /// @param start the vertex to start the algorithm, nothing is carved if out of the graph.
+      /// @param seed number used to initiate the random generator.
+      ///
+      /// @return void.
+      void operator()(CSRGraph& graph, const CSRGraph::Vertex start, const uint32_t seed = 0)
+      {
+        if (start >= graph.VertexCount())
+          return;
+
+        Carve<CSRGraph::Vertex, CSRGraph::EdgeId>(graph, graph.VertexCount(), start, seed,
+                                                  [&](CSRGraph::Vertex, CSRGraph::EdgeId edge)
+                                                  { graph.SetActive(edge, true); });
+      }
+
       /// GetNeighbours - Retrieve available neighbours
       ///
       /// @param maze Grid within the search occurs
@@ -130,6 +197,55 @@ namespace huc
 
         return neighbour;
       }
+
+    private:
+      /// Carve - Carve the maze from the start vertex over any graph exposing ForEachNeighbour: randomly pick a
+      /// vertex adjacent to the maze, connect it to a random neighbour within the maze and add its other
+      /// neighbours to the vertices to expand.
+      ///
+      /// @param graph the graph whose ForEachNeighbour(vertex, functor(neighbour, link)) lists the neighbours.
+      /// @param vertexCount upper bound of the vertices of the graph.
+      /// @param start the vertex to start the algorithm.
+      /// @param seed number used to initiate the random generator.
+      /// @param connect functor(vertex, link) carving the passage from the vertex through the link.
+      ///
+      /// @return void.
+      template <typename Vertex, typename Link, typename Graph, typename Connect>
+      static void Carve(const Graph& graph, const uint64_t vertexCount, const Vertex start, const uint32_t seed,
+                        Connect connect)
+      {
+        enum : uint8_t { kUnseen = 0, kToExpand, kVisited };
+        std::mt19937 mt(seed);                      // Random generator - Mersenne Twister algorithm
+        std::vector<uint8_t> states(static_cast<size_t>(vertexCount), kUnseen);
+        std::vector<Vertex> pathSet(1, start);      // Keep track of possible paths to expand
+        std::vector<Link> links;                    // Links toward the maze of the current vertex
+
+        states[start] = kToExpand;
+        while (!pathSet.empty())
+        {
+          const size_t kIdx = mt() % pathSet.size();
+          const Vertex kVertex = pathSet[kIdx];
+          pathSet[kIdx] = pathSet.back();
+          pathSet.pop_back();
+          states[kVertex] = kVisited;
+
+          links.clear();
+          graph.ForEachNeighbour(kVertex, [&](Vertex neighbour, Link link)
+          {
+            if (states[neighbour] == kVisited && neighbour != kVertex)
+              links.push_back(link);
+            else if (states[neighbour] == kUnseen)
+            {
+              states[neighbour] = kToExpand;
+              pathSet.push_back(neighbour);
+            }
+          });
+
+          // Randomly connect it to a vertex that is already part of the maze
+          if (!links.empty())
+            connect(kVertex, links[mt() % links.size()]);
+        }
+      }
     };
   }
 }
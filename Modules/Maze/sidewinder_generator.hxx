@@ -17,9 +17,10 @@
  * substantial portions of the Software.
  *
  *=========================================================================================================*/
-#ifndef MODULE_MAZE_BTG_HXX
-#define MODULE_MAZE_BTG_HXX
+#ifndef MODULE_MAZE_SIDEWINDERG_HXX
+#define MODULE_MAZE_SIDEWINDERG_HXX
 
+#include <DataStructures/flat_grid.hxx>
 #include <DataStructures/grid.hxx>
 
 // STD
@@ -92,8 +93,40 @@ namespace huc
 
         return maze;
       }
+
+      /// Carve the maze within a disconnected FlatGrid, whatever its layout.
+      /// The run set is the range of columns [runStart, x] of the current row.
+      ///
+      /// @param maze the grid to be carved.
+      /// @param seed number used to initiate the random generator.
+      ///
+      /// @return void.
+      template <typename CellInfo, typename Layout>
+      void operator()(FlatGrid<CellInfo, Layout>& maze, const uint32_t seed = 0)
+      {
+        std::mt19937 mt(seed); // Random generator based on Mersenne Twister algorithm
+
+        for (uint32_t y = 0; y < maze.Height(); ++y)
+        {
+          uint32_t runStart = 0;
+          for (uint32_t x = 0; x < maze.Width(); ++x)
+          {
+            // Randomly carve to east or north, first row can only be a single passage
+            if (x + 1 < maze.Width() && (mt() % 2 == 0 || y == 0))
+            {
+              maze.Connect(maze.IndexOf(x, y), kEast);
+            }
+            // Otherwise randomly choose a cell in the run and carve north
+            else if (y > 0)
+            {
+              maze.Connect(maze.IndexOf(runStart + mt() % (x - runStart + 1), y), kNorth);
+              runStart = x + 1;
+            }
+          }
+        }
+      }
     };
   }
 }
 
-#endif // MODULE_MAZE_BTG_HXX
+#endif // MODULE_MAZE_SIDEWINDERG_HXX
@@ -80,4 +80,13 @@ TEST(TestRaddix, RaddixSorts)
     RaddixSort<IT>(uniqueValueArray.begin(), uniqueValueArray.end());
     EXPECT_EQ(511, uniqueValueArray[0]);
   }
+  // 64 bits values up to the type maximum - digits must not overflow
+  {
+    std::vector<uint64_t> values = {0xFFFFFFFFFFFFFFFFull, 3, 0x8000000000000000ull, 0, 42, 0x1234567890ull};
+    RaddixSort(values.begin(), values.end(), 256);
+
+    for (auto it = values.begin(); it < values.end() - 1; ++it)
+      EXPECT_LE(*it, *(it + 1));
+    EXPECT_EQ(0xFFFFFFFFFFFFFFFFull, values.back());
+  }
 }
@@ -21,6 +21,9 @@
 #define MODULE_SORT_RADDIX_HXX
 
 // STD includes
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
 #include <queue>
 #include <vector>
 
@@ -44,20 +47,21 @@ namespace huc
     template <typename IT>
     void RaddixSort(const IT& begin, const IT& end, unsigned int base = 10)
     {
+      typedef typename std::iterator_traits<IT>::value_type Value;
+
       if (std::distance(begin, end) < 2)
         return;
 
       // Create a bucket for each possible value of a digit
-      std::vector<std::queue<typename std::iterator_traits<IT>::value_type>> buckets(base);
+      std::vector<std::queue<Value>> buckets(base);
 
-      // For all possible digit
-      for (size_t powBase = 1;
-           powBase < std::numeric_limits<typename std::iterator_traits<IT>::value_type>::max();
-           powBase *= base)
+      // For each digit of the greatest value: stop before powBase overflows the value type
+      const Value maxValue = *std::max_element(begin, end);
+      for (Value powBase = 1; ; powBase *= base)
       {
         // Push each number into the bucket of its digit value
         for (auto it = begin; it != end; ++it)
-          buckets[static_cast<int>(*it / powBase) % base].push(*it);
+          buckets[static_cast<size_t>((*it / powBase) % base)].push(*it);
 
         // Dequeu back all the values
         auto itSrc = begin;
@@ -67,6 +71,9 @@ namespace huc
             *(itSrc++) = it->front();
             it->pop();
           }
+
+        if (static_cast<uint64_t>(maxValue / powBase) < base)
+          break;
       }
     }
   }